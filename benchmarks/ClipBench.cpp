@@ -0,0 +1,57 @@
+// Compares the sweep-based polygon clipper with per-edge Sutherland-Hodgman
+// clipping on random star-shaped polygons cut by a convex quad, the case both support.
+
+#include <lia/clip2d.h>
+#include <lia/random.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+int main()
+{
+    const int polygonCount = 20000;
+    const int vertexCount = 32;
+
+    lia::pcg32 rng(7u);
+    std::vector<lia::vec2> stars(static_cast<std::size_t>(polygonCount) * vertexCount);
+    for (int p = 0; p < polygonCount; ++p) {
+        for (int i = 0; i < vertexCount; ++i) {
+            const float angle = static_cast<float>(lia::TAU) * static_cast<float>(i) / vertexCount;
+            const float radius = 0.3f + static_cast<float>(rng.next() >> 8) / 16777216.0f;
+            stars[p * vertexCount + i] = lia::vec2(radius * std::cos(angle), radius * std::sin(angle));
+        }
+    }
+
+    const lia::vec2 quad[4] = { lia::vec2(-0.5f, -0.4f), lia::vec2(0.6f, -0.5f), lia::vec2(0.5f, 0.6f), lia::vec2(-0.4f, 0.5f) };
+
+    lia::polygonClipper clipper;
+    lia::polygonSet subject, clip, result;
+    clip.addPolygon(quad, 4);
+
+    double sweepArea = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < polygonCount; ++p) {
+        subject.clear();
+        subject.addPolygon(&stars[p * vertexCount], vertexCount);
+        clipper.computePieces(subject, clip, lia::booleanOp::intersection, result);
+
+        for (std::size_t i = 0; i < result.size(); ++i)
+            sweepArea += lia::area(result.polygon(i), result.polygonSize(i));
+    }
+    const double sweepSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double naiveArea = 0.0;
+    std::vector<lia::vec2> out(2 * (vertexCount + 4)), scratch(out.size());
+    start = std::chrono::steady_clock::now();
+    for (int p = 0; p < polygonCount; ++p) {
+        const std::size_t count = lia::clipConvex(&stars[p * vertexCount], vertexCount, quad, 4, out.data(), out.size(), scratch.data());
+        naiveArea += lia::area(out.data(), count);
+    }
+    const double naiveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("sweep clipper:      %10.0f polygons/s (area %.3f)\n", polygonCount / sweepSeconds, sweepArea);
+    std::printf("per-edge clipping:  %10.0f polygons/s (area %.3f)\n", polygonCount / naiveSeconds, naiveArea);
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+// Times Delaunay triangulation and Voronoi extraction of uniform random points.
+// Usage: DelaunayBench [point count], one million by default.
+
+#include <lia/delaunay.h>
+#include <lia/random.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? static_cast<std::size_t>(std::atoll(argv[1])) : 1000000;
+
+    lia::pcg32 rng(5u);
+    std::vector<lia::vec2> points(count);
+    for (lia::vec2& p : points)
+        p = lia::vec2(static_cast<float>(rng.next() >> 8) / 16777216.0f, static_cast<float>(rng.next() >> 8) / 16777216.0f);
+
+    lia::delaunayTriangulation dt;
+
+    const auto start = std::chrono::steady_clock::now();
+    dt.build(points.data(), points.size());
+    const auto built = std::chrono::steady_clock::now();
+
+    lia::polygonSet cells;
+    lia::voronoi(dt, points.data(), points.size(), lia::vec2(0.0f, 0.0f), lia::vec2(1.0f, 1.0f), cells);
+    const auto end = std::chrono::steady_clock::now();
+
+    const double buildSeconds = std::chrono::duration<double>(built - start).count();
+    const double voronoiSeconds = std::chrono::duration<double>(end - built).count();
+
+    std::printf("%zu points, %zu triangles\n", count, dt.triangleCount());
+    std::printf("triangulation: %.3f s (%.2f M points/s)\n", buildSeconds, count / buildSeconds * 1e-6);
+    std::printf("voronoi:       %.3f s (%zu cells)\n", voronoiSeconds, cells.size());
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Cost of lia's deterministic kernels against libm over 4M floats, the
+// price of LIA_DETERMINISTIC for code dominated by these calls.
+
+#include <lia/mathbase.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+template <typename F>
+double nanosecondsPerCall(const std::vector<float>& in, std::vector<float>& out, const F& f)
+{
+    double best = 1e30;
+    for (int run = 0; run < 5; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < in.size(); ++i)
+            out[i] = f(in[i]);
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    return best * 1e9 / static_cast<double>(in.size());
+}
+
+template <typename F, typename G>
+void compare(const char* name, const std::vector<float>& in, std::vector<float>& out, const F& libm, const G& lia)
+{
+    const double a = nanosecondsPerCall(in, out, libm);
+    const double b = nanosecondsPerCall(in, out, lia);
+    std::printf("%-6s libm %6.2f ns, deterministic %6.2f ns, %.2fx\n", name, a, b, b / a);
+}
+} // namespace
+
+int main()
+{
+    const std::size_t count = std::size_t(4) << 20;
+    std::vector<float> angles(count), unit(count), positive(count), out(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float t = static_cast<float>(i) / static_cast<float>(count);
+        angles[i] = (t - 0.5f) * 200.0f;
+        unit[i] = t * 2.0f - 1.0f;
+        positive[i] = t * 100.0f + 1e-3f;
+    }
+
+    compare("sin", angles, out, [](float x) { return std::sin(x); }, [](float x) { return lia::detail::deterministicSin(x); });
+    compare("cos", angles, out, [](float x) { return std::cos(x); }, [](float x) { return lia::detail::deterministicCos(x); });
+    compare("tan", angles, out, [](float x) { return std::tan(x); }, [](float x) { return lia::detail::deterministicTan(x); });
+    compare("acos", unit, out, [](float x) { return std::acos(x); }, [](float x) { return lia::detail::deterministicAcos(x); });
+    compare("atan2", unit, out, [](float x) { return std::atan2(x, 0.5f); }, [](float x) { return lia::detail::deterministicAtan2(x, 0.5f); });
+    compare("pow", positive, out, [](float x) { return std::pow(x, 2.4f); }, [](float x) { return lia::detail::deterministicPow(x, 2.4f); });
+    compare("log2", positive, out, [](float x) { return std::log2(x); }, [](float x) { return lia::detail::deterministicLog2(x); });
+    compare("cbrt", positive, out, [](float x) { return std::cbrt(x); }, [](float x) { return lia::detail::deterministicCbrt(x); });
+
+    float check = 0.0f;
+    for (std::size_t i = 0; i < count; i += 4096)
+        check += out[i];
+    std::printf("(%.1f)\n", check);
+
+    return 0;
+}
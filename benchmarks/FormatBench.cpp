@@ -0,0 +1,47 @@
+// Writes an array of vec3 as text with lia's bulk formatter, shortest and at
+// fixed precision, and with an ostream, in MB/s of text produced.
+
+#include <lia/format.h>
+#include <lia/random.h>
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+int main()
+{
+    const std::size_t count = 1000000;
+
+    lia::pcg32 rng(13u);
+    std::vector<lia::vec3> points(count);
+    lia::randomVec3(rng, points.data(), points.size());
+
+    std::vector<char> text(count * (3 * lia::formattedFloatSize() + 3));
+    char* end = text.data() + text.size();
+
+    char* cursor = text.data();
+    auto start = std::chrono::steady_clock::now();
+    lia::format(cursor, end, points.data(), points.size());
+    const double shortestSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double shortestMegabytes = static_cast<double>(cursor - text.data()) / 1e6;
+
+    cursor = text.data();
+    start = std::chrono::steady_clock::now();
+    lia::format(cursor, end, points.data(), points.size(), 6);
+    const double fixedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double fixedMegabytes = static_cast<double>(cursor - text.data()) / 1e6;
+
+    std::ostringstream stream;
+    start = std::chrono::steady_clock::now();
+    for (const lia::vec3& p : points)
+        stream << p << '\n';
+    const double streamSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double streamMegabytes = static_cast<double>(stream.str().size()) / 1e6;
+
+    std::printf("format, shortest:    %8.1f MB/s\n", shortestMegabytes / shortestSeconds);
+    std::printf("format, 6 digits:    %8.1f MB/s\n", fixedMegabytes / fixedSeconds);
+    std::printf("ostream:             %8.1f MB/s\n", streamMegabytes / streamSeconds);
+
+    return 0;
+}
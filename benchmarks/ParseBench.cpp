@@ -0,0 +1,60 @@
+// Loads the vertices of a generated OBJ file with lia's parser, whole and in
+// parts, and with an istream reading the same text, in MB/s of text.
+
+#include <lia/parse.h>
+#include <lia/random.h>
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+int main()
+{
+    const int vertexCount = 1000000;
+
+    lia::pcg32 rng(11u);
+    std::vector<lia::vec3> points(vertexCount);
+    lia::randomVec3(rng, points.data(), points.size());
+
+    std::string obj;
+    char line[96];
+    for (const lia::vec3& p : points) {
+        std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", p.x * 100.0f, p.y * 100.0f, p.z * 100.0f);
+        obj += line;
+    }
+    const double megabytes = static_cast<double>(obj.size()) / 1e6;
+
+    lia::objVertices whole;
+    auto start = std::chrono::steady_clock::now();
+    lia::loadObj(obj.data(), obj.data() + obj.size(), whole);
+    const double wholeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    lia::objVertices joined;
+    std::vector<std::size_t> offsets;
+    start = std::chrono::steady_clock::now();
+    lia::splitLines(obj.data(), obj.size(), 16, offsets);
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+        lia::objVertices part;
+        lia::loadObj(obj.data() + offsets[i], obj.data() + offsets[i + 1], part);
+        joined.append(part);
+    }
+    const double partSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<lia::vec3> streamed;
+    streamed.reserve(vertexCount);
+    start = std::chrono::steady_clock::now();
+    std::istringstream stream(obj);
+    std::string tag;
+    lia::vec3 v;
+    while (stream >> tag >> v.x >> v.y >> v.z)
+        streamed.push_back(v);
+    const double streamSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("loadObj:           %8.1f MB/s (%zu vertices)\n", megabytes / wholeSeconds, whole.positions.size());
+    std::printf("loadObj, 16 parts: %8.1f MB/s (%zu vertices)\n", megabytes / partSeconds, joined.positions.size());
+    std::printf("istream:           %8.1f MB/s (%zu vertices)\n", megabytes / streamSeconds, streamed.size());
+
+    return 0;
+}
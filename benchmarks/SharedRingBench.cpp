@@ -0,0 +1,135 @@
+// Sends frames of 10k mat4 from one process to another and waits for an
+// acknowledgement, through a shared ring and through a Unix domain socket,
+// and reports the round-trip time and the throughput of each. The waits
+// yield, so the numbers mean something on a single core too.
+
+#include <lia/sharedring.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const std::size_t matrixCount = 10000;
+static const uint64_t rounds = 2000;
+
+static float consume(const lia::mat4* matrices, std::size_t count)
+{
+    float sum = 0.0f;
+    for (std::size_t i = 0; i < count; ++i)
+        sum += matrices[i](3, 0);
+
+    return sum;
+}
+
+static bool transfer(int socket, char* data, std::size_t size, bool sending)
+{
+    while (size > 0) {
+        const ssize_t n = sending ? send(socket, data, size, 0) : recv(socket, data, size, 0);
+        if (n <= 0)
+            return false;
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+
+    return true;
+}
+
+static void child(const std::string& framesName, lia::sharedRing<uint32_t>& acks, int socket)
+{
+    lia::sharedRing<lia::mat4> frames;
+    if (!frames.open(framesName.c_str()))
+        return;
+
+    float sum = 0.0f;
+    lia::sharedFrame<lia::mat4> frame;
+    for (uint64_t r = 0; r < rounds; ++r) {
+        while (!frames.latest(frame) || frame.number != r)
+            std::this_thread::yield();
+        sum += consume(frame.data, frame.count);
+        if (!frames.valid(frame))
+            std::printf("torn frame %llu\n", static_cast<unsigned long long>(r));
+
+        acks.beginWrite()[0] = static_cast<uint32_t>(r);
+        acks.endWrite();
+    }
+
+    std::vector<lia::mat4> received(matrixCount);
+    char ack = 0;
+    for (uint64_t r = 0; r < rounds; ++r) {
+        if (!transfer(socket, reinterpret_cast<char*>(received.data()), matrixCount * sizeof(lia::mat4), false))
+            return;
+        sum += consume(received.data(), matrixCount);
+        transfer(socket, &ack, 1, true);
+    }
+
+    if (sum == 0.0f)
+        std::printf("nothing received\n");
+}
+
+int main()
+{
+    const std::string framesName = "/lia-bench-frames-" + std::to_string(getpid());
+    const std::string acksName = "/lia-bench-acks-" + std::to_string(getpid());
+
+    lia::sharedRing<lia::mat4> frames;
+    lia::sharedRing<uint32_t> acks;
+    int sockets[2];
+    if (!frames.create(framesName.c_str(), matrixCount) || !acks.create(acksName.c_str(), 1)
+        || socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+        std::printf("shared memory or sockets are not available\n");
+        return 1;
+    }
+
+    std::vector<lia::mat4> world(matrixCount);
+    for (std::size_t i = 0; i < matrixCount; ++i)
+        world[i](3, 0) = 1.0f + static_cast<float>(i);
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        child(framesName, acks, sockets[1]);
+        _exit(0);
+    }
+
+    lia::sharedFrame<uint32_t> ack;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t r = 0; r < rounds; ++r) {
+        std::memcpy(static_cast<void*>(frames.beginWrite()), world.data(), matrixCount * sizeof(lia::mat4));
+        frames.endWrite();
+        while (!acks.latest(ack) || ack.number != r)
+            std::this_thread::yield();
+    }
+    const double ringSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    char reply = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint64_t r = 0; r < rounds; ++r) {
+        transfer(sockets[0], reinterpret_cast<char*>(world.data()), matrixCount * sizeof(lia::mat4), true);
+        transfer(sockets[0], &reply, 1, false);
+    }
+    const double socketSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    waitpid(pid, nullptr, 0);
+    lia::sharedRing<lia::mat4>::remove(framesName.c_str());
+    lia::sharedRing<uint32_t>::remove(acksName.c_str());
+
+    const double gigabytes = static_cast<double>(rounds * matrixCount * sizeof(lia::mat4)) / 1e9;
+    std::printf("%zu mat4 per frame, %llu round trips\n", matrixCount, static_cast<unsigned long long>(rounds));
+    std::printf("shared ring:  %8.1f us per round trip, %6.2f GB/s\n", ringSeconds * 1e6 / rounds, gigabytes / ringSeconds);
+    std::printf("unix socket:  %8.1f us per round trip, %6.2f GB/s\n", socketSeconds * 1e6 / rounds, gigabytes / socketSeconds);
+
+    return 0;
+}
+#else
+int main()
+{
+    std::printf("shared rings need POSIX shared memory\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,63 @@
+// Replicates 50k entities for 30 frames, a fifth of them moving each frame,
+// and reports the size of delta snapshots and the time to encode and decode.
+
+#include <lia/random.h>
+#include <lia/snapshot.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+int main()
+{
+    const std::size_t entityCount = 50000;
+    const int frameCount = 30;
+
+    lia::pcg32 rng(17u);
+    std::vector<lia::vec3> positions(entityCount);
+    lia::randomVec3(rng, positions.data(), entityCount);
+
+    std::vector<lia::transform> transforms(entityCount);
+    for (std::size_t i = 0; i < entityCount; ++i)
+        transforms[i] = lia::transform(positions[i] * 1000.0f - lia::vec3(500.0f), lia::rotationY(static_cast<float>(i)));
+
+    lia::snapshotSettings settings;
+    settings.bounds = lia::ivec3(lia::vec3(-512.0f), lia::vec3(512.0f));
+    settings.positionBits = 20;
+
+    std::vector<lia::quantizedTransform> baseline(entityCount), current(entityCount), received(entityCount);
+    lia::quantize(settings, transforms.data(), baseline.data(), entityCount);
+    received = baseline;
+
+    std::vector<uint8_t> data;
+    std::size_t bytes = 0;
+    double encodeSeconds = 0.0;
+    double decodeSeconds = 0.0;
+    for (int frame = 0; frame < frameCount; ++frame) {
+        for (std::size_t i = static_cast<std::size_t>(frame) % 5; i < entityCount; i += 5) {
+            transforms[i].position += lia::vec3(0.1f, 0.0f, 0.05f * std::sin(static_cast<float>(i)));
+            transforms[i].rotation = lia::normalize(transforms[i].rotation * lia::rotationY(0.02f));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        lia::quantize(settings, transforms.data(), current.data(), entityCount);
+        lia::encodeSnapshot(settings, current.data(), baseline.data(), entityCount, data);
+        encodeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        lia::decodeSnapshot(settings, data.data(), data.size(), received.data(), received.data(), entityCount);
+        decodeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        bytes += data.size();
+        baseline.swap(current);
+    }
+
+    const double bitsPerEntity = 8.0 * static_cast<double>(bytes) / frameCount / entityCount;
+    std::printf("raw transforms:   %8.1f KB per snapshot\n", entityCount * 28.0 / 1024.0);
+    std::printf("delta snapshots:  %8.1f KB per snapshot, %.2f bits per entity\n", bytes / 1024.0 / frameCount, bitsPerEntity);
+    std::printf("encode:           %8.3f ms per snapshot\n", encodeSeconds * 1000.0 / frameCount);
+    std::printf("decode:           %8.3f ms per snapshot\n", decodeSeconds * 1000.0 / frameCount);
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Memory bandwidth of the streaming batch transforms next to STREAM copy
+// and triad on the same machine, with and without prefetching and
+// non-temporal stores, and the tiled point set transform against one pass
+// over the points per matrix.
+
+#include <lia/streaming.h>
+#include <lia/transform.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+// best of a few runs, as STREAM reports
+template <typename F>
+double bestSeconds(int runs, const F& f)
+{
+    double best = 1e30;
+    for (int run = 0; run < runs; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    return best;
+}
+
+void report(const char* name, double bytes, double seconds)
+{
+    std::printf("%-34s %8.2f GB/s %9.2f ms\n", name, bytes / seconds * 1e-9, seconds * 1e3);
+}
+} // namespace
+
+int main()
+{
+    // well past any last-level cache
+    const std::size_t count = std::size_t(16) << 20;
+    const int runs = 5;
+
+    std::vector<float> a(count * 3, 1.0f), b(count * 3, 2.0f), c(count * 3, 0.0f);
+    const double arrayBytes = static_cast<double>(a.size() * sizeof(float));
+    report("STREAM copy", 2 * arrayBytes, bestSeconds(runs, [&] {
+        for (std::size_t i = 0; i < a.size(); ++i)
+            c[i] = a[i];
+    }));
+    report("STREAM triad", 3 * arrayBytes, bestSeconds(runs, [&] {
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] = b[i] + 3.0f * c[i];
+    }));
+
+    std::vector<lia::vec3> points(count);
+    for (std::size_t i = 0; i < count; ++i)
+        points[i] = lia::vec3(static_cast<float>(i % 1000), static_cast<float>(i % 7), 1.0f);
+    std::vector<lia::vec3> out(count);
+    const lia::mat4 mat = lia::toMatrix(lia::transform(lia::vec3(1.0f, 2.0f, 3.0f), lia::rotationY(0.5f)));
+    const double pointBytes = 2.0 * count * sizeof(lia::vec3);
+
+    const struct {
+        const char* name;
+        lia::streamSettings settings;
+    } variants[] = {
+        { "points, plain", lia::streamSettings(0, SIZE_MAX) },
+        { "points, prefetch", lia::streamSettings(1024, SIZE_MAX) },
+        { "points, non-temporal", lia::streamSettings(0, 0) },
+        { "points, prefetch + non-temporal", lia::streamSettings(1024, 0) },
+    };
+    for (const auto& variant : variants) {
+        report(variant.name, pointBytes, bestSeconds(runs, [&] {
+            lia::transformPoints(mat, points.data(), out.data(), count, variant.settings);
+        }));
+    }
+
+    // 16 instances of a mesh larger than L2
+    const std::size_t meshPoints = std::size_t(1) << 22;
+    const std::size_t instances = 16;
+    std::vector<lia::mat4> matrices(instances);
+    for (std::size_t m = 0; m < instances; ++m)
+        matrices[m] = lia::toMatrix(lia::transform(lia::vec3(static_cast<float>(m)), lia::rotationY(m * 0.1f)));
+    std::vector<lia::vec3> instanced(instances * meshPoints);
+    const double setBytes = static_cast<double>(instances * meshPoints * sizeof(lia::vec3));
+
+    report("point sets, per matrix", setBytes, bestSeconds(runs, [&] {
+        for (std::size_t m = 0; m < instances; ++m)
+            lia::transformPoints(matrices[m], points.data(), instanced.data() + m * meshPoints, meshPoints, lia::streamSettings(1024, 0));
+    }));
+    report("point sets, tiled", setBytes, bestSeconds(runs, [&] {
+        lia::transformPointSets(matrices.data(), instances, points.data(), meshPoints, instanced.data(), lia::streamSettings(1024, 0));
+    }));
+
+    float check = a[count / 2] + c[count / 3] + out[count / 5].x + instanced[instances * meshPoints / 3].y;
+    std::printf("(%.1f)\n", check);
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Recomposes the world matrices of 1M transforms, kept in a transformPool and
+// kept as individually allocated scene objects visited in shuffled order.
+
+#include <lia/random.h>
+#include <lia/transformpool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+struct sceneObject {
+    char name[48];
+    lia::transform local;
+    lia::mat4 world;
+    std::vector<int> children;
+};
+
+int main()
+{
+    const std::size_t count = 1000000;
+    const int passes = 10;
+
+    lia::pcg32 rng(19u);
+    std::vector<lia::vec3> positions(count);
+    lia::randomVec3(rng, positions.data(), count);
+
+    lia::transformPool pool;
+    pool.reserve(count);
+    std::vector<std::unique_ptr<sceneObject>> objects;
+    for (std::size_t i = 0; i < count; ++i) {
+        const lia::transform t(positions[i], lia::rotationY(static_cast<float>(i)));
+        pool.create(t);
+        objects.emplace_back(new sceneObject());
+        objects.back()->local = t;
+    }
+    for (std::size_t i = count - 1; i > 0; --i)
+        std::swap(objects[i], objects[rng.next() % (i + 1)]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass)
+        pool.updateWorlds();
+    const double poolSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const std::unique_ptr<sceneObject>& object : objects)
+            object->world = lia::toMatrix(object->local);
+    }
+    const double objectSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    float check = 0.0f;
+    for (std::size_t i = 0; i < count; i += 1000)
+        check += pool.worlds()[i](3, 0) + objects[i]->world(3, 0);
+
+    std::printf("transformPool:     %8.2f ns per transform\n", poolSeconds * 1e9 / (count * passes));
+    std::printf("scattered objects: %8.2f ns per transform (%.1f)\n", objectSeconds * 1e9 / (count * passes), check);
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "mathbase.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace lia {
+constexpr std::size_t ARENA_ALIGNMENT = 64;
+
+/**
+ * A position in an arena to rewind to.
+ */
+struct arenaMarker {
+    std::size_t block { 0 };
+    std::size_t offset { 0 };
+};
+
+/**
+ * Bump allocation for temporaries that all die together, typically at the
+ * end of a frame. Allocating is a pointer increment; nothing is freed
+ * individually and no destructors run. Memory comes from blocks that are
+ * kept across resets, and a reset after the arena had to grow merges the
+ * blocks into one, so a steady frame allocates nothing.
+ *
+ * Not thread safe; give each thread its own, e.g. threadArena().
+ */
+struct frameArena {
+    explicit frameArena(std::size_t blockSize = std::size_t(1) << 20)
+        : blockSize(blockSize)
+    { }
+
+    frameArena(const frameArena&) = delete;
+    frameArena& operator=(const frameArena&) = delete;
+
+    ~frameArena()
+    {
+        release();
+    }
+
+    /**
+     * @param alignment A power of two, at most ARENA_ALIGNMENT
+     */
+    void* allocate(std::size_t size, std::size_t alignment = ARENA_ALIGNMENT)
+    {
+        if (current < blocks.size()) {
+            const std::size_t start = (offset + alignment - 1) & ~(alignment - 1);
+            if (start + size <= blocks[current].size) {
+                offset = start + size;
+                return blocks[current].data + start;
+            }
+        }
+
+        // blocks start ARENA_ALIGNMENT aligned, so a fresh one needs no padding
+        nextBlock(size);
+        offset = size;
+        return blocks[current].data;
+    }
+
+    /**
+     * count default-constructed elements, e.g. scratch vec4 or mat4 arrays
+     * for batch kernels.
+     */
+    template <typename T>
+    T* allocateArray(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destroyed");
+        static_assert(alignof(T) <= ARENA_ALIGNMENT, "over-aligned type");
+
+        T* array = static_cast<T*>(allocate(count * sizeof(T), alignof(T) < 16 ? 16 : alignof(T)));
+        for (std::size_t i = 0; i < count; ++i)
+            new (array + i) T();
+
+        return array;
+    }
+
+    arenaMarker mark() const
+    {
+        return arenaMarker { current, offset };
+    }
+
+    /**
+     * Frees everything allocated since the marker was taken.
+     */
+    void rewind(const arenaMarker& marker)
+    {
+        current = marker.block;
+        offset = marker.offset;
+    }
+
+    /**
+     * Frees everything, keeping the memory for the next frame.
+     */
+    void reset()
+    {
+        if (blocks.size() > 1) {
+            const std::size_t total = capacity();
+            release();
+            blocks.push_back(newBlock(total));
+        }
+
+        current = 0;
+        offset = 0;
+    }
+
+    /**
+     * Bytes handed out since the last reset, padding included.
+     */
+    std::size_t used() const
+    {
+        std::size_t bytes = offset;
+        for (std::size_t i = 0; i < current && i < blocks.size(); ++i)
+            bytes += blocks[i].size;
+
+        return bytes;
+    }
+
+    std::size_t capacity() const
+    {
+        std::size_t bytes = 0;
+        for (const block& b : blocks)
+            bytes += b.size;
+
+        return bytes;
+    }
+
+private:
+    struct block {
+        uint8_t* allocation;
+        uint8_t* data; // allocation rounded up to ARENA_ALIGNMENT
+        std::size_t size;
+    };
+
+    std::vector<block> blocks;
+    std::size_t current { 0 };
+    std::size_t offset { 0 };
+    std::size_t blockSize;
+
+    static block newBlock(std::size_t size)
+    {
+        uint8_t* allocation = static_cast<uint8_t*>(::operator new(size + ARENA_ALIGNMENT - 1));
+        const uintptr_t aligned = (reinterpret_cast<uintptr_t>(allocation) + ARENA_ALIGNMENT - 1) & ~uintptr_t(ARENA_ALIGNMENT - 1);
+
+        return block { allocation, reinterpret_cast<uint8_t*>(aligned), size };
+    }
+
+    // moves to the first later block with room, or adds one after the current
+    void nextBlock(std::size_t size)
+    {
+        std::size_t next = blocks.empty() ? 0 : current + 1;
+        while (next < blocks.size() && blocks[next].size < size)
+            ++next;
+
+        if (next == blocks.size() || blocks[next].size < size) {
+            next = blocks.empty() ? 0 : current + 1;
+            blocks.insert(blocks.begin() + static_cast<std::ptrdiff_t>(next), newBlock(size > blockSize ? size : blockSize));
+        }
+
+        current = next;
+    }
+
+    void release()
+    {
+        for (const block& b : blocks)
+            ::operator delete(b.allocation);
+        blocks.clear();
+    }
+};
+
+/**
+ * An STL allocator over a frameArena, for containers of temporaries:
+ * std::vector<uint32_t, arenaAllocator<uint32_t>> indices(arena).
+ * Deallocation does nothing; the memory comes back at the arena's reset.
+ */
+template <typename T>
+struct arenaAllocator {
+    using value_type = T;
+
+    frameArena* arena;
+
+    arenaAllocator(frameArena& a)
+        : arena(&a)
+    { }
+
+    template <typename U>
+    arenaAllocator(const arenaAllocator<U>& other)
+        : arena(other.arena)
+    { }
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) { }
+};
+
+template <typename T, typename U>
+inline bool operator==(const arenaAllocator<T>& a, const arenaAllocator<U>& b)
+{
+    return a.arena == b.arena;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const arenaAllocator<T>& a, const arenaAllocator<U>& b)
+{
+    return a.arena != b.arena;
+}
+
+template <typename T>
+using arenaVector = std::vector<T, arenaAllocator<T>>;
+
+/**
+ * The calling thread's arena.
+ */
+inline frameArena& threadArena()
+{
+    static thread_local frameArena arena;
+    return arena;
+}
+} // namespace lia
@@ -0,0 +1,493 @@
+#pragma once
+
+#include "mathbase.h"
+#include "mat4.h"
+#include "quaternion.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "vec4.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lia {
+/**
+ * Element type of a section, part of the on-disk format: never renumber.
+ */
+enum class binaryType : uint32_t {
+    bytes = 0,
+    float32 = 1,
+    uint32 = 2, // e.g. parent indices of a transform hierarchy, 0xFFFFFFFF for roots
+    vec2 = 3,
+    vec3 = 4,
+    vec4 = 5,
+    quaternion = 6,
+    mat4 = 7,
+};
+
+enum class binaryCompression : uint32_t {
+    none = 0,
+    shuffleRle = 1, // elements XORed with their predecessor, bytes of 32-bit lanes split into planes, run-length coded
+};
+
+constexpr uint32_t BINARY_VERSION = 1;
+constexpr uint64_t BINARY_ALIGNMENT = 64;
+
+/**
+ * File header, 64 bytes at offset 0. The section table follows it and every
+ * section starts at a multiple of BINARY_ALIGNMENT, so a mapping at a page
+ * boundary gives aligned arrays of any lia type.
+ */
+struct binaryHeader {
+    char magic[4]; // "LIAB"
+    uint32_t byteOrder; // 0x01020304 in the byte order of the writer
+    uint32_t version;
+    uint32_t sectionCount;
+    uint64_t fileSize;
+    uint64_t sectionTableOffset;
+    uint8_t reserved[32];
+};
+
+struct binarySection {
+    char name[24]; // zero padded, not necessarily terminated
+    binaryType type;
+    binaryCompression compression;
+    uint64_t count;
+    uint64_t offset;
+    uint64_t storedSize;
+    uint32_t elementSize;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(binaryHeader) == 64, "binaryHeader is part of the file format");
+static_assert(sizeof(binarySection) == 64, "binarySection is part of the file format");
+
+inline binaryType binaryTypeOf(const uint8_t*) { return binaryType::bytes; }
+inline binaryType binaryTypeOf(const float*) { return binaryType::float32; }
+inline binaryType binaryTypeOf(const uint32_t*) { return binaryType::uint32; }
+inline binaryType binaryTypeOf(const vec2*) { return binaryType::vec2; }
+inline binaryType binaryTypeOf(const vec3*) { return binaryType::vec3; }
+inline binaryType binaryTypeOf(const vec4*) { return binaryType::vec4; }
+inline binaryType binaryTypeOf(const quaternion*) { return binaryType::quaternion; }
+inline binaryType binaryTypeOf(const mat4*) { return binaryType::mat4; }
+
+namespace detail {
+    constexpr uint32_t BINARY_BYTE_ORDER = 0x01020304u;
+
+    inline uint64_t alignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * Byte k of every 32-bit lane goes to plane k, after XOR with the same byte
+     * of the previous element, so fields that repeat from one element to the
+     * next, such as the constant column of a transform, become zero runs.
+     */
+    inline void shuffleLanes(const uint8_t* in, std::size_t size, std::size_t elementSize, uint8_t* out)
+    {
+        const std::size_t lanes = size / 4;
+        for (std::size_t i = 0; i < lanes; ++i) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                const std::size_t at = 4 * i + k;
+                out[k * lanes + i] = static_cast<uint8_t>(in[at] ^ (at >= elementSize ? in[at - elementSize] : 0u));
+            }
+        }
+        for (std::size_t at = 4 * lanes; at < size; ++at)
+            out[at] = static_cast<uint8_t>(in[at] ^ (at >= elementSize ? in[at - elementSize] : 0u));
+    }
+
+    inline void unshuffleLanes(const uint8_t* in, std::size_t size, std::size_t elementSize, uint8_t* out)
+    {
+        const std::size_t lanes = size / 4;
+        for (std::size_t i = 0; i < lanes; ++i) {
+            for (std::size_t k = 0; k < 4; ++k)
+                out[4 * i + k] = in[k * lanes + i];
+        }
+        std::memcpy(out + 4 * lanes, in + 4 * lanes, size - 4 * lanes);
+
+        for (std::size_t at = elementSize; at < size; ++at)
+            out[at] = static_cast<uint8_t>(out[at] ^ out[at - elementSize]);
+    }
+
+    /**
+     * Control byte c < 128: c + 1 literal bytes follow. Otherwise the next byte
+     * repeats c - 125 times, 3 to 130.
+     */
+    inline void rleEncode(const uint8_t* in, std::size_t size, std::vector<uint8_t>& out)
+    {
+        std::size_t i = 0;
+        std::size_t literalStart = 0;
+        const auto flushLiterals = [&](std::size_t end) {
+            while (literalStart < end) {
+                const std::size_t n = std::min<std::size_t>(128, end - literalStart);
+                out.push_back(static_cast<uint8_t>(n - 1));
+                out.insert(out.end(), in + literalStart, in + literalStart + n);
+                literalStart += n;
+            }
+        };
+
+        while (i < size) {
+            std::size_t run = 1;
+            while (i + run < size && run < 130 && in[i + run] == in[i])
+                ++run;
+
+            if (run >= 3) {
+                flushLiterals(i);
+                out.push_back(static_cast<uint8_t>(run + 125));
+                out.push_back(in[i]);
+                i += run;
+                literalStart = i;
+            } else {
+                i += run;
+            }
+        }
+        flushLiterals(size);
+    }
+
+    // a run is 2 bytes for up to 130, the most any stored byte can expand
+    constexpr uint64_t RLE_MAX_EXPANSION = 65;
+
+    // whether a section's stored bytes can hold its count elements
+    inline bool plausibleSize(const binarySection& s)
+    {
+        if (s.elementSize == 0 || s.count > UINT64_MAX / s.elementSize)
+            return false;
+        if (s.compression == binaryCompression::none)
+            return s.storedSize == s.count * s.elementSize;
+
+        return s.storedSize <= UINT64_MAX / RLE_MAX_EXPANSION && s.count * s.elementSize <= s.storedSize * RLE_MAX_EXPANSION;
+    }
+
+    inline bool rleDecode(const uint8_t* in, std::size_t size, uint8_t* out, std::size_t outSize)
+    {
+        std::size_t written = 0;
+        std::size_t i = 0;
+        while (i < size) {
+            const uint8_t control = in[i++];
+            if (control < 128) {
+                const std::size_t n = static_cast<std::size_t>(control) + 1;
+                if (i + n > size || written + n > outSize)
+                    return false;
+                std::memcpy(out + written, in + i, n);
+                i += n;
+                written += n;
+            } else {
+                const std::size_t n = static_cast<std::size_t>(control) - 125;
+                if (i >= size || written + n > outSize)
+                    return false;
+                std::memset(out + written, in[i++], n);
+                written += n;
+            }
+        }
+
+        return written == outSize;
+    }
+} // namespace detail
+
+/**
+ * Collects arrays and writes them as one binary file. Sections refer to the
+ * caller's arrays, which must stay alive until write.
+ */
+struct binaryWriter {
+    template <typename T>
+    void add(const char* name, const T* data, std::size_t count, binaryCompression compression = binaryCompression::none)
+    {
+        pending section;
+        std::memset(&section.header, 0, sizeof(section.header));
+        std::strncpy(section.header.name, name, sizeof(section.header.name));
+        section.header.type = binaryTypeOf(data);
+        section.header.compression = compression;
+        section.header.count = count;
+        section.header.elementSize = sizeof(T);
+        section.data = reinterpret_cast<const uint8_t*>(data);
+        sections.push_back(section);
+    }
+
+    void clear()
+    {
+        sections.clear();
+    }
+
+    /**
+     * Replaces the content of out with the file.
+     */
+    void write(std::vector<uint8_t>& out) const
+    {
+        std::vector<binarySection> table;
+        std::vector<std::vector<uint8_t>> encoded(sections.size());
+        uint64_t offset = detail::alignUp(sizeof(binaryHeader) + sections.size() * sizeof(binarySection), BINARY_ALIGNMENT);
+
+        std::vector<uint8_t> shuffled;
+        for (std::size_t i = 0; i < sections.size(); ++i) {
+            binarySection header = sections[i].header;
+            const std::size_t size = static_cast<std::size_t>(header.count * header.elementSize);
+            if (header.compression == binaryCompression::shuffleRle) {
+                shuffled.resize(size);
+                detail::shuffleLanes(sections[i].data, size, header.elementSize, shuffled.data());
+                detail::rleEncode(shuffled.data(), size, encoded[i]);
+                header.storedSize = encoded[i].size();
+            } else {
+                header.storedSize = size;
+            }
+
+            header.offset = offset;
+            offset = detail::alignUp(offset + header.storedSize, BINARY_ALIGNMENT);
+            table.push_back(header);
+        }
+
+        out.assign(static_cast<std::size_t>(offset), 0);
+
+        binaryHeader file;
+        std::memset(&file, 0, sizeof(file));
+        std::memcpy(file.magic, "LIAB", 4);
+        file.byteOrder = detail::BINARY_BYTE_ORDER;
+        file.version = BINARY_VERSION;
+        file.sectionCount = static_cast<uint32_t>(sections.size());
+        file.fileSize = offset;
+        file.sectionTableOffset = sizeof(binaryHeader);
+        std::memcpy(out.data(), &file, sizeof(file));
+        if (!table.empty())
+            std::memcpy(out.data() + sizeof(file), table.data(), table.size() * sizeof(binarySection));
+
+        for (std::size_t i = 0; i < sections.size(); ++i) {
+            const uint8_t* source = table[i].compression == binaryCompression::none ? sections[i].data : encoded[i].data();
+            if (table[i].storedSize)
+                std::memcpy(out.data() + table[i].offset, source, static_cast<std::size_t>(table[i].storedSize));
+        }
+    }
+
+    bool write(const char* path) const
+    {
+        std::vector<uint8_t> bytes;
+        write(bytes);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        return static_cast<bool>(file);
+    }
+
+private:
+    struct pending {
+        binarySection header;
+        const uint8_t* data;
+    };
+
+    std::vector<pending> sections;
+};
+
+/**
+ * A read-only view of a binary file in memory, typically a mappedFile.
+ * Uncompressed sections are used in place, without parsing or copies.
+ */
+struct binaryView {
+    /**
+     * @return False when the bytes are not a complete file of a supported
+     * version in the byte order of this machine
+     */
+    bool open(const void* data, std::size_t size)
+    {
+        base = static_cast<const uint8_t*>(data);
+        header = nullptr;
+        table = nullptr;
+        if (size < sizeof(binaryHeader) || !base)
+            return false;
+
+        const binaryHeader* file = reinterpret_cast<const binaryHeader*>(base);
+        if (std::memcmp(file->magic, "LIAB", 4) != 0 || file->byteOrder != detail::BINARY_BYTE_ORDER
+            || file->version == 0 || file->version > BINARY_VERSION || file->fileSize > size)
+            return false;
+
+        // checked in two steps so that a huge offset cannot wrap the table end back into the file
+        if (file->sectionTableOffset % alignof(binarySection) != 0 || file->sectionTableOffset > file->fileSize
+            || file->sectionCount > (file->fileSize - file->sectionTableOffset) / sizeof(binarySection))
+            return false;
+
+        const binarySection* sections = reinterpret_cast<const binarySection*>(base + file->sectionTableOffset);
+        for (uint32_t i = 0; i < file->sectionCount; ++i) {
+            const binarySection& s = sections[i];
+            if (s.offset % BINARY_ALIGNMENT != 0 || s.offset > file->fileSize || s.storedSize > file->fileSize - s.offset
+                || !detail::plausibleSize(s))
+                return false;
+        }
+
+        header = file;
+        table = sections;
+        return true;
+    }
+
+    std::size_t sectionCount() const
+    {
+        return header ? header->sectionCount : 0;
+    }
+
+    const binarySection& section(std::size_t index) const
+    {
+        return table[index];
+    }
+
+    const binarySection* find(const char* name) const
+    {
+        for (std::size_t i = 0; i < sectionCount(); ++i) {
+            if (std::strncmp(table[i].name, name, sizeof(table[i].name)) == 0)
+                return &table[i];
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * The section's array in place.
+     *
+     * @return Null when the section is missing, compressed or of another type
+     */
+    template <typename T>
+    const T* get(const char* name, std::size_t& count) const
+    {
+        const binarySection* s = find(name);
+        if (!s || s->compression != binaryCompression::none || s->type != binaryTypeOf(static_cast<const T*>(nullptr)) || s->elementSize != sizeof(T))
+            return nullptr;
+
+        count = static_cast<std::size_t>(s->count);
+        return reinterpret_cast<const T*>(base + s->offset);
+    }
+
+    /**
+     * Copies a section into out, decompressing it if needed.
+     */
+    template <typename T>
+    bool read(const char* name, std::vector<T>& out) const
+    {
+        const binarySection* s = find(name);
+        if (!s || s->type != binaryTypeOf(static_cast<const T*>(nullptr)) || s->elementSize != sizeof(T) || !detail::plausibleSize(*s)
+            || s->count > SIZE_MAX / sizeof(T))
+            return false;
+
+        out.resize(static_cast<std::size_t>(s->count));
+        uint8_t* target = reinterpret_cast<uint8_t*>(out.data());
+        const std::size_t size = out.size() * sizeof(T);
+        const uint8_t* stored = base + s->offset;
+        if (s->compression == binaryCompression::none) {
+            if (size)
+                std::memcpy(target, stored, size);
+            return true;
+        }
+        if (s->compression != binaryCompression::shuffleRle)
+            return false;
+
+        scratch.resize(size);
+        if (!detail::rleDecode(stored, static_cast<std::size_t>(s->storedSize), scratch.data(), size))
+            return false;
+        detail::unshuffleLanes(scratch.data(), size, sizeof(T), target);
+
+        return true;
+    }
+
+private:
+    const uint8_t* base { nullptr };
+    const binaryHeader* header { nullptr };
+    const binarySection* table { nullptr };
+    mutable std::vector<uint8_t> scratch;
+};
+
+/**
+ * A read-only file in memory: mmap where the platform has it, otherwise read
+ * into an allocation. Either way the start is at least 16-byte aligned.
+ */
+struct mappedFile {
+    mappedFile() = default;
+    mappedFile(const mappedFile&) = delete;
+    mappedFile& operator=(const mappedFile&) = delete;
+
+    ~mappedFile()
+    {
+        close();
+    }
+
+    bool open(const char* path)
+    {
+        close();
+#if defined(__unix__) || defined(__APPLE__)
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat status;
+        if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* mapping = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+            return false;
+
+        bytes = static_cast<const uint8_t*>(mapping);
+        length = static_cast<std::size_t>(status.st_size);
+        mapped = true;
+        return true;
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+
+        const std::streamsize size = file.tellg();
+        if (size <= 0)
+            return false;
+
+        storage.resize(static_cast<std::size_t>(size + 15) / 16);
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(storage.data()), size))
+            return false;
+
+        bytes = reinterpret_cast<const uint8_t*>(storage.data());
+        length = static_cast<std::size_t>(size);
+        return true;
+#endif
+    }
+
+    void close()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapped)
+            munmap(const_cast<uint8_t*>(bytes), length);
+#endif
+        storage.clear();
+        bytes = nullptr;
+        length = 0;
+        mapped = false;
+    }
+
+    const void* data() const
+    {
+        return bytes;
+    }
+
+    std::size_t size() const
+    {
+        return length;
+    }
+
+private:
+    struct alignas(16) block {
+        uint8_t bytes[16];
+    };
+
+    const uint8_t* bytes { nullptr };
+    std::size_t length { 0 };
+    bool mapped { false };
+    std::vector<block> storage;
+};
+} // namespace lia
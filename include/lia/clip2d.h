@@ -0,0 +1,468 @@
+#pragma once
+
+#include "mathbase.h"
+#include "vec2.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace lia {
+/**
+ * A set of polygons stored back to back; polygon i spans points[offsets[i]] to points[offsets[i + 1] - 1].
+ */
+struct polygonSet {
+    std::vector<vec2> points;
+    std::vector<uint32_t> offsets { 0 };
+
+    std::size_t size() const
+    {
+        return offsets.size() - 1;
+    }
+
+    void clear()
+    {
+        points.clear();
+        offsets.assign(1, 0);
+    }
+
+    void addPolygon(const vec2* polygon, std::size_t count)
+    {
+        points.insert(points.end(), polygon, polygon + count);
+        offsets.push_back(static_cast<uint32_t>(points.size()));
+    }
+
+    const vec2* polygon(std::size_t index) const
+    {
+        return points.data() + offsets[index];
+    }
+
+    std::size_t polygonSize(std::size_t index) const
+    {
+        return offsets[index + 1] - offsets[index];
+    }
+};
+
+enum class booleanOp {
+    intersection,
+    unite,
+    difference,
+    exclusiveOr
+};
+
+enum class fillRule {
+    nonZero,
+    evenOdd
+};
+
+/**
+ * Polygon boolean operations by a slab sweep over snapped coordinates.
+ *
+ * Inputs are snapped to a fixed-point grid of step `snap`, so coincident and
+ * nearly coincident vertices are classified consistently. The sweep splits the
+ * plane at every vertex and edge crossing into slabs where no edges cross.
+ *
+ * The result is not a set of outlines: it is a soup of non-overlapping convex
+ * counter-clockwise pieces (trapezoids merged vertically, with every vertex on
+ * the grid), whose union is the answer. That is the form navmesh cutting and
+ * clipped decal rendering consume directly; pieces share edges but are never
+ * stitched back into boundary loops.
+ *
+ * Keep one clipper per thread: its buffers are reused between calls, so after
+ * warming up no allocation happens unless the inputs grow.
+ */
+struct polygonClipper {
+    float snap { 1.0f / 1024.0f };
+    fillRule rule { fillRule::nonZero };
+
+    void computePieces(const polygonSet& subject, const polygonSet& clip, booleanOp op, polygonSet& result)
+    {
+        result.clear();
+        edges.clear();
+        ys.clear();
+
+        addEdges(subject, 0);
+        addEdges(clip, 1);
+        if (edges.empty())
+            return;
+
+        std::sort(edges.begin(), edges.end(), [](const edge& a, const edge& b) { return a.y0 < b.y0; });
+        for (const edge& e : edges) {
+            ys.push_back(e.y0);
+            ys.push_back(e.y1);
+        }
+        std::sort(ys.begin(), ys.end());
+        ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+        active.clear();
+        open.clear();
+        openByLeft.assign(edges.size(), -1);
+
+        std::size_t nextEdge = 0;
+        for (std::size_t k = 0; k + 1 < ys.size(); ++k) {
+            const double yb = static_cast<double>(ys[k]);
+            const double yt = static_cast<double>(ys[k + 1]);
+
+            active.erase(std::remove_if(active.begin(), active.end(), [&](uint32_t i) { return edges[i].y1 <= ys[k]; }), active.end());
+            while (nextEdge < edges.size() && edges[nextEdge].y0 == ys[k])
+                active.push_back(static_cast<uint32_t>(nextEdge++));
+
+            findCrossings(yb, yt);
+
+            for (std::size_t c = 0; c + 1 < cuts.size(); ++c)
+                sweepSubslab(cuts[c], cuts[c + 1], op, result);
+        }
+
+        closeUnmatched(result, std::numeric_limits<double>::infinity());
+    }
+
+private:
+    struct edge {
+        int64_t x0, y0, x1, y1; // y0 < y1
+        int winding;
+        int set;
+
+        double xAt(double y) const
+        {
+            return static_cast<double>(x0) + static_cast<double>(x1 - x0) * (y - static_cast<double>(y0)) / static_cast<double>(y1 - y0);
+        }
+    };
+
+    struct trapezoid {
+        uint32_t left, right;
+        double bottom, top;
+        bool extended;
+    };
+
+    std::vector<edge> edges;
+    std::vector<int64_t> ys;
+    std::vector<uint32_t> active;
+    std::vector<double> cuts;
+    std::vector<double> keys;
+    std::vector<uint32_t> order;
+    std::vector<trapezoid> open;
+    std::vector<trapezoid> next;
+    std::vector<int> openByLeft;
+
+    int64_t toFixed(float value) const
+    {
+        return static_cast<int64_t>(std::llround(static_cast<double>(value) / static_cast<double>(snap)));
+    }
+
+    void addEdges(const polygonSet& set, int setIndex)
+    {
+        for (std::size_t p = 0; p < set.size(); ++p) {
+            const vec2* points = set.polygon(p);
+            const std::size_t count = set.polygonSize(p);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const vec2& a = points[i];
+                const vec2& b = points[(i + 1) % count];
+                const int64_t ax = toFixed(a.x), ay = toFixed(a.y);
+                const int64_t bx = toFixed(b.x), by = toFixed(b.y);
+
+                // horizontal edges never change the winding inside a slab
+                if (ay == by)
+                    continue;
+
+                if (ay < by)
+                    edges.push_back({ ax, ay, bx, by, 1, setIndex });
+                else
+                    edges.push_back({ bx, by, ax, ay, -1, setIndex });
+            }
+        }
+    }
+
+    // orders the active edges at the bottom and records every y where two of them cross
+    void findCrossings(double yb, double yt)
+    {
+        cuts.clear();
+        cuts.push_back(yb);
+
+        std::sort(active.begin(), active.end(), [&](uint32_t a, uint32_t b) {
+            const double xa = edges[a].xAt(yb), xb = edges[b].xAt(yb);
+            return xa != xb ? xa < xb : edges[a].xAt(yt) < edges[b].xAt(yt);
+        });
+
+        // insertion sort by the top x swaps exactly the pairs that cross inside the slab
+        order.assign(active.begin(), active.end());
+        for (std::size_t i = 1; i < order.size(); ++i) {
+            for (std::size_t j = i; j > 0; --j) {
+                const edge& a = edges[order[j - 1]];
+                const edge& b = edges[order[j]];
+                const double dTop = a.xAt(yt) - b.xAt(yt);
+                if (dTop <= 0.0)
+                    break;
+
+                const double dBottom = a.xAt(yb) - b.xAt(yb);
+                const double s = -dBottom / (dTop - dBottom);
+                // crossings land on the grid too; edges may then overlap by less than a step, which emit clamps
+                const double y = std::round(yb + s * (yt - yb));
+                if (y > yb && y < yt)
+                    cuts.push_back(y);
+
+                std::swap(order[j - 1], order[j]);
+            }
+        }
+
+        cuts.push_back(yt);
+        std::sort(cuts.begin(), cuts.end());
+        cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+    }
+
+    bool inside(int winding) const
+    {
+        return rule == fillRule::nonZero ? winding != 0 : (winding & 1) != 0;
+    }
+
+    static bool evaluate(booleanOp op, bool a, bool b)
+    {
+        switch (op) {
+        case booleanOp::intersection: return a && b;
+        case booleanOp::unite: return a || b;
+        case booleanOp::difference: return a && !b;
+        default: return a != b;
+        }
+    }
+
+    void sweepSubslab(double y0, double y1, booleanOp op, polygonSet& result)
+    {
+        const double mid = 0.5 * (y0 + y1);
+
+        keys.resize(edges.size());
+        for (uint32_t i : active)
+            keys[i] = edges[i].xAt(mid);
+
+        order.assign(active.begin(), active.end());
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+        next.clear();
+        int winding[2] = { 0, 0 };
+        bool wasInside = false;
+        uint32_t left = 0;
+
+        for (uint32_t i : order) {
+            winding[edges[i].set] += edges[i].winding;
+            const bool isInside = evaluate(op, inside(winding[0]), inside(winding[1]));
+
+            if (isInside && !wasInside) {
+                left = i;
+            } else if (!isInside && wasInside) {
+                // continue the piece below if it is bounded by the same two edges
+                const int below = openByLeft[left];
+                if (below >= 0 && open[below].right == i && open[below].top == y0) {
+                    open[below].top = y1;
+                    open[below].extended = true;
+                } else {
+                    next.push_back({ left, i, y0, y1, false });
+                }
+            }
+
+            wasInside = isInside;
+        }
+
+        closeUnmatched(result, y1);
+
+        for (const trapezoid& t : next) {
+            openByLeft[t.left] = static_cast<int>(open.size());
+            open.push_back(t);
+        }
+    }
+
+    // emits every open piece that did not grow in the last subslab
+    void closeUnmatched(polygonSet& result, double currentTop)
+    {
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < open.size(); ++i) {
+            trapezoid t = open[i];
+            openByLeft[t.left] = -1;
+
+            if (t.extended && t.top == currentTop) {
+                t.extended = false;
+                open[kept] = t;
+                openByLeft[t.left] = static_cast<int>(kept);
+                ++kept;
+            } else {
+                emit(t, result);
+            }
+        }
+        open.resize(kept);
+
+        // pieces started in this subslab count as extended for the next one
+        for (trapezoid& t : next)
+            t.extended = false;
+    }
+
+    // rounding is monotone, so edges that agree at y stay in order and pieces sharing an edge share its corners
+    void snapSpan(const trapezoid& t, double y, double& left, double& right) const
+    {
+        left = std::round(edges[t.left].xAt(y));
+        right = std::round(edges[t.right].xAt(y));
+        if (left > right)
+            left = right = std::round(0.5 * (left + right));
+    }
+
+    void emit(const trapezoid& t, polygonSet& result)
+    {
+        double bottomLeft = 0.0, bottomRight = 0.0, topLeft = 0.0, topRight = 0.0;
+        snapSpan(t, t.bottom, bottomLeft, bottomRight);
+        snapSpan(t, t.top, topLeft, topRight);
+        const double corners[4][2] = {
+            { bottomLeft, t.bottom },
+            { bottomRight, t.bottom },
+            { topRight, t.top },
+            { topLeft, t.top }
+        };
+
+        const std::size_t start = result.points.size();
+        for (int c = 0; c < 4; ++c) {
+            const vec2 p(static_cast<float>(corners[c][0] * snap), static_cast<float>(corners[c][1] * snap));
+            if (result.points.size() > start && result.points.back().x == p.x && result.points.back().y == p.y)
+                continue;
+            result.points.push_back(p);
+        }
+
+        if (result.points.size() - start > 2 && result.points.back().x == result.points[start].x && result.points.back().y == result.points[start].y)
+            result.points.pop_back();
+
+        if (result.points.size() - start < 3)
+            result.points.resize(start);
+        else
+            result.offsets.push_back(static_cast<uint32_t>(result.points.size()));
+    }
+};
+
+namespace detail {
+    // Sutherland-Hodgman with one stage per clip edge: each vertex is pushed
+    // through every stage in turn, so no intermediate polygon is stored
+    struct convexClipStages {
+        const vec2* convex;
+        std::size_t convexCount;
+        vec2* first;
+        vec2* previous;
+        vec2* out;
+        std::size_t capacity;
+        std::size_t written;
+        std::size_t reached; // stages that have received a vertex, always a prefix
+
+        float side(std::size_t stage, const vec2& p) const
+        {
+            const vec2& a = convex[stage];
+            const vec2 ab = (stage + 1 < convexCount ? convex[stage + 1] : convex[0]) - a;
+            return ab.x * (p.y - a.y) - ab.y * (p.x - a.x);
+        }
+
+        void clipEdge(std::size_t stage, const vec2& p, const vec2& q)
+        {
+            const float dp = side(stage, p);
+            const float dq = side(stage, q);
+
+            if (dp >= 0.0f)
+                push(stage + 1, p);
+            if ((dp >= 0.0f) != (dq >= 0.0f))
+                push(stage + 1, p + (q - p) * (dp / (dp - dq)));
+        }
+
+        void push(std::size_t stage, const vec2& p)
+        {
+            if (stage == convexCount) {
+                if (written < capacity)
+                    out[written] = p;
+                ++written;
+                return;
+            }
+
+            if (stage < reached) {
+                clipEdge(stage, previous[stage], p);
+            } else {
+                reached = stage + 1;
+                first[stage] = p;
+            }
+            previous[stage] = p;
+        }
+
+        // closing a stage can feed the next one, so close them in order
+        void close()
+        {
+            for (std::size_t stage = 0; stage < convexCount; ++stage) {
+                if (stage < reached)
+                    clipEdge(stage, previous[stage], first[stage]);
+            }
+        }
+    };
+} // namespace detail
+
+/**
+ * Clips a polygon against a convex counter-clockwise polygon (Sutherland-Hodgman).
+ *
+ * This is the classic per-edge approach: much cheaper when the clip region is
+ * convex, e.g. a decal or UI scissor, but it cannot handle concave clip regions.
+ * A concave subject can come out with more points than it went in with, so
+ * like the path2d functions this returns the size the full result needs and
+ * writes only the first capacity points; a call with capacity 0 measures.
+ *
+ * Passes run back to back between out and scratch while every pass is sure to
+ * fit, i.e. twice its input is within capacity; otherwise the points are pushed
+ * through all passes one at a time, which needs no intermediate polygon.
+ *
+ * @param scratch Workspace of max(capacity, 2 * convexCount) entries
+ * @return The number of points in the clipped polygon
+ */
+inline std::size_t clipConvex(const vec2* subject, std::size_t count, const vec2* convex, std::size_t convexCount,
+                              vec2* out, std::size_t capacity, vec2* scratch)
+{
+    if (count <= capacity) {
+        // ping-pong between the buffers so the last pass lands in out
+        vec2* buffers[2] = { convexCount % 2 ? out : scratch, convexCount % 2 ? scratch : out };
+        std::copy(subject, subject + count, buffers[1]);
+        std::size_t size = count;
+
+        std::size_t e = 0;
+        for (; e < convexCount && size > 0 && 2 * size <= capacity; ++e) {
+            const vec2& a = convex[e];
+            const vec2& b = convex[(e + 1) % convexCount];
+            const vec2 ab = b - a;
+            const vec2* input = buffers[(e + 1) % 2];
+            vec2* output = buffers[e % 2];
+
+            std::size_t written = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                const vec2& p = input[i];
+                const vec2& q = input[(i + 1) % size];
+                const float dp = ab.x * (p.y - a.y) - ab.y * (p.x - a.x);
+                const float dq = ab.x * (q.y - a.y) - ab.y * (q.x - a.x);
+
+                if (dp >= 0.0f)
+                    output[written++] = p;
+                if ((dp >= 0.0f) != (dq >= 0.0f))
+                    output[written++] = p + (q - p) * (dp / (dp - dq));
+            }
+            size = written;
+        }
+
+        if (e == convexCount || size == 0)
+            return size;
+    }
+
+    detail::convexClipStages stages { convex, convexCount, scratch, scratch + convexCount, out, capacity, 0, 0 };
+    for (std::size_t i = 0; i < count; ++i)
+        stages.push(0, subject[i]);
+    stages.close();
+
+    return stages.written;
+}
+
+/**
+ * Signed area, positive for counter-clockwise polygons.
+ */
+inline float area(const vec2* polygon, std::size_t count)
+{
+    float sum = 0.0f;
+    for (std::size_t i = 0, j = count - 1; i < count; j = i++)
+        sum += polygon[j].x * polygon[i].y - polygon[i].x * polygon[j].y;
+
+    return sum * 0.5f;
+}
+} // namespace lia
@@ -0,0 +1,372 @@
+#pragma once
+
+#include "mathbase.h"
+#include "vec3.h"
+#include "vec4.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lia {
+/**
+ * Colors are plain vec3 (rgb) or vec4 (rgba) values, alpha is always passed through unchanged.
+ */
+enum class srgbMethod {
+    exact, // the piecewise sRGB curve using pow
+    fast, // linear toe and a polynomial/sqrt fit, relative error below 0.15% on [0, 1]
+    lut // 12-bit lookup table, input clamped to [0, 1]
+};
+
+inline float srgbToLinear(float c)
+{
+    return c <= 0.04045f ? c * (1.0f / 12.92f) : fpow((c + 0.055f) * (1.0f / 1.055f), 2.4f);
+}
+
+inline float linearToSrgb(float c)
+{
+    return c <= 0.0031308f ? c * 12.92f : 1.055f * fpow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+/**
+ * The exact linear toe, then a quartic fitted for relative error, at most
+ * 0.15% over [0, 1].
+ */
+inline float srgbToLinearFast(float c)
+{
+    const float curve = (((-0.144819647f * c + 0.57112658f) * c + 0.540136337f) * c + 0.0311575457f) * c + 0.000953813957f;
+    return c <= 0.04045f ? c * (1.0f / 12.92f) : curve;
+}
+
+/**
+ * The exact linear toe, then a sum of c^(1/2), c^(1/4) and c^(1/8) fitted
+ * for relative error, at most 0.04% over [0, 1].
+ */
+inline float linearToSrgbFast(float c)
+{
+    c = std::max(c, 0.0f);
+    const float s1 = std::sqrt(c);
+    const float s2 = std::sqrt(s1);
+    const float s3 = std::sqrt(s2);
+    const float curve = 0.633138239f * s1 + 0.720770419f * s2 - 0.340104908f * s3 - 0.0134069631f * c;
+    return c <= 0.0031308f ? c * 12.92f : curve;
+}
+
+namespace detail {
+    constexpr int COLOR_LUT_SIZE = 4096;
+
+    struct srgbTables {
+        float toLinear[COLOR_LUT_SIZE];
+        float toSrgb[COLOR_LUT_SIZE];
+        float byteToLinear[256];
+
+        srgbTables()
+        {
+            for (int i = 0; i < COLOR_LUT_SIZE; ++i) {
+                const float c = static_cast<float>(i) / static_cast<float>(COLOR_LUT_SIZE - 1);
+                toLinear[i] = srgbToLinear(c);
+                toSrgb[i] = linearToSrgb(c);
+            }
+
+            for (int i = 0; i < 256; ++i)
+                byteToLinear[i] = srgbToLinear(static_cast<float>(i) / 255.0f);
+        }
+
+        static const srgbTables& get()
+        {
+            static const srgbTables instance;
+            return instance;
+        }
+    };
+
+    inline int lutIndex(float c)
+    {
+        return static_cast<int>(clamp(c, 0.0f, 1.0f) * static_cast<float>(COLOR_LUT_SIZE - 1) + 0.5f);
+    }
+
+    template <typename Color, typename Convert>
+    inline void convertChannels(const Color* in, Color* out, std::size_t count, Convert convert)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = in[i];
+            for (int c = 0; c < 3; ++c)
+                out[i][c] = convert(in[i][c]);
+        }
+    }
+
+    template <typename Color>
+    inline void convertSrgb(const Color* in, Color* out, std::size_t count, bool toLinear, srgbMethod method)
+    {
+        // one loop per method and direction keeps each body free of the dispatch
+        switch (method) {
+        case srgbMethod::fast:
+            if (toLinear)
+                convertChannels(in, out, count, [](float c) { return srgbToLinearFast(c); });
+            else
+                convertChannels(in, out, count, [](float c) { return linearToSrgbFast(c); });
+            break;
+        case srgbMethod::lut: {
+            const srgbTables& tables = srgbTables::get();
+            const float* table = toLinear ? tables.toLinear : tables.toSrgb;
+            convertChannels(in, out, count, [table](float c) { return table[lutIndex(c)]; });
+            break;
+        }
+        default:
+            if (toLinear)
+                convertChannels(in, out, count, [](float c) { return srgbToLinear(c); });
+            else
+                convertChannels(in, out, count, [](float c) { return linearToSrgb(c); });
+            break;
+        }
+    }
+} // namespace detail
+
+inline vec3 srgbToLinear(const vec3& c)
+{
+    return vec3(srgbToLinear(c.x), srgbToLinear(c.y), srgbToLinear(c.z));
+}
+
+inline vec3 linearToSrgb(const vec3& c)
+{
+    return vec3(linearToSrgb(c.x), linearToSrgb(c.y), linearToSrgb(c.z));
+}
+
+inline void srgbToLinear(const vec3* in, vec3* out, std::size_t count, srgbMethod method = srgbMethod::exact)
+{
+    detail::convertSrgb(in, out, count, true, method);
+}
+
+inline void srgbToLinear(const vec4* in, vec4* out, std::size_t count, srgbMethod method = srgbMethod::exact)
+{
+    detail::convertSrgb(in, out, count, true, method);
+}
+
+inline void linearToSrgb(const vec3* in, vec3* out, std::size_t count, srgbMethod method = srgbMethod::exact)
+{
+    detail::convertSrgb(in, out, count, false, method);
+}
+
+inline void linearToSrgb(const vec4* in, vec4* out, std::size_t count, srgbMethod method = srgbMethod::exact)
+{
+    detail::convertSrgb(in, out, count, false, method);
+}
+
+/**
+ * Decodes packed 8-bit sRGB triplets to linear colors through a 256-entry table.
+ */
+inline void srgb8ToLinear(const uint8_t* rgb, vec3* out, std::size_t count)
+{
+    const float* table = detail::srgbTables::get().byteToLinear;
+
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = vec3(table[rgb[3 * i]], table[rgb[3 * i + 1]], table[rgb[3 * i + 2]]);
+}
+
+/**
+ * Rec. 709 relative luminance of a linear color.
+ */
+inline float luminance(const vec3& c)
+{
+    return 0.2126f * c.x + 0.7152f * c.y + 0.0722f * c.z;
+}
+
+/**
+ * @return (hue, saturation, value) with all components in [0, 1]
+ */
+inline vec3 rgbToHsv(const vec3& c)
+{
+    const float maxC = std::max(c.x, std::max(c.y, c.z));
+    const float minC = std::min(c.x, std::min(c.y, c.z));
+    const float delta = maxC - minC;
+
+    float hue = 0.0f;
+    if (delta > 0.0f) {
+        if (maxC == c.x)
+            hue = (c.y - c.z) / delta;
+        else if (maxC == c.y)
+            hue = 2.0f + (c.z - c.x) / delta;
+        else
+            hue = 4.0f + (c.x - c.y) / delta;
+
+        hue /= 6.0f;
+        if (hue < 0.0f)
+            hue += 1.0f;
+    }
+
+    return vec3(hue, maxC > 0.0f ? delta / maxC : 0.0f, maxC);
+}
+
+inline vec3 hsvToRgb(const vec3& hsv)
+{
+    // branch-free form: each channel is a clamped triangle wave of the hue
+    const float h = hsv.x * 6.0f;
+    const float r = clamp(std::abs(h - 3.0f) - 1.0f, 0.0f, 1.0f);
+    const float g = clamp(2.0f - std::abs(h - 2.0f), 0.0f, 1.0f);
+    const float b = clamp(2.0f - std::abs(h - 4.0f), 0.0f, 1.0f);
+
+    return vec3(1.0f + (r - 1.0f) * hsv.y, 1.0f + (g - 1.0f) * hsv.y, 1.0f + (b - 1.0f) * hsv.y) * hsv.z;
+}
+
+/**
+ * @return (hue, saturation, lightness) with all components in [0, 1]
+ */
+inline vec3 rgbToHsl(const vec3& c)
+{
+    const vec3 hsv = rgbToHsv(c);
+    const float lightness = hsv.z * (1.0f - hsv.y * 0.5f);
+    const float denominator = std::min(lightness, 1.0f - lightness);
+
+    return vec3(hsv.x, denominator > 0.0f ? (hsv.z - lightness) / denominator : 0.0f, lightness);
+}
+
+inline vec3 hslToRgb(const vec3& hsl)
+{
+    const float value = hsl.z + hsl.y * std::min(hsl.z, 1.0f - hsl.z);
+    const float saturation = value > 0.0f ? 2.0f * (1.0f - hsl.z / value) : 0.0f;
+
+    return hsvToRgb(vec3(hsl.x, saturation, value));
+}
+
+/**
+ * Converts linear sRGB to Oklab (Ottosson 2020).
+ */
+inline vec3 linearToOklab(const vec3& c)
+{
+    const float l = fcbrt(0.4122214708f * c.x + 0.5363325363f * c.y + 0.0514459929f * c.z);
+    const float m = fcbrt(0.2119034982f * c.x + 0.6806995451f * c.y + 0.1073969566f * c.z);
+    const float s = fcbrt(0.0883024619f * c.x + 0.2817188376f * c.y + 0.6299787005f * c.z);
+
+    return vec3(0.2104542553f * l + 0.7936177850f * m - 0.0040720468f * s,
+                1.9779984951f * l - 2.4285922050f * m + 0.4505937099f * s,
+                0.0259040371f * l + 0.7827717662f * m - 0.8086757660f * s);
+}
+
+inline vec3 oklabToLinear(const vec3& lab)
+{
+    const float l = lab.x + 0.3963377774f * lab.y + 0.2158037573f * lab.z;
+    const float m = lab.x - 0.1055613458f * lab.y - 0.0638541728f * lab.z;
+    const float s = lab.x - 0.0894841775f * lab.y - 1.2914855480f * lab.z;
+
+    const float l3 = l * l * l;
+    const float m3 = m * m * m;
+    const float s3 = s * s * s;
+
+    return vec3(4.0767416621f * l3 - 3.3077115913f * m3 + 0.2309699292f * s3,
+                -1.2684380046f * l3 + 2.6097574011f * m3 - 0.3413193965f * s3,
+                -0.0041960863f * l3 - 0.7034186147f * m3 + 1.7076147010f * s3);
+}
+
+/**
+ * @return (Y, Co, Cg)
+ */
+inline vec3 rgbToYCoCg(const vec3& c)
+{
+    return vec3(0.25f * c.x + 0.5f * c.y + 0.25f * c.z,
+                0.5f * c.x - 0.5f * c.z,
+                -0.25f * c.x + 0.5f * c.y - 0.25f * c.z);
+}
+
+inline vec3 yCoCgToRgb(const vec3& c)
+{
+    const float t = c.x - c.z;
+    return vec3(t + c.y, c.x + c.z, t - c.y);
+}
+
+inline vec3 reinhard(const vec3& c)
+{
+    return vec3(c.x / (1.0f + c.x), c.y / (1.0f + c.y), c.z / (1.0f + c.z));
+}
+
+/**
+ * Reinhard on luminance with a white point, so colors at white map to 1.
+ */
+inline vec3 reinhardExtended(const vec3& c, float white)
+{
+    const float l = luminance(c);
+    if (l <= 0.0f)
+        return vec3(0.0f);
+
+    const float mapped = l * (1.0f + l / (white * white)) / (1.0f + l);
+    return c * (mapped / l);
+}
+
+/**
+ * Narkowicz's fit of the ACES filmic curve, output in [0, 1].
+ */
+inline vec3 aces(const vec3& c)
+{
+    vec3 result;
+    for (int i = 0; i < 3; ++i) {
+        const float x = c[i];
+        result[i] = clamp((x * (2.51f * x + 0.03f)) / (x * (2.43f * x + 0.59f) + 0.14f), 0.0f, 1.0f);
+    }
+
+    return result;
+}
+
+/**
+ * AgX base look using the polynomial contrast approximation, output is linear in [0, 1].
+ */
+inline vec3 agx(const vec3& c)
+{
+    const float minEv = -12.47393f;
+    const float maxEv = 4.026069f;
+
+    // inset into the AgX working space
+    const vec3 inset(0.842479062f * c.x + 0.078433600f * c.y + 0.079223745f * c.z,
+                     0.042328242f * c.x + 0.878468636f * c.y + 0.079166127f * c.z,
+                     0.042375655f * c.x + 0.078433600f * c.y + 0.879142974f * c.z);
+
+    vec3 curve;
+    for (int i = 0; i < 3; ++i) {
+        const float ev = clamp(flog2(std::max(inset[i], 1e-10f)), minEv, maxEv);
+        const float x = (ev - minEv) / (maxEv - minEv);
+        const float x2 = x * x;
+        const float x4 = x2 * x2;
+        curve[i] = 15.5f * x4 * x2 - 40.14f * x4 * x + 31.96f * x4 - 6.868f * x2 * x + 0.4298f * x2 + 0.1191f * x - 0.00232f;
+    }
+
+    // outset back and undo the display encoding of the curve
+    const vec3 outset(1.196879005f * curve.x - 0.098020881f * curve.y - 0.099029744f * curve.z,
+                      -0.052896852f * curve.x + 1.151903130f * curve.y - 0.098961177f * curve.z,
+                      -0.052971636f * curve.x - 0.098043450f * curve.y + 1.151073673f * curve.z);
+
+    return vec3(fpow(clamp(outset.x, 0.0f, 1.0f), 2.2f),
+                fpow(clamp(outset.y, 0.0f, 1.0f), 2.2f),
+                fpow(clamp(outset.z, 0.0f, 1.0f), 2.2f));
+}
+
+/**
+ * Applies a per-pixel conversion to an array, for any of the functions above,
+ * e.g. convertColors(pixels, pixels, count, lia::linearToOklab).
+ */
+template <typename Conversion>
+inline void convertColors(const vec3* in, vec3* out, std::size_t count, Conversion conversion)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = conversion(in[i]);
+}
+
+template <typename Conversion>
+inline void convertColors(const vec4* in, vec4* out, std::size_t count, Conversion conversion)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const vec3 rgb = conversion(vec3(in[i].x, in[i].y, in[i].z));
+        out[i] = vec4(rgb.x, rgb.y, rgb.z, in[i].w);
+    }
+}
+
+inline void aces(const vec3* in, vec3* out, std::size_t count)
+{
+    convertColors(in, out, count, [](const vec3& c) { return aces(c); });
+}
+
+inline void reinhard(const vec3* in, vec3* out, std::size_t count)
+{
+    convertColors(in, out, count, [](const vec3& c) { return reinhard(c); });
+}
+
+inline void agx(const vec3* in, vec3* out, std::size_t count)
+{
+    convertColors(in, out, count, [](const vec3& c) { return agx(c); });
+}
+} // namespace lia
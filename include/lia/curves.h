@@ -0,0 +1,292 @@
+#pragma once
+
+#include "mathbase.h"
+#include "quaternion.h"
+#include "vec2.h"
+#include "vec3.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace lia {
+/**
+ * A cubic curve segment in power basis, p(t) = a t^3 + b t^2 + c t + d for t in [0, 1].
+ *
+ * Every curve type below converts to this form once, after which evaluation
+ * is two Horner chains regardless of how the curve was specified.
+ * T is vec2 or vec3.
+ */
+template <typename T>
+struct cubicCurve {
+    T a;
+    T b;
+    T c;
+    T d;
+
+    T position(float t) const
+    {
+        return ((a * t + b) * t + c) * t + d;
+    }
+
+    T tangent(float t) const
+    {
+        return (a * (3.0f * t) + b * 2.0f) * t + c;
+    }
+
+    /**
+     * The equivalent cubic Bezier control points.
+     */
+    void controlPoints(T& p0, T& p1, T& p2, T& p3) const
+    {
+        p0 = d;
+        p1 = d + c * (1.0f / 3.0f);
+        p2 = d + c * (2.0f / 3.0f) + b * (1.0f / 3.0f);
+        p3 = a + b + c + d;
+    }
+};
+
+template <typename T>
+inline cubicCurve<T> bezierCurve(const T& p0, const T& p1, const T& p2, const T& p3)
+{
+    return { (p3 - p0) + (p1 - p2) * 3.0f,
+             (p0 + p2) * 3.0f - p1 * 6.0f,
+             (p1 - p0) * 3.0f,
+             p0 };
+}
+
+/**
+ * @param m0 The tangent at p0
+ * @param m1 The tangent at p1
+ */
+template <typename T>
+inline cubicCurve<T> hermiteCurve(const T& p0, const T& m0, const T& p1, const T& m1)
+{
+    return { (p0 - p1) * 2.0f + m0 + m1,
+             (p1 - p0) * 3.0f - m0 * 2.0f - m1,
+             m0,
+             p0 };
+}
+
+/**
+ * The uniform Catmull-Rom segment between p1 and p2.
+ */
+template <typename T>
+inline cubicCurve<T> catmullRomCurve(const T& p0, const T& p1, const T& p2, const T& p3)
+{
+    return hermiteCurve(p1, (p2 - p0) * 0.5f, p2, (p3 - p1) * 0.5f);
+}
+
+/**
+ * The uniform cubic B-spline segment of four consecutive control points.
+ */
+template <typename T>
+inline cubicCurve<T> bsplineCurve(const T& p0, const T& p1, const T& p2, const T& p3)
+{
+    const float s = 1.0f / 6.0f;
+    return { ((p1 - p2) * 3.0f + p3 - p0) * s,
+             ((p0 + p2) * 3.0f - p1 * 6.0f) * s,
+             (p2 - p0) * 0.5f,
+             (p0 + p1 * 4.0f + p2) * s };
+}
+
+/**
+ * Evaluates positions and, optionally, tangents at an array of parameters.
+ *
+ * @param tangents May be nullptr when only positions are needed
+ */
+template <typename T>
+inline void evaluate(const cubicCurve<T>& curve, const float* t, T* positions, T* tangents, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        positions[i] = curve.position(t[i]);
+
+    if (tangents) {
+        for (std::size_t i = 0; i < count; ++i)
+            tangents[i] = curve.tangent(t[i]);
+    }
+}
+
+/**
+ * Cumulative arc length sampled at uniform parameter steps, used to
+ * reparameterize a curve by distance for constant-speed motion.
+ */
+template <typename T>
+struct arcLengthTable {
+    std::vector<float> lengths;
+
+    arcLengthTable() = default;
+
+    /**
+     * @param samples The number of chords used to approximate the curve
+     */
+    arcLengthTable(const cubicCurve<T>& curve, int samples = 64)
+    {
+        lengths.resize(static_cast<std::size_t>(samples) + 1);
+        lengths[0] = 0.0f;
+
+        T previous = curve.d;
+        for (int i = 1; i <= samples; ++i) {
+            const T current = curve.position(static_cast<float>(i) / static_cast<float>(samples));
+            lengths[i] = lengths[i - 1] + magnitude(current - previous);
+            previous = current;
+        }
+    }
+
+    float totalLength() const
+    {
+        return lengths.empty() ? 0.0f : lengths.back();
+    }
+
+    /**
+     * Maps a distance along the curve to the curve parameter.
+     */
+    float parameterAt(float distance) const
+    {
+        if (lengths.empty() || distance <= 0.0f)
+            return 0.0f;
+        const std::size_t samples = lengths.size() - 1;
+        if (distance >= lengths.back())
+            return 1.0f;
+
+        const std::size_t upper = static_cast<std::size_t>(std::upper_bound(lengths.begin(), lengths.end(), distance) - lengths.begin());
+        const std::size_t lower = upper - 1;
+        const float span = lengths[upper] - lengths[lower];
+        const float fraction = span > 0.0f ? (distance - lengths[lower]) / span : 0.0f;
+
+        return (static_cast<float>(lower) + fraction) / static_cast<float>(samples);
+    }
+};
+
+/**
+ * Writes count points spaced evenly by arc length, including both end points.
+ */
+template <typename T>
+inline void sampleUniform(const cubicCurve<T>& curve, const arcLengthTable<T>& table, T* out, std::size_t count)
+{
+    if (count == 1) {
+        out[0] = curve.d;
+        return;
+    }
+
+    const float step = table.totalLength() / static_cast<float>(count - 1);
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = curve.position(table.parameterAt(step * static_cast<float>(i)));
+}
+
+/**
+ * Adaptively subdivides the curve until each piece deviates from its chord by
+ * less than tolerance and writes the resulting polyline, starting point included.
+ *
+ * @return The number of points the polyline has; only the first capacity are written
+ */
+template <typename T>
+inline std::size_t flatten(const cubicCurve<T>& curve, float tolerance, T* out, std::size_t capacity)
+{
+    struct piece {
+        T p0, p1, p2, p3;
+        int depth;
+    };
+
+    const int maxDepth = 16;
+    const float limit = 16.0f * tolerance * tolerance;
+
+    piece stack[maxDepth + 1];
+    int top = 0;
+    curve.controlPoints(stack[0].p0, stack[0].p1, stack[0].p2, stack[0].p3);
+    stack[0].depth = 0;
+
+    std::size_t written = 0;
+    if (capacity > 0)
+        out[0] = stack[0].p0;
+    ++written;
+
+    while (top >= 0) {
+        const piece p = stack[top--];
+
+        // distance bound of the control polygon from the chord (Willcocks)
+        const T u = p.p1 * 3.0f - p.p0 * 2.0f - p.p3;
+        const T v = p.p2 * 3.0f - p.p3 * 2.0f - p.p0;
+        const float flatness = std::max(dot(u, u), dot(v, v));
+
+        if (flatness <= limit || p.depth == maxDepth) {
+            if (written < capacity)
+                out[written] = p.p3;
+            ++written;
+            continue;
+        }
+
+        // de Casteljau split at t = 0.5, second half pushed first so the first half is emitted first
+        const T p01 = (p.p0 + p.p1) * 0.5f;
+        const T p12 = (p.p1 + p.p2) * 0.5f;
+        const T p23 = (p.p2 + p.p3) * 0.5f;
+        const T p012 = (p01 + p12) * 0.5f;
+        const T p123 = (p12 + p23) * 0.5f;
+        const T mid = (p012 + p123) * 0.5f;
+
+        stack[++top] = { mid, p123, p23, p.p3, p.depth + 1 };
+        stack[++top] = { p.p0, p01, p012, mid, p.depth + 1 };
+    }
+
+    return written;
+}
+
+namespace detail {
+    inline quaternion quaternionLog(const quaternion& q)
+    {
+        const vec3& v = q.GetVectorPart();
+        const float length = magnitude(v);
+        if (length < 1e-6f)
+            return quaternion(v, 0.0f);
+
+        const float angle = fatan2(length, q.w);
+        return quaternion(v * (angle / length), 0.0f);
+    }
+
+    inline quaternion quaternionExp(const quaternion& q)
+    {
+        const vec3& v = q.GetVectorPart();
+        const float angle = magnitude(v);
+        if (angle < 1e-6f)
+            return normalize(quaternion(v, 1.0f));
+
+        return quaternion(v * (fsin(angle) / angle), fcos(angle));
+    }
+} // namespace detail
+
+/**
+ * The inner squad control quaternion at key q given its neighbours.
+ */
+inline quaternion squadControl(const quaternion& previous, const quaternion& q, const quaternion& next)
+{
+    const quaternion inverse = Conjugate(q);
+    quaternion toNext = inverse * next;
+    quaternion toPrevious = inverse * previous;
+
+    // keep both logarithms on the short arc
+    if (toNext.w < 0.0f)
+        toNext = toNext * -1.0f;
+    if (toPrevious.w < 0.0f)
+        toPrevious = toPrevious * -1.0f;
+
+    const quaternion sum = detail::quaternionLog(toNext) + detail::quaternionLog(toPrevious);
+    return q * detail::quaternionExp(sum * -0.25f);
+}
+
+/**
+ * Spherical quadrangle interpolation between q1 and q2, C1 continuous across keys.
+ *
+ * @param s1 squadControl of q1
+ * @param s2 squadControl of q2
+ */
+inline quaternion squad(const quaternion& q1, const quaternion& q2, const quaternion& s1, const quaternion& s2, float t)
+{
+    return slerp(slerp(q1, q2, t), slerp(s1, s2, t), 2.0f * t * (1.0f - t));
+}
+
+inline void squad(const quaternion& q1, const quaternion& q2, const quaternion& s1, const quaternion& s2, const float* t, quaternion* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = squad(q1, q2, s1, s2, t[i]);
+}
+} // namespace lia
@@ -0,0 +1,761 @@
+#pragma once
+
+#include "mathbase.h"
+#include "clip2d.h"
+#include "predicates.h"
+#include "vec2.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lia {
+/**
+ * Marks a missing half-edge, i.e. an edge on the convex hull.
+ */
+constexpr uint32_t DELAUNAY_INVALID = 0xFFFFFFFFu;
+
+namespace detail {
+    inline uint32_t nextHalfedge(uint32_t e)
+    {
+        return e % 3 == 2 ? e - 2 : e + 1;
+    }
+
+    inline uint32_t prevHalfedge(uint32_t e)
+    {
+        return e % 3 == 0 ? e + 2 : e - 1;
+    }
+
+    inline uint32_t interleaveBits(uint32_t x)
+    {
+        x = (x | (x << 8)) & 0x00FF00FFu;
+        x = (x | (x << 4)) & 0x0F0F0F0Fu;
+        x = (x | (x << 2)) & 0x33333333u;
+        x = (x | (x << 1)) & 0x55555555u;
+        return x;
+    }
+
+    // position along a Hilbert curve over a 65536 x 65536 grid; a branch-free prefix scan over the orientation states
+    inline uint32_t hilbertIndex(uint32_t x, uint32_t y)
+    {
+        uint32_t A, B, C, D;
+        {
+            const uint32_t a = x ^ y;
+            const uint32_t b = 0xFFFFu ^ a;
+            const uint32_t c = 0xFFFFu ^ (x | y);
+            const uint32_t d = x & (y ^ 0xFFFFu);
+            A = a | (b >> 1);
+            B = (a >> 1) ^ a;
+            C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+            D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+        }
+
+        for (uint32_t shift = 2; shift <= 4; shift *= 2) {
+            const uint32_t a = A, b = B, c = C, d = D;
+            A = (a & (a >> shift)) ^ (b & (b >> shift));
+            B = (a & (b >> shift)) ^ (b & ((a ^ b) >> shift));
+            C ^= (a & (c >> shift)) ^ (b & (d >> shift));
+            D ^= (b & (c >> shift)) ^ ((a ^ b) & (d >> shift));
+        }
+
+        const uint32_t c = C ^ (A & (C >> 8)) ^ (B & (D >> 8));
+        const uint32_t d = D ^ (B & (C >> 8)) ^ ((A ^ B) & (D >> 8));
+
+        const uint32_t a = c ^ (c >> 1);
+        const uint32_t b = d ^ (d >> 1);
+        const uint32_t i0 = x ^ y;
+        const uint32_t i1 = b | (0xFFFFu ^ (i0 | a));
+
+        return (interleaveBits(i1) << 1) | interleaveBits(i0);
+    }
+
+    // stable LSD radix sort by the upper 32 bits, 8 bits per pass
+    inline void radixSortHigh(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch)
+    {
+        scratch.resize(keys.size());
+        for (int shift = 32; shift < 64; shift += 8) {
+            std::size_t offsets[257] = {};
+            for (uint64_t key : keys)
+                ++offsets[((key >> shift) & 0xFF) + 1];
+            for (int i = 0; i < 256; ++i)
+                offsets[i + 1] += offsets[i];
+            for (uint64_t key : keys)
+                scratch[offsets[(key >> shift) & 0xFF]++] = key;
+            keys.swap(scratch);
+        }
+    }
+
+    // true if p, known to be on the line through a and b, lies strictly between them
+    inline bool betweenCollinear(const vec2& a, const vec2& b, const vec2& p)
+    {
+        if (a.x != b.x)
+            return (p.x > a.x && p.x < b.x) || (p.x < a.x && p.x > b.x);
+
+        return (p.y > a.y && p.y < b.y) || (p.y < a.y && p.y > b.y);
+    }
+} // namespace detail
+
+inline vec2 circumcenter(const vec2& a, const vec2& b, const vec2& c)
+{
+    const double bx = static_cast<double>(b.x) - a.x, by = static_cast<double>(b.y) - a.y;
+    const double cx = static_cast<double>(c.x) - a.x, cy = static_cast<double>(c.y) - a.y;
+    const double b2 = bx * bx + by * by;
+    const double c2 = cx * cx + cy * cy;
+    const double d = 2.0 * (bx * cy - by * cx);
+
+    return vec2(static_cast<float>(a.x + (cy * b2 - by * c2) / d), static_cast<float>(a.y + (bx * c2 - cx * b2) / d));
+}
+
+/**
+ * Delaunay triangulation of a point set in a compact half-edge layout.
+ *
+ * Triangle t is made of half-edges 3t, 3t + 1 and 3t + 2; triangles[e] is the
+ * vertex half-edge e starts at and halfedges[e] its twin in the neighbouring
+ * triangle. This is the same layout Delaunator uses, so existing mesh code for
+ * that format reads it directly.
+ *
+ * Points are inserted incrementally (Bowyer-Watson) in a biased randomized
+ * insertion order whose rounds are sorted along a Hilbert curve, so each point
+ * is located by a short walk from the previous one. The convex hull is closed
+ * by ghost triangles during construction, all decisions use the exact
+ * predicates, and duplicate points are skipped. Keep one triangulation per
+ * thread; independent point sets can be built concurrently.
+ */
+struct delaunayTriangulation {
+    std::vector<uint32_t> triangles;
+    std::vector<uint32_t> halfedges;
+    std::vector<uint8_t> constrained; // nonzero for half-edges that belong to a constraint
+
+    std::size_t triangleCount() const
+    {
+        return triangles.size() / 3;
+    }
+
+    /**
+     * Triangulates count points. Produces no triangles when all points are collinear.
+     */
+    void build(const vec2* points, std::size_t count)
+    {
+        triangles.clear();
+        halfedges.clear();
+        constrained.clear();
+        vertexEdge.assign(count, DELAUNAY_INVALID);
+        if (count < 3)
+            return;
+
+        ghost = static_cast<uint32_t>(count);
+        insertionOrder(points, count);
+
+        // work on a copy in insertion order so neighbouring insertions touch neighbouring memory
+        sorted.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+            sorted[i] = points[order[i]];
+
+        // the seed triangle: the first point, the next distinct one and the next one off their line
+        const vec2* local = sorted.data();
+        uint32_t b = 1;
+        while (b < count && local[b].x == local[0].x && local[b].y == local[0].y)
+            ++b;
+        if (b == count)
+            return;
+
+        uint32_t c = b + 1;
+        while (c < count && orient2d(local[0], local[b], local[c]) == 0.0)
+            ++c;
+        if (c == count)
+            return;
+
+        // with the ghost vertex closing the hull, n points always make 2n - 2 triangles
+        triangles.resize(6 * count);
+        halfedges.resize(6 * count);
+        marks.assign(2 * count, 0);
+        startAt.assign(count + 1, 0);
+        used = 0;
+        stamp = 0;
+
+        if (orient2d(local[0], local[b], local[c]) > 0.0)
+            createSeed(0, b, c);
+        else
+            createSeed(0, c, b);
+
+        for (uint32_t i = 1; i < count; ++i) {
+            if (i != b && i != c)
+                insert(local, i);
+        }
+
+        compact();
+    }
+
+    /**
+     * Forces the segment between vertices a and b into the triangulation; the
+     * triangles it crossed are replaced by a constrained Delaunay triangulation
+     * of the two sides. Vertices lying on the segment split it.
+     *
+     * @return False if the segment would cross an earlier constraint; pieces
+     * before a splitting vertex may already have been inserted
+     */
+    bool addConstraint(const vec2* points, uint32_t a, uint32_t b)
+    {
+        if (a == b || vertexEdge[a] == DELAUNAY_INVALID || vertexEdge[b] == DELAUNAY_INVALID)
+            return false;
+
+        const vec2& pa = points[a];
+        const vec2& pb = points[b];
+
+        // the triangle around a that the segment leaves through
+        uint32_t crossed = DELAUNAY_INVALID;
+        collectOutgoing(a);
+        for (uint32_t e : around) {
+            const uint32_t x = triangles[detail::nextHalfedge(e)];
+            const uint32_t y = triangles[detail::prevHalfedge(e)];
+            if (x == b) {
+                markConstrained(e);
+                return true;
+            }
+            if (y == b) {
+                markConstrained(detail::prevHalfedge(e));
+                return true;
+            }
+
+            const double ox = orient2d(pa, pb, points[x]);
+            const double oy = orient2d(pa, pb, points[y]);
+            if (ox == 0.0 && sameDirection(pa, pb, points[x]))
+                return addConstraint(points, a, x) && addConstraint(points, x, b);
+            if (oy == 0.0 && sameDirection(pa, pb, points[y]))
+                return addConstraint(points, a, y) && addConstraint(points, y, b);
+
+            if (ox < 0.0 && oy > 0.0) {
+                crossed = detail::nextHalfedge(e);
+                break;
+            }
+        }
+
+        if (crossed == DELAUNAY_INVALID)
+            return false;
+
+        // march through the crossed triangles, splitting their vertices into the two sides
+        removed.assign(1, crossed / 3);
+        left.assign(1, triangles[detail::nextHalfedge(crossed)]);
+        right.assign(1, triangles[crossed]);
+
+        uint32_t h = crossed;
+        for (;;) {
+            if (constrained[h])
+                return false;
+
+            const uint32_t o = halfedges[h];
+            removed.push_back(o / 3);
+
+            const uint32_t z = triangles[detail::prevHalfedge(o)];
+            if (z == b)
+                break;
+
+            const double oz = orient2d(pa, pb, points[z]);
+            if (oz == 0.0)
+                return addConstraint(points, a, z) && addConstraint(points, z, b);
+
+            if (oz > 0.0) {
+                left.push_back(z);
+                h = detail::nextHalfedge(o);
+            } else {
+                right.push_back(z);
+                h = detail::prevHalfedge(o);
+            }
+        }
+
+        retriangulate(points, a, b);
+        return true;
+    }
+
+private:
+    struct boundaryEdge {
+        uint32_t u, v;
+        uint32_t outer;
+        uint32_t triangle;
+        uint8_t constrained;
+    };
+
+    uint32_t ghost { 0 };
+    uint32_t used { 0 };
+    uint32_t last { 0 };
+    uint32_t stamp { 0 };
+    uint32_t walkCounter { 0 };
+
+    std::vector<uint32_t> order;
+    std::vector<vec2> sorted;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> scratchKeys;
+    std::vector<uint32_t> marks;
+    std::vector<uint32_t> startAt;
+    std::vector<uint32_t> vertexEdge;
+    std::vector<uint32_t> cavity;
+    std::vector<boundaryEdge> boundary;
+
+    std::vector<uint32_t> around;
+    std::vector<uint32_t> removed;
+    std::vector<uint32_t> left;
+    std::vector<uint32_t> right;
+    std::vector<uint32_t> created;
+
+    // biased randomized insertion order (Amenta et al.): rounds of doubling size, each sorted along a Hilbert curve
+    void insertionOrder(const vec2* points, std::size_t count)
+    {
+        vec2 lower = points[0], upper = points[0];
+        for (std::size_t i = 1; i < count; ++i) {
+            lower = vec2(std::min(lower.x, points[i].x), std::min(lower.y, points[i].y));
+            upper = vec2(std::max(upper.x, points[i].x), std::max(upper.y, points[i].y));
+        }
+
+        const float sx = upper.x > lower.x ? 65535.0f / (upper.x - lower.x) : 0.0f;
+        const float sy = upper.y > lower.y ? 65535.0f / (upper.y - lower.y) : 0.0f;
+
+        // one stable sort does it all: the key is round (4 bits), Hilbert index (28 bits) and point index.
+        // Each point lands in the last round with probability 1/2, the one before with 1/4 and so on;
+        // a fixed hash keeps builds reproducible.
+        keys.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const uint32_t x = static_cast<uint32_t>((points[i].x - lower.x) * sx);
+            const uint32_t y = static_cast<uint32_t>((points[i].y - lower.y) * sy);
+            const uint32_t hilbert = detail::hilbertIndex(x, y) >> 4;
+
+            uint32_t hash = static_cast<uint32_t>(i) * 0x9E3779B9u;
+            hash ^= hash >> 16;
+            hash *= 0x85EBCA6Bu;
+            hash ^= hash >> 13;
+            uint64_t round = 15;
+            while (round > 0 && (hash & 1u)) {
+                --round;
+                hash >>= 1;
+            }
+
+            keys[i] = round << 60 | static_cast<uint64_t>(hilbert) << 32 | static_cast<uint64_t>(i);
+        }
+
+        detail::radixSortHigh(keys, scratchKeys);
+
+        order.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+            order[i] = static_cast<uint32_t>(keys[i]);
+    }
+
+    uint32_t allocate()
+    {
+        return used++;
+    }
+
+    bool isGhost(uint32_t t) const
+    {
+        return triangles[3 * t] == ghost || triangles[3 * t + 1] == ghost || triangles[3 * t + 2] == ghost;
+    }
+
+    // joins the (v, p) edges of triangles (u, v, p) around a common apex p
+    void linkFan()
+    {
+        for (const boundaryEdge& edge : boundary)
+            startAt[edge.u] = edge.triangle;
+
+        for (const boundaryEdge& edge : boundary) {
+            const uint32_t e = 3 * edge.triangle + 1;
+            const uint32_t twin = 3 * startAt[edge.v] + 2;
+            halfedges[e] = twin;
+            halfedges[twin] = e;
+        }
+    }
+
+    void createSeed(uint32_t a, uint32_t b, uint32_t c)
+    {
+        const uint32_t t = allocate();
+        triangles[0] = a;
+        triangles[1] = b;
+        triangles[2] = c;
+
+        // one ghost triangle outside each edge, sharing the ghost vertex
+        boundary.clear();
+        for (uint32_t k = 0; k < 3; ++k) {
+            const uint32_t g = allocate();
+            const uint32_t u = triangles[3 * t + (k + 1) % 3];
+            const uint32_t v = triangles[3 * t + k];
+            triangles[3 * g] = u;
+            triangles[3 * g + 1] = v;
+            triangles[3 * g + 2] = ghost;
+            halfedges[3 * g] = k;
+            halfedges[k] = 3 * g;
+            boundary.push_back({ u, v, k, g, 0 });
+        }
+
+        linkFan();
+        last = t;
+    }
+
+    bool ghostConflict(const vec2* points, uint32_t u, uint32_t v, const vec2& p) const
+    {
+        const double o = orient2d(points[u], points[v], p);
+        if (o != 0.0)
+            return o > 0.0;
+
+        return detail::betweenCollinear(points[u], points[v], p);
+    }
+
+    bool conflict(const vec2* points, uint32_t t, const vec2& p) const
+    {
+        const uint32_t a = triangles[3 * t], b = triangles[3 * t + 1], c = triangles[3 * t + 2];
+        if (a == ghost)
+            return ghostConflict(points, b, c, p);
+        if (b == ghost)
+            return ghostConflict(points, c, a, p);
+        if (c == ghost)
+            return ghostConflict(points, a, b, p);
+
+        return incircle(points[a], points[b], points[c], p) > 0.0;
+    }
+
+    // visibility walk from the last created triangle; returns a triangle in conflict with p or invalid for duplicates
+    uint32_t locate(const vec2* points, const vec2& p)
+    {
+        uint32_t t = last;
+        if (isGhost(t)) {
+            uint32_t k = 0;
+            while (triangles[3 * t + k] != ghost)
+                ++k;
+            t = halfedges[3 * t + (k + 1) % 3] / 3;
+        }
+
+        // the edge the walk entered through never needs testing again
+        uint32_t entry = DELAUNAY_INVALID;
+        for (;;) {
+            walkCounter = walkCounter == 2 ? 0 : walkCounter + 1;
+            uint32_t exit = DELAUNAY_INVALID;
+            for (uint32_t k = 0; k < 3; ++k) {
+                const uint32_t e = 3 * t + (walkCounter + k) % 3;
+                if (e != entry && orient2d(points[triangles[e]], points[triangles[detail::nextHalfedge(e)]], p) < 0.0) {
+                    exit = e;
+                    break;
+                }
+            }
+
+            if (exit == DELAUNAY_INVALID)
+                break;
+
+            entry = halfedges[exit];
+            t = entry / 3;
+            if (isGhost(t))
+                return t;
+        }
+
+        for (uint32_t k = 0; k < 3; ++k) {
+            const vec2& v = points[triangles[3 * t + k]];
+            if (v.x == p.x && v.y == p.y)
+                return DELAUNAY_INVALID;
+        }
+
+        return t;
+    }
+
+    void insert(const vec2* points, uint32_t index)
+    {
+        const vec2& p = points[index];
+        const uint32_t seed = locate(points, p);
+        if (seed == DELAUNAY_INVALID)
+            return;
+
+        // grow the cavity of triangles whose circumcircle contains p
+        stamp += 2;
+        cavity.assign(1, seed);
+        boundary.clear();
+        marks[seed] = stamp;
+
+        for (std::size_t i = 0; i < cavity.size(); ++i) {
+            const uint32_t t = cavity[i];
+            for (uint32_t e = 3 * t; e < 3 * t + 3; ++e) {
+                const uint32_t twin = halfedges[e];
+                const uint32_t n = twin / 3;
+                if (marks[n] == stamp)
+                    continue;
+
+                if (marks[n] != stamp + 1 && conflict(points, n, p)) {
+                    marks[n] = stamp;
+                    cavity.push_back(n);
+                    continue;
+                }
+
+                marks[n] = stamp + 1;
+                boundary.push_back({ triangles[e], triangles[detail::nextHalfedge(e)], twin, 0, 0 });
+            }
+        }
+
+        // connect p to every boundary edge, reusing the cavity slots first
+        std::size_t reuse = 0;
+        for (boundaryEdge& edge : boundary) {
+            const uint32_t t = reuse < cavity.size() ? cavity[reuse++] : allocate();
+            triangles[3 * t] = edge.u;
+            triangles[3 * t + 1] = edge.v;
+            triangles[3 * t + 2] = index;
+            halfedges[3 * t] = edge.outer;
+            halfedges[edge.outer] = 3 * t;
+            edge.triangle = t;
+        }
+
+        linkFan();
+        last = boundary.back().triangle;
+    }
+
+    // drops the ghost triangles, renumbering the remaining ones in place and restoring the caller's vertex indices
+    void compact()
+    {
+        const std::size_t count = used;
+        uint32_t next = 0;
+        for (std::size_t t = 0; t < count; ++t)
+            marks[t] = isGhost(static_cast<uint32_t>(t)) ? DELAUNAY_INVALID : next++;
+
+        for (std::size_t t = 0; t < count; ++t) {
+            const uint32_t target = marks[t];
+            if (target == DELAUNAY_INVALID)
+                continue;
+
+            for (uint32_t k = 0; k < 3; ++k) {
+                const uint32_t twin = halfedges[3 * t + k];
+                const uint32_t other = marks[twin / 3];
+                triangles[3 * target + k] = order[triangles[3 * t + k]];
+                halfedges[3 * target + k] = other == DELAUNAY_INVALID ? DELAUNAY_INVALID : 3 * other + twin % 3;
+            }
+        }
+
+        triangles.resize(3 * static_cast<std::size_t>(next));
+        halfedges.resize(3 * static_cast<std::size_t>(next));
+        constrained.assign(triangles.size(), 0);
+        marks.assign(next, 0);
+        stamp = 0;
+
+        for (uint32_t e = 0; e < triangles.size(); ++e)
+            vertexEdge[triangles[e]] = e;
+    }
+
+    // outgoing half-edges of a vertex in counter-clockwise order
+    void collectOutgoing(uint32_t vertex)
+    {
+        around.clear();
+        const uint32_t start = vertexEdge[vertex];
+        uint32_t e = start;
+        do {
+            around.push_back(e);
+            e = halfedges[detail::prevHalfedge(e)];
+        } while (e != DELAUNAY_INVALID && e != start);
+
+        // on the hull the rotation stops, continue clockwise from the start
+        if (e == DELAUNAY_INVALID) {
+            e = halfedges[start];
+            while (e != DELAUNAY_INVALID) {
+                e = detail::nextHalfedge(e);
+                around.push_back(e);
+                e = halfedges[e];
+            }
+        }
+    }
+
+    void markConstrained(uint32_t e)
+    {
+        constrained[e] = 1;
+        if (halfedges[e] != DELAUNAY_INVALID)
+            constrained[halfedges[e]] = 1;
+    }
+
+    // for p collinear with a and b: whether p lies on the ray from a through b
+    static bool sameDirection(const vec2& a, const vec2& b, const vec2& p)
+    {
+        if (a.x != b.x)
+            return (p.x - a.x > 0.0f) == (b.x - a.x > 0.0f) && p.x != a.x;
+
+        return (p.y - a.y > 0.0f) == (b.y - a.y > 0.0f) && p.y != a.y;
+    }
+
+    // Anglada's recursion: the chain lies left of a -> b and is ordered from a to b
+    void triangulatePseudoPolygon(const vec2* points, uint32_t a, uint32_t b, const uint32_t* chain, std::size_t count)
+    {
+        if (count == 0)
+            return;
+
+        std::size_t c = 0;
+        for (std::size_t i = 1; i < count; ++i) {
+            if (incircle(points[a], points[b], points[chain[c]], points[chain[i]]) > 0.0)
+                c = i;
+        }
+
+        created.push_back(a);
+        created.push_back(b);
+        created.push_back(chain[c]);
+
+        triangulatePseudoPolygon(points, a, chain[c], chain, c);
+        triangulatePseudoPolygon(points, chain[c], b, chain + c + 1, count - c - 1);
+    }
+
+    void retriangulate(const vec2* points, uint32_t a, uint32_t b)
+    {
+        // the edges around the removed region keep their outer twins and constraint flags
+        stamp += 2;
+        for (uint32_t t : removed)
+            marks[t] = stamp;
+
+        boundary.clear();
+        for (uint32_t t : removed) {
+            for (uint32_t e = 3 * t; e < 3 * t + 3; ++e) {
+                const uint32_t twin = halfedges[e];
+                if (twin != DELAUNAY_INVALID && marks[twin / 3] == stamp)
+                    continue;
+                boundary.push_back({ triangles[e], triangles[detail::nextHalfedge(e)], twin, 0, constrained[e] });
+            }
+        }
+
+        created.clear();
+        triangulatePseudoPolygon(points, a, b, left.data(), left.size());
+        std::reverse(right.begin(), right.end());
+        triangulatePseudoPolygon(points, b, a, right.data(), right.size());
+
+        // both sides together have exactly as many triangles as were removed
+        for (std::size_t i = 0; i < removed.size(); ++i) {
+            for (uint32_t k = 0; k < 3; ++k)
+                triangles[3 * removed[i] + k] = created[3 * i + k];
+        }
+
+        for (uint32_t t : removed) {
+            for (uint32_t e = 3 * t; e < 3 * t + 3; ++e) {
+                const uint32_t u = triangles[e];
+                const uint32_t v = triangles[detail::nextHalfedge(e)];
+                vertexEdge[u] = e;
+
+                if ((u == a && v == b) || (u == b && v == a)) {
+                    linkInside(e, u, v);
+                    constrained[e] = 1;
+                    continue;
+                }
+
+                if (linkInside(e, u, v)) {
+                    constrained[e] = 0;
+                    continue;
+                }
+
+                for (const boundaryEdge& edge : boundary) {
+                    if (edge.u == u && edge.v == v) {
+                        halfedges[e] = edge.outer;
+                        if (edge.outer != DELAUNAY_INVALID)
+                            halfedges[edge.outer] = e;
+                        constrained[e] = edge.constrained;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // links e = (u, v) with its twin (v, u) among the new triangles
+    bool linkInside(uint32_t e, uint32_t u, uint32_t v)
+    {
+        for (uint32_t t : removed) {
+            for (uint32_t f = 3 * t; f < 3 * t + 3; ++f) {
+                if (triangles[f] == v && triangles[detail::nextHalfedge(f)] == u) {
+                    halfedges[e] = f;
+                    halfedges[f] = e;
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+};
+
+/**
+ * Writes the circumcenter of every triangle, the Voronoi vertices.
+ */
+inline void circumcenters(const delaunayTriangulation& triangulation, const vec2* points, vec2* out)
+{
+    const std::vector<uint32_t>& t = triangulation.triangles;
+    for (std::size_t i = 0; i < triangulation.triangleCount(); ++i)
+        out[i] = circumcenter(points[t[3 * i]], points[t[3 * i + 1]], points[t[3 * i + 2]]);
+}
+
+/**
+ * Builds the Voronoi cell of every point, clipped to a bounding rectangle.
+ *
+ * Cell i belongs to point i and is convex and counter-clockwise; the unbounded
+ * cells of hull points are closed by the rectangle. Duplicate points and
+ * degenerate (collinear) inputs get empty cells.
+ */
+inline void voronoi(const delaunayTriangulation& triangulation, const vec2* points, std::size_t count, const vec2& boundsMin, const vec2& boundsMax, polygonSet& cells)
+{
+    const std::vector<uint32_t>& triangles = triangulation.triangles;
+    const std::vector<uint32_t>& halfedges = triangulation.halfedges;
+
+    // start hull vertices at their outgoing hull edge so the sweep around them is not cut short
+    std::vector<uint32_t> start(count, DELAUNAY_INVALID);
+    for (uint32_t e = 0; e < triangles.size(); ++e) {
+        if (start[triangles[e]] == DELAUNAY_INVALID || halfedges[e] == DELAUNAY_INVALID)
+            start[triangles[e]] = e;
+    }
+
+    std::vector<vec2> centers(triangulation.triangleCount());
+    circumcenters(triangulation, points, centers.data());
+
+    const vec2 rectangle[4] = { boundsMin, vec2(boundsMax.x, boundsMin.y), boundsMax, vec2(boundsMin.x, boundsMax.y) };
+    const vec2 middle = (boundsMin + boundsMax) * 0.5f;
+    const float diagonal = magnitude(boundsMax - boundsMin);
+
+    std::vector<vec2> cell, out, scratch;
+    cells.clear();
+    cells.points.reserve(triangles.size());
+    cells.offsets.reserve(count + 1);
+
+    for (std::size_t v = 0; v < count; ++v) {
+        if (start[v] == DELAUNAY_INVALID) {
+            cells.addPolygon(nullptr, 0);
+            continue;
+        }
+
+        cell.clear();
+        uint32_t e = start[v];
+        uint32_t incoming;
+        float radius = diagonal;
+        do {
+            cell.push_back(centers[e / 3]);
+            radius = std::max(radius, magnitude(cell.back() - middle) + diagonal);
+            incoming = detail::prevHalfedge(e);
+            e = halfedges[incoming];
+        } while (e != DELAUNAY_INVALID && e != start[v]);
+
+        if (e == DELAUNAY_INVALID) {
+            // close the open cell far outside the rectangle along the outward hull normals
+            const vec2& p = points[v];
+            const vec2 toNext = points[triangles[detail::nextHalfedge(start[v])]] - p;
+            const vec2 fromPrevious = p - points[triangles[incoming]];
+            const vec2 first = normalize(vec2(toNext.y, -toNext.x));
+            const vec2 last = normalize(vec2(fromPrevious.y, -fromPrevious.x));
+            const float far = 4.0f * radius;
+
+            const vec2 front = cell.front();
+            cell.push_back(cell.back() + last * far);
+            cell.push_back(p + normalize(first + last) * far);
+            cell.push_back(front + first * far);
+        }
+
+        // most cells lie well inside the rectangle and need no clipping
+        bool inside = true;
+        for (const vec2& c : cell)
+            inside = inside && c.x >= boundsMin.x && c.y >= boundsMin.y && c.x <= boundsMax.x && c.y <= boundsMax.y;
+
+        if (inside) {
+            cells.addPolygon(cell.data(), cell.size());
+            continue;
+        }
+
+        out.resize(std::max(out.size(), 2 * (cell.size() + 4)));
+        scratch.resize(out.size());
+        const std::size_t needed = clipConvex(cell.data(), cell.size(), rectangle, 4, out.data(), out.size(), scratch.data());
+        if (needed > out.size()) {
+            out.resize(needed);
+            scratch.resize(needed);
+            clipConvex(cell.data(), cell.size(), rectangle, 4, out.data(), out.size(), scratch.data());
+        }
+        cells.addPolygon(out.data(), needed);
+    }
+}
+} // namespace lia
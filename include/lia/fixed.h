@@ -0,0 +1,957 @@
+#pragma once
+
+#include "mathbase.h"
+#include "mat4.h"
+#include "quaternion.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "vec4.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+
+namespace lia {
+namespace detail {
+    constexpr int64_t roundToInteger(double value)
+    {
+        return static_cast<int64_t>(value < 0.0 ? value - 0.5 : value + 0.5);
+    }
+
+    // |value| without overflow for the most negative value
+    inline uint64_t magnitudeOf(int64_t value)
+    {
+        return value < 0 ? 0u - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    }
+
+    inline int64_t applySign(uint64_t magnitude, bool negative)
+    {
+        return static_cast<int64_t>(negative ? 0u - magnitude : magnitude);
+    }
+
+    // two's complement sums and negation, which wrap instead of overflowing
+    template <typename Rep>
+    inline Rep wrappingAdd(Rep a, Rep b)
+    {
+        using U = std::make_unsigned_t<Rep>;
+        return static_cast<Rep>(static_cast<U>(static_cast<U>(a) + static_cast<U>(b)));
+    }
+
+    template <typename Rep>
+    inline Rep wrappingSubtract(Rep a, Rep b)
+    {
+        using U = std::make_unsigned_t<Rep>;
+        return static_cast<Rep>(static_cast<U>(static_cast<U>(a) - static_cast<U>(b)));
+    }
+
+    template <typename Rep>
+    inline Rep wrappingNegate(Rep a)
+    {
+        using U = std::make_unsigned_t<Rep>;
+        return static_cast<Rep>(static_cast<U>(U(0) - static_cast<U>(a)));
+    }
+
+    /**
+     * floor(sqrt(value * 4^extraPairs)) for a value of 2 * pairs bits, digit by
+     * digit, so the result is the same on every machine.
+     */
+    inline uint64_t isqrt(uint64_t value, int pairs, int extraPairs)
+    {
+        uint64_t remainder = 0;
+        uint64_t root = 0;
+        for (int i = 0; i < pairs + extraPairs; ++i) {
+            const int shift = 2 * (pairs - 1 - i);
+            remainder = (remainder << 2) | (shift >= 0 ? (value >> shift) & 3u : 0u);
+            root <<= 1;
+
+            const uint64_t trial = (root << 1) | 1u;
+            if (remainder >= trial) {
+                remainder -= trial;
+                root |= 1u;
+            }
+        }
+
+        return root;
+    }
+
+    template <typename Rep>
+    struct fixedTraits;
+
+    // Q16.16, products go through 64-bit integers
+    template <>
+    struct fixedTraits<int32_t> {
+        static constexpr int BITS = 16;
+        static constexpr int SIN_TERMS = 3;
+        static constexpr int COS_TERMS = 4;
+
+        // pi / 2 as the nearest Q16.16 value plus the rest in units of 2^-47
+        static constexpr int64_t HALF_PI = 102944;
+        static constexpr int64_t HALF_PI_REST = -626908823;
+        static constexpr int32_t TWO_OVER_PI = 41722;
+
+        // rounds half away from zero, as the Q32.32 product does
+        static int32_t multiply(int32_t a, int32_t b)
+        {
+            const int64_t product = static_cast<int64_t>(a) * b;
+            return static_cast<int32_t>(product < 0 ? -((-product + 0x8000) >> 16) : (product + 0x8000) >> 16);
+        }
+
+        // truncates toward zero, saturates on division by zero
+        static int32_t divide(int32_t a, int32_t b)
+        {
+            if (b == 0)
+                return a < 0 ? INT32_MIN : INT32_MAX;
+
+            return static_cast<int32_t>(static_cast<int64_t>(a) * 65536 / b);
+        }
+
+        static int32_t sqrt(int32_t a)
+        {
+            return a <= 0 ? 0 : static_cast<int32_t>(isqrt(static_cast<uint64_t>(a), 16, 8));
+        }
+    };
+
+    // Q32.32, products go through 128 bits assembled from 32-bit halves
+    template <>
+    struct fixedTraits<int64_t> {
+        static constexpr int BITS = 32;
+        static constexpr int SIN_TERMS = 5;
+        static constexpr int COS_TERMS = 6;
+
+        // pi / 2 as the nearest Q32.32 value plus the rest in units of 2^-63
+        static constexpr int64_t HALF_PI = 6746518852;
+        static constexpr int64_t HALF_PI_REST = 560513589;
+        static constexpr int64_t TWO_OVER_PI = 2734261102;
+
+        static int64_t multiply(int64_t a, int64_t b)
+        {
+            const uint64_t ua = magnitudeOf(a);
+            const uint64_t ub = magnitudeOf(b);
+            const uint64_t aLo = ua & 0xFFFFFFFFu, aHi = ua >> 32;
+            const uint64_t bLo = ub & 0xFFFFFFFFu, bHi = ub >> 32;
+
+            const uint64_t ll = aLo * bLo;
+            const uint64_t lh = aLo * bHi;
+            const uint64_t hl = aHi * bLo;
+            const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+            const uint64_t low = (ll & 0xFFFFFFFFu) | (mid << 32);
+            const uint64_t high = aHi * bHi + (lh >> 32) + (hl >> 32) + (mid >> 32);
+
+            // round half away from zero, then take bits 32..95
+            const uint64_t rounded = low + 0x80000000u;
+            const uint64_t carry = rounded < low ? 1u : 0u;
+
+            return applySign(((high + carry) << 32) | (rounded >> 32), (a < 0) != (b < 0));
+        }
+
+        // truncates toward zero, saturates on division by zero
+        static int64_t divide(int64_t a, int64_t b)
+        {
+            if (b == 0)
+                return a < 0 ? INT64_MIN : INT64_MAX;
+
+            const uint64_t ub = magnitudeOf(b);
+            uint64_t quotient = magnitudeOf(a) / ub;
+            uint64_t remainder = magnitudeOf(a) % ub;
+            for (int i = 0; i < 32; ++i) {
+                const bool carry = (remainder >> 63) != 0;
+                remainder <<= 1;
+                quotient <<= 1;
+                if (carry || remainder >= ub) {
+                    remainder -= ub;
+                    quotient |= 1u;
+                }
+            }
+
+            return applySign(quotient, (a < 0) != (b < 0));
+        }
+
+        static int64_t sqrt(int64_t a)
+        {
+            return a <= 0 ? 0 : static_cast<int64_t>(isqrt(static_cast<uint64_t>(a), 32, 16));
+        }
+    };
+
+    template <typename Rep>
+    constexpr Rep fixedConstant(double value)
+    {
+        return static_cast<Rep>(roundToInteger(value * static_cast<double>(int64_t(1) << fixedTraits<Rep>::BITS)));
+    }
+
+    /**
+     * Sine and cosine of a fixed-point angle in radians, from integer operations
+     * only: a two-part pi / 2 reduction to [-pi / 4, pi / 4], then Taylor
+     * polynomials cut off below the last fraction bit.
+     */
+    template <typename Rep>
+    inline void fixedSinCos(Rep angle, Rep& sine, Rep& cosine)
+    {
+        using traits = fixedTraits<Rep>;
+        static constexpr Rep SIN[5] = { fixedConstant<Rep>(-1.0 / 6.0), fixedConstant<Rep>(1.0 / 120.0), fixedConstant<Rep>(-1.0 / 5040.0),
+            fixedConstant<Rep>(1.0 / 362880.0), fixedConstant<Rep>(-1.0 / 39916800.0) };
+        static constexpr Rep COS[6] = { fixedConstant<Rep>(-1.0 / 2.0), fixedConstant<Rep>(1.0 / 24.0), fixedConstant<Rep>(-1.0 / 720.0),
+            fixedConstant<Rep>(1.0 / 40320.0), fixedConstant<Rep>(-1.0 / 3628800.0), fixedConstant<Rep>(1.0 / 479001600.0) };
+        const Rep one = fixedConstant<Rep>(1.0);
+
+        // quadrant count, then the remainder with the rounding of pi / 2 corrected
+        const int64_t scaled = traits::multiply(angle, traits::TWO_OVER_PI);
+        const int64_t k = (scaled + (int64_t(1) << (traits::BITS - 1))) >> traits::BITS;
+        const uint64_t coarse = static_cast<uint64_t>(static_cast<int64_t>(angle)) - static_cast<uint64_t>(k) * static_cast<uint64_t>(traits::HALF_PI);
+        const int64_t fine = (k * traits::HALF_PI_REST + (int64_t(1) << 30)) >> 31;
+        const Rep r = static_cast<Rep>(static_cast<int64_t>(coarse) - fine);
+
+        const Rep r2 = traits::multiply(r, r);
+        Rep s = SIN[traits::SIN_TERMS - 1];
+        for (int i = traits::SIN_TERMS - 2; i >= 0; --i)
+            s = static_cast<Rep>(SIN[i] + traits::multiply(r2, s));
+        s = static_cast<Rep>(r + traits::multiply(r, traits::multiply(r2, s)));
+
+        Rep c = COS[traits::COS_TERMS - 1];
+        for (int i = traits::COS_TERMS - 2; i >= 0; --i)
+            c = static_cast<Rep>(COS[i] + traits::multiply(r2, c));
+        c = static_cast<Rep>(one + traits::multiply(r2, c));
+
+        switch (k & 3) {
+        case 0:
+            sine = s;
+            cosine = c;
+            break;
+        case 1:
+            sine = c;
+            cosine = static_cast<Rep>(-s);
+            break;
+        case 2:
+            sine = static_cast<Rep>(-s);
+            cosine = static_cast<Rep>(-c);
+            break;
+        default:
+            sine = static_cast<Rep>(-c);
+            cosine = s;
+            break;
+        }
+    }
+
+    /**
+     * Euclidean length of n fixed-point components. Squares are summed in 64 bits
+     * after shifting out low bits of very long vectors, so nothing overflows.
+     */
+    template <typename Rep>
+    inline Rep fixedLength(const Rep* components, int n)
+    {
+        uint64_t largest = 0;
+        for (int i = 0; i < n; ++i)
+            largest = std::max(largest, magnitudeOf(components[i]));
+
+        int shift = 0;
+        while ((largest >> shift) >= (uint64_t(1) << 31))
+            ++shift;
+
+        uint64_t sum = 0;
+        for (int i = 0; i < n; ++i) {
+            const uint64_t c = magnitudeOf(components[i]) >> shift;
+            sum += c * c;
+        }
+
+        return static_cast<Rep>(isqrt(sum, 32, 0) << shift);
+    }
+} // namespace detail
+
+/**
+ * Fixed-point number with half of the bits of Rep after the binary point.
+ *
+ * Every operation is integer arithmetic with a fixed rounding, so results are
+ * bit-identical across compilers and machines, as lockstep simulation needs.
+ * Results outside the range wrap like the underlying integers.
+ */
+template <typename Rep>
+struct fixedPoint {
+    using traits = detail::fixedTraits<Rep>;
+
+    Rep raw { 0 };
+
+    fixedPoint() = default;
+
+    fixedPoint(int value)
+        : raw(static_cast<Rep>(static_cast<int64_t>(value) * (int64_t(1) << traits::BITS)))
+    { }
+
+    static fixedPoint fromRaw(Rep value)
+    {
+        fixedPoint result;
+        result.raw = value;
+        return result;
+    }
+
+    /**
+     * Rounds to the nearest representable value. Only use on constants and input
+     * that is the same on every machine.
+     */
+    static fixedPoint fromDouble(double value)
+    {
+        return fromRaw(detail::fixedConstant<Rep>(value));
+    }
+
+    static fixedPoint fromFloat(float value)
+    {
+        return fromDouble(static_cast<double>(value));
+    }
+
+    double toDouble() const
+    {
+        return static_cast<double>(raw) / static_cast<double>(int64_t(1) << traits::BITS);
+    }
+
+    float toFloat() const
+    {
+        return static_cast<float>(toDouble());
+    }
+
+    fixedPoint& operator+=(fixedPoint value)
+    {
+        raw = detail::wrappingAdd(raw, value.raw);
+        return *this;
+    }
+
+    fixedPoint& operator-=(fixedPoint value)
+    {
+        raw = detail::wrappingSubtract(raw, value.raw);
+        return *this;
+    }
+
+    fixedPoint& operator*=(fixedPoint value)
+    {
+        raw = traits::multiply(raw, value.raw);
+        return *this;
+    }
+
+    fixedPoint& operator/=(fixedPoint value)
+    {
+        raw = traits::divide(raw, value.raw);
+        return *this;
+    }
+
+    friend fixedPoint operator+(fixedPoint a, fixedPoint b) { return fromRaw(detail::wrappingAdd(a.raw, b.raw)); }
+    friend fixedPoint operator-(fixedPoint a, fixedPoint b) { return fromRaw(detail::wrappingSubtract(a.raw, b.raw)); }
+    friend fixedPoint operator-(fixedPoint a) { return fromRaw(detail::wrappingNegate(a.raw)); }
+    friend fixedPoint operator*(fixedPoint a, fixedPoint b) { return fromRaw(traits::multiply(a.raw, b.raw)); }
+    friend fixedPoint operator/(fixedPoint a, fixedPoint b) { return fromRaw(traits::divide(a.raw, b.raw)); }
+
+    friend bool operator==(fixedPoint a, fixedPoint b) { return a.raw == b.raw; }
+    friend bool operator!=(fixedPoint a, fixedPoint b) { return a.raw != b.raw; }
+    friend bool operator<(fixedPoint a, fixedPoint b) { return a.raw < b.raw; }
+    friend bool operator<=(fixedPoint a, fixedPoint b) { return a.raw <= b.raw; }
+    friend bool operator>(fixedPoint a, fixedPoint b) { return a.raw > b.raw; }
+    friend bool operator>=(fixedPoint a, fixedPoint b) { return a.raw >= b.raw; }
+
+    friend fixedPoint abs(fixedPoint a) { return a.raw < 0 ? -a : a; }
+
+    /**
+     * Rounded down to the fixed-point grid; zero for negative input.
+     */
+    friend fixedPoint sqrt(fixedPoint a) { return fromRaw(traits::sqrt(a.raw)); }
+
+    /**
+     * @param angle Angle in radians
+     */
+    friend fixedPoint sin(fixedPoint angle)
+    {
+        Rep s, c;
+        detail::fixedSinCos(angle.raw, s, c);
+        return fromRaw(s);
+    }
+
+    /**
+     * @param angle Angle in radians
+     */
+    friend fixedPoint cos(fixedPoint angle)
+    {
+        Rep s, c;
+        detail::fixedSinCos(angle.raw, s, c);
+        return fromRaw(c);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, fixedPoint value)
+    {
+        stream << value.toDouble();
+        return stream;
+    }
+};
+
+using fixed32 = fixedPoint<int32_t>; // Q16.16
+using fixed64 = fixedPoint<int64_t>; // Q32.32
+
+template <typename T>
+struct fixedVec2 {
+    T x;
+    T y;
+
+    fixedVec2() = default;
+
+    fixedVec2(T xx, T yy)
+        : x(xx)
+        , y(yy)
+    { }
+
+    static fixedVec2 fromFloat(const vec2& v)
+    {
+        return fixedVec2(T::fromFloat(v.x), T::fromFloat(v.y));
+    }
+
+    vec2 toFloat() const
+    {
+        return vec2(x.toFloat(), y.toFloat());
+    }
+
+    T& operator[](int index)
+    {
+        return ((&x)[index]);
+    }
+
+    const T& operator[](int index) const
+    {
+        return ((&x)[index]);
+    }
+};
+
+template <typename T>
+struct fixedVec3 {
+    T x;
+    T y;
+    T z;
+
+    fixedVec3() = default;
+
+    fixedVec3(T xx, T yy, T zz)
+        : x(xx)
+        , y(yy)
+        , z(zz)
+    { }
+
+    static fixedVec3 fromFloat(const vec3& v)
+    {
+        return fixedVec3(T::fromFloat(v.x), T::fromFloat(v.y), T::fromFloat(v.z));
+    }
+
+    vec3 toFloat() const
+    {
+        return vec3(x.toFloat(), y.toFloat(), z.toFloat());
+    }
+
+    T& operator[](int index)
+    {
+        return ((&x)[index]);
+    }
+
+    const T& operator[](int index) const
+    {
+        return ((&x)[index]);
+    }
+};
+
+template <typename T>
+struct fixedVec4 {
+    T x;
+    T y;
+    T z;
+    T w;
+
+    fixedVec4() = default;
+
+    fixedVec4(T xx, T yy, T zz, T ww)
+        : x(xx)
+        , y(yy)
+        , z(zz)
+        , w(ww)
+    { }
+
+    fixedVec4(const fixedVec3<T>& v, T ww)
+        : x(v.x)
+        , y(v.y)
+        , z(v.z)
+        , w(ww)
+    { }
+
+    static fixedVec4 fromFloat(const vec4& v)
+    {
+        return fixedVec4(T::fromFloat(v.x), T::fromFloat(v.y), T::fromFloat(v.z), T::fromFloat(v.w));
+    }
+
+    vec4 toFloat() const
+    {
+        return vec4(x.toFloat(), y.toFloat(), z.toFloat(), w.toFloat());
+    }
+
+    T& operator[](int index)
+    {
+        return ((&x)[index]);
+    }
+
+    const T& operator[](int index) const
+    {
+        return ((&x)[index]);
+    }
+};
+
+using vec2q16 = fixedVec2<fixed32>;
+using vec3q16 = fixedVec3<fixed32>;
+using vec4q16 = fixedVec4<fixed32>;
+using vec2q32 = fixedVec2<fixed64>;
+using vec3q32 = fixedVec3<fixed64>;
+using vec4q32 = fixedVec4<fixed64>;
+
+template <typename T>
+inline fixedVec2<T> operator+(const fixedVec2<T>& a, const fixedVec2<T>& b)
+{
+    return fixedVec2<T>(a.x + b.x, a.y + b.y);
+}
+
+template <typename T>
+inline fixedVec2<T> operator-(const fixedVec2<T>& a, const fixedVec2<T>& b)
+{
+    return fixedVec2<T>(a.x - b.x, a.y - b.y);
+}
+
+template <typename T>
+inline fixedVec2<T> operator-(const fixedVec2<T>& v)
+{
+    return fixedVec2<T>(-v.x, -v.y);
+}
+
+template <typename T>
+inline fixedVec2<T> operator*(const fixedVec2<T>& v, T scalar)
+{
+    return fixedVec2<T>(v.x * scalar, v.y * scalar);
+}
+
+template <typename T>
+inline fixedVec2<T> operator/(const fixedVec2<T>& v, T scalar)
+{
+    return fixedVec2<T>(v.x / scalar, v.y / scalar);
+}
+
+template <typename T>
+inline bool operator==(const fixedVec2<T>& a, const fixedVec2<T>& b)
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+template <typename T>
+inline fixedVec3<T> operator+(const fixedVec3<T>& a, const fixedVec3<T>& b)
+{
+    return fixedVec3<T>(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+template <typename T>
+inline fixedVec3<T> operator-(const fixedVec3<T>& a, const fixedVec3<T>& b)
+{
+    return fixedVec3<T>(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+template <typename T>
+inline fixedVec3<T> operator-(const fixedVec3<T>& v)
+{
+    return fixedVec3<T>(-v.x, -v.y, -v.z);
+}
+
+template <typename T>
+inline fixedVec3<T> operator*(const fixedVec3<T>& v, T scalar)
+{
+    return fixedVec3<T>(v.x * scalar, v.y * scalar, v.z * scalar);
+}
+
+template <typename T>
+inline fixedVec3<T> operator/(const fixedVec3<T>& v, T scalar)
+{
+    return fixedVec3<T>(v.x / scalar, v.y / scalar, v.z / scalar);
+}
+
+template <typename T>
+inline bool operator==(const fixedVec3<T>& a, const fixedVec3<T>& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+template <typename T>
+inline fixedVec4<T> operator+(const fixedVec4<T>& a, const fixedVec4<T>& b)
+{
+    return fixedVec4<T>(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+}
+
+template <typename T>
+inline fixedVec4<T> operator-(const fixedVec4<T>& a, const fixedVec4<T>& b)
+{
+    return fixedVec4<T>(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+}
+
+template <typename T>
+inline fixedVec4<T> operator-(const fixedVec4<T>& v)
+{
+    return fixedVec4<T>(-v.x, -v.y, -v.z, -v.w);
+}
+
+template <typename T>
+inline fixedVec4<T> operator*(const fixedVec4<T>& v, T scalar)
+{
+    return fixedVec4<T>(v.x * scalar, v.y * scalar, v.z * scalar, v.w * scalar);
+}
+
+template <typename T>
+inline fixedVec4<T> operator/(const fixedVec4<T>& v, T scalar)
+{
+    return fixedVec4<T>(v.x / scalar, v.y / scalar, v.z / scalar, v.w / scalar);
+}
+
+template <typename T>
+inline bool operator==(const fixedVec4<T>& a, const fixedVec4<T>& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+
+template <typename T>
+inline std::ostream& operator<<(std::ostream& stream, const fixedVec3<T>& v)
+{
+    stream << "fixedVec3(" << v.x << ", " << v.y << ", " << v.z << ")";
+
+    return stream;
+}
+
+template <typename T>
+inline T dot(const fixedVec2<T>& a, const fixedVec2<T>& b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+template <typename T>
+inline T dot(const fixedVec3<T>& a, const fixedVec3<T>& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+template <typename T>
+inline T dot(const fixedVec4<T>& a, const fixedVec4<T>& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+template <typename T>
+inline fixedVec3<T> cross(const fixedVec3<T>& a, const fixedVec3<T>& b)
+{
+    return fixedVec3<T>(a.y * b.z - a.z * b.y,
+                        a.z * b.x - a.x * b.z,
+                        a.x * b.y - a.y * b.x);
+}
+
+/**
+ * Unlike sqrt(dot(v, v)), does not overflow for vectors longer than the square
+ * root of the range.
+ */
+template <typename T>
+inline T magnitude(const fixedVec2<T>& v)
+{
+    return T::fromRaw(detail::fixedLength(&v.x.raw, 2));
+}
+
+template <typename T>
+inline T magnitude(const fixedVec3<T>& v)
+{
+    return T::fromRaw(detail::fixedLength(&v.x.raw, 3));
+}
+
+template <typename T>
+inline T magnitude(const fixedVec4<T>& v)
+{
+    return T::fromRaw(detail::fixedLength(&v.x.raw, 4));
+}
+
+/**
+ * Returns zero vectors unchanged.
+ */
+template <typename T>
+inline fixedVec2<T> normalize(const fixedVec2<T>& v)
+{
+    const T length = magnitude(v);
+    return length.raw == 0 ? v : v / length;
+}
+
+template <typename T>
+inline fixedVec3<T> normalize(const fixedVec3<T>& v)
+{
+    const T length = magnitude(v);
+    return length.raw == 0 ? v : v / length;
+}
+
+template <typename T>
+inline fixedVec4<T> normalize(const fixedVec4<T>& v)
+{
+    const T length = magnitude(v);
+    return length.raw == 0 ? v : v / length;
+}
+
+template <typename T>
+struct fixedQuaternion {
+    T x;
+    T y;
+    T z;
+    T w { 1 };
+
+    fixedQuaternion() = default;
+
+    fixedQuaternion(T xx, T yy, T zz, T s)
+        : x(xx)
+        , y(yy)
+        , z(zz)
+        , w(s)
+    { }
+
+    fixedQuaternion(const fixedVec3<T>& v, T s)
+        : x(v.x)
+        , y(v.y)
+        , z(v.z)
+        , w(s)
+    { }
+
+    static fixedQuaternion fromFloat(const quaternion& q)
+    {
+        return fixedQuaternion(T::fromFloat(q.x), T::fromFloat(q.y), T::fromFloat(q.z), T::fromFloat(q.w));
+    }
+
+    quaternion toFloat() const
+    {
+        return quaternion(x.toFloat(), y.toFloat(), z.toFloat(), w.toFloat());
+    }
+
+    fixedVec3<T> GetVectorPart() const
+    {
+        return fixedVec3<T>(x, y, z);
+    }
+};
+
+using quaternionq16 = fixedQuaternion<fixed32>;
+using quaternionq32 = fixedQuaternion<fixed64>;
+
+template <typename T>
+inline fixedQuaternion<T> operator+(const fixedQuaternion<T>& q1, const fixedQuaternion<T>& q2)
+{
+    return fixedQuaternion<T>(q1.x + q2.x, q1.y + q2.y, q1.z + q2.z, q1.w + q2.w);
+}
+
+template <typename T>
+inline fixedQuaternion<T> operator-(const fixedQuaternion<T>& q1, const fixedQuaternion<T>& q2)
+{
+    return fixedQuaternion<T>(q1.x - q2.x, q1.y - q2.y, q1.z - q2.z, q1.w - q2.w);
+}
+
+template <typename T>
+inline fixedQuaternion<T> operator*(const fixedQuaternion<T>& q1, const fixedQuaternion<T>& q2)
+{
+    return fixedQuaternion<T>(q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y,
+                              q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x,
+                              q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w,
+                              q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z);
+}
+
+template <typename T>
+inline fixedQuaternion<T> operator*(const fixedQuaternion<T>& q, T scalar)
+{
+    return fixedQuaternion<T>(q.x * scalar, q.y * scalar, q.z * scalar, q.w * scalar);
+}
+
+template <typename T>
+inline fixedQuaternion<T> Conjugate(const fixedQuaternion<T>& q)
+{
+    return fixedQuaternion<T>(-q.x, -q.y, -q.z, q.w);
+}
+
+template <typename T>
+inline T dot(const fixedQuaternion<T>& q1, const fixedQuaternion<T>& q2)
+{
+    return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+}
+
+template <typename T>
+inline fixedQuaternion<T> normalize(const fixedQuaternion<T>& q)
+{
+    const fixedVec4<T> n = normalize(fixedVec4<T>(q.x, q.y, q.z, q.w));
+    return fixedQuaternion<T>(n.x, n.y, n.z, n.w);
+}
+
+template <typename T>
+inline fixedVec3<T> rotate(const fixedVec3<T>& v, const fixedQuaternion<T>& q)
+{
+    const fixedVec3<T> b = q.GetVectorPart();
+    const T b2 = dot(b, b);
+    return v * (q.w * q.w - b2) + b * (dot(v, b) * T(2)) + cross(b, v) * (q.w * T(2));
+}
+
+/**
+ * @param axis Unit rotation axis
+ * @param angle Angle in radians
+ */
+template <typename T>
+inline fixedQuaternion<T> axisAngle(const fixedVec3<T>& axis, T angle)
+{
+    const T halfAngle = angle / T(2);
+    return fixedQuaternion<T>(axis * sin(halfAngle), cos(halfAngle));
+}
+
+/**
+ * Row-vector 4x4 matrix over a fixed-point type, laid out like mat4.
+ */
+template <typename T>
+struct fixedMat4 {
+    T m[4][4];
+
+    /**
+     * Constructs an identity matrix.
+     */
+    fixedMat4()
+    {
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j)
+                m[i][j] = T(i == j ? 1 : 0);
+        }
+    }
+
+    static fixedMat4 fromFloat(const mat4& mat)
+    {
+        fixedMat4 result;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j)
+                result.m[i][j] = T::fromFloat(mat(i, j));
+        }
+
+        return result;
+    }
+
+    mat4 toFloat() const
+    {
+        mat4 result;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j)
+                result(i, j) = m[i][j].toFloat();
+        }
+
+        return result;
+    }
+
+    T& operator()(int i, int j)
+    {
+        return m[i][j];
+    }
+
+    const T& operator()(int i, int j) const
+    {
+        return m[i][j];
+    }
+};
+
+using mat4q16 = fixedMat4<fixed32>;
+using mat4q32 = fixedMat4<fixed64>;
+
+template <typename T>
+inline fixedMat4<T> operator*(const fixedMat4<T>& mat1, const fixedMat4<T>& mat2)
+{
+    fixedMat4<T> result;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            T sum = mat1(row, 0) * mat2(0, col);
+            for (int i = 1; i < 4; ++i)
+                sum += mat1(row, i) * mat2(i, col);
+            result(row, col) = sum;
+        }
+    }
+
+    return result;
+}
+
+// row-order multiplication
+template <typename T>
+inline fixedVec4<T> operator*(const fixedVec4<T>& vec, const fixedMat4<T>& mat)
+{
+    return fixedVec4<T>(mat(0, 0) * vec.x + mat(1, 0) * vec.y + mat(2, 0) * vec.z + mat(3, 0) * vec.w,
+                        mat(0, 1) * vec.x + mat(1, 1) * vec.y + mat(2, 1) * vec.z + mat(3, 1) * vec.w,
+                        mat(0, 2) * vec.x + mat(1, 2) * vec.y + mat(2, 2) * vec.z + mat(3, 2) * vec.w,
+                        mat(0, 3) * vec.x + mat(1, 3) * vec.y + mat(2, 3) * vec.z + mat(3, 3) * vec.w);
+}
+
+template <typename T>
+inline fixedMat4<T> translation(const fixedVec3<T>& t)
+{
+    fixedMat4<T> result;
+    result(3, 0) = t.x;
+    result(3, 1) = t.y;
+    result(3, 2) = t.z;
+
+    return result;
+}
+
+/**
+ * The matrix of quaternion::getRotationMatrix for a fixed-point quaternion.
+ */
+template <typename T>
+inline fixedMat4<T> rotationMatrix(const fixedQuaternion<T>& q)
+{
+    const T one(1), two(2);
+    fixedMat4<T> result;
+    result(0, 0) = one - two * (q.y * q.y + q.z * q.z);
+    result(0, 1) = two * (q.x * q.y - q.w * q.z);
+    result(0, 2) = two * (q.x * q.z + q.w * q.y);
+    result(1, 0) = two * (q.x * q.y + q.w * q.z);
+    result(1, 1) = one - two * (q.x * q.x + q.z * q.z);
+    result(1, 2) = two * (q.y * q.z - q.w * q.x);
+    result(2, 0) = two * (q.x * q.z - q.w * q.y);
+    result(2, 1) = two * (q.y * q.z + q.w * q.x);
+    result(2, 2) = one - two * (q.x * q.x + q.y * q.y);
+
+    return result;
+}
+
+/**
+ * Batch operations over arrays, giving the same bits as the scalar functions.
+ */
+template <typename T>
+inline void sinCos(const T* angles, T* sines, T* cosines, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        detail::fixedSinCos(angles[i].raw, sines[i].raw, cosines[i].raw);
+}
+
+template <typename T>
+inline void normalize(const fixedVec3<T>* in, fixedVec3<T>* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = normalize(in[i]);
+}
+
+template <typename T>
+inline void rotate(const fixedVec3<T>* in, fixedVec3<T>* out, std::size_t count, const fixedQuaternion<T>& q)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = rotate(in[i], q);
+}
+
+/**
+ * Transforms points as row vectors with w = 1.
+ */
+template <typename T>
+inline void transformPoints(const fixedMat4<T>& mat, const fixedVec3<T>* in, fixedVec3<T>* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const fixedVec3<T> p = in[i];
+        out[i] = fixedVec3<T>(mat(0, 0) * p.x + mat(1, 0) * p.y + mat(2, 0) * p.z + mat(3, 0),
+                              mat(0, 1) * p.x + mat(1, 1) * p.y + mat(2, 1) * p.z + mat(3, 1),
+                              mat(0, 2) * p.x + mat(1, 2) * p.y + mat(2, 2) * p.z + mat(3, 2));
+    }
+}
+
+/**
+ * positions[i] += velocities[i] * dt, the inner loop of a lockstep tick.
+ */
+template <typename T>
+inline void integrate(fixedVec3<T>* positions, const fixedVec3<T>* velocities, T dt, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        positions[i] = positions[i] + velocities[i] * dt;
+}
+} // namespace lia
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "mathbase.h"
+#include "mat4.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "vec4.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+
+namespace lia {
+/**
+ * Precision for the shortest text that parses back to the same float.
+ */
+constexpr int FORMAT_SHORTEST = -1;
+
+/**
+ * Writes value at cursor with precision significant digits, as %g does, or
+ * the shortest round-trip text for FORMAT_SHORTEST. Uses std::to_chars where
+ * the library has it; the snprintf fallback writes 9 digits for shortest.
+ * Infinities and NaN are written as inf, -inf and nan, which parse reads
+ * back; a NaN's sign and payload are not kept.
+ *
+ * @return False when [cursor, end) is too small, leaving cursor where it was
+ */
+inline bool formatFloat(char*& cursor, char* end, float value, int precision = FORMAT_SHORTEST)
+{
+#if defined(__cpp_lib_to_chars)
+    const std::to_chars_result result = precision < 0 ? std::to_chars(cursor, end, value)
+                                                      : std::to_chars(cursor, end, value, std::chars_format::general, precision);
+    if (result.ec != std::errc())
+        return false;
+
+    cursor = result.ptr;
+    return true;
+#else
+    char buffer[64];
+    const int length = std::snprintf(buffer, sizeof(buffer), "%.*g", precision < 0 ? 9 : precision, static_cast<double>(value));
+    if (length < 0 || length >= static_cast<int>(sizeof(buffer)) || length > end - cursor)
+        return false;
+
+    std::memcpy(cursor, buffer, static_cast<std::size_t>(length));
+    cursor += length;
+    return true;
+#endif
+}
+
+/**
+ * Writes n floats separated by separator, without a line end.
+ */
+inline bool formatFloats(char*& cursor, char* end, const float* values, std::size_t n, int precision = FORMAT_SHORTEST, char separator = ' ')
+{
+    char* p = cursor;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i > 0) {
+            if (p == end)
+                return false;
+            *p++ = separator;
+        }
+
+        if (!formatFloat(p, end, values[i], precision))
+            return false;
+    }
+
+    cursor = p;
+    return true;
+}
+
+inline bool format(char*& cursor, char* end, const vec2& v, int precision = FORMAT_SHORTEST, char separator = ' ')
+{
+    return formatFloats(cursor, end, &v.x, 2, precision, separator);
+}
+
+inline bool format(char*& cursor, char* end, const vec3& v, int precision = FORMAT_SHORTEST, char separator = ' ')
+{
+    return formatFloats(cursor, end, &v.x, 3, precision, separator);
+}
+
+inline bool format(char*& cursor, char* end, const vec4& v, int precision = FORMAT_SHORTEST, char separator = ' ')
+{
+    return formatFloats(cursor, end, &v.x, 4, precision, separator);
+}
+
+/**
+ * Sixteen values, row by row, as parse reads them.
+ */
+inline bool format(char*& cursor, char* end, const mat4& m, int precision = FORMAT_SHORTEST, char separator = ' ')
+{
+    float values[16];
+    for (int i = 0; i < 16; ++i)
+        values[i] = m(i / 4, i % 4);
+
+    return formatFloats(cursor, end, values, 16, precision, separator);
+}
+
+/**
+ * Writes count values one per line, e.g. with ',' for CSV rows.
+ *
+ * @return The number of complete lines written; cursor ends after the last
+ */
+template <typename T>
+inline std::size_t format(char*& cursor, char* end, const T* values, std::size_t count, int precision = FORMAT_SHORTEST,
+                          char separator = ' ')
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        char* p = cursor;
+        if (!format(p, end, values[i], precision, separator) || p == end)
+            return i;
+
+        *p++ = '\n';
+        cursor = p;
+    }
+
+    return count;
+}
+
+/**
+ * An upper bound on the text of one float, for sizing buffers: sign, digits,
+ * point and exponent.
+ */
+inline std::size_t formattedFloatSize(int precision = FORMAT_SHORTEST)
+{
+    return static_cast<std::size_t>(precision < 0 ? 9 : precision) + 8;
+}
+} // namespace lia
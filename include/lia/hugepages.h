@@ -0,0 +1,220 @@
+#pragma once
+
+#include "mathbase.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+namespace lia {
+constexpr std::size_t HUGE_PAGE_SIZE = std::size_t(2) << 20;
+
+enum class pageMode {
+    normal, // 4 KB pages
+    transparentHuge, // 2 MB aligned and advised with MADV_HUGEPAGE; the kernel backs what it can with huge pages
+    explicitHuge, // MAP_HUGETLB, from the pages reserved in /proc/sys/vm/nr_hugepages
+};
+
+namespace detail {
+    inline std::size_t hugePageRound(std::size_t size)
+    {
+        return (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+} // namespace detail
+
+/**
+ * Reserves size bytes aligned to HUGE_PAGE_SIZE without touching them, so
+ * pages are placed on the NUMA node of the thread that first writes them.
+ * Modes the system cannot give fall back, explicit to transparent to
+ * normal pages.
+ *
+ * @param obtained Receives the mode actually used
+ * @return Null when out of memory
+ */
+inline void* allocatePages(std::size_t size, pageMode mode = pageMode::transparentHuge, pageMode* obtained = nullptr)
+{
+    const std::size_t rounded = detail::hugePageRound(size == 0 ? 1 : size);
+#if defined(__unix__) || defined(__APPLE__)
+#if defined(MAP_HUGETLB)
+    if (mode == pageMode::explicitHuge) {
+        void* data = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (data != MAP_FAILED) {
+            if (obtained)
+                *obtained = pageMode::explicitHuge;
+            return data;
+        }
+    }
+#endif
+
+    // over-reserve by a page and trim, for an aligned start
+    uint8_t* reserved = static_cast<uint8_t*>(mmap(nullptr, rounded + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (reserved == MAP_FAILED)
+        return nullptr;
+
+    uint8_t* data = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(reserved) + HUGE_PAGE_SIZE - 1) & ~uintptr_t(HUGE_PAGE_SIZE - 1));
+    const std::size_t head = static_cast<std::size_t>(data - reserved);
+    if (head > 0)
+        munmap(reserved, head);
+    munmap(data + rounded, HUGE_PAGE_SIZE - head);
+
+    pageMode used = pageMode::normal;
+#if defined(MADV_HUGEPAGE)
+    if (mode != pageMode::normal && madvise(data, rounded, MADV_HUGEPAGE) == 0)
+        used = pageMode::transparentHuge;
+#endif
+    if (obtained)
+        *obtained = used;
+
+    return data;
+#else
+    // the allocation keeps its start just before the aligned pointer
+    uint8_t* allocation = static_cast<uint8_t*>(::operator new(rounded + HUGE_PAGE_SIZE, std::nothrow));
+    if (!allocation)
+        return nullptr;
+
+    uint8_t* data = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(allocation) + HUGE_PAGE_SIZE) & ~uintptr_t(HUGE_PAGE_SIZE - 1));
+    reinterpret_cast<uint8_t**>(data)[-1] = allocation;
+    (void)mode;
+    if (obtained)
+        *obtained = pageMode::normal;
+
+    return data;
+#endif
+}
+
+/**
+ * Frees an allocatePages block of the same size.
+ */
+inline void freePages(void* data, std::size_t size)
+{
+    if (!data)
+        return;
+#if defined(__unix__) || defined(__APPLE__)
+    munmap(data, detail::hugePageRound(size == 0 ? 1 : size));
+#else
+    (void)size;
+    ::operator delete(static_cast<uint8_t**>(data)[-1]);
+#endif
+}
+
+/**
+ * Elements [first, last) of an array.
+ */
+struct indexRange {
+    std::size_t first { 0 };
+    std::size_t last { 0 };
+
+    std::size_t size() const
+    {
+        return last - first;
+    }
+};
+
+/**
+ * The part of count elements that worker part of parts owns. Parts are
+ * contiguous and split at huge page boundaries, so a worker that first
+ * touches its part and later processes the same part works on pages local
+ * to its NUMA node, sharing at most one element's page with a neighbour.
+ */
+inline indexRange partitionRange(std::size_t count, std::size_t parts, std::size_t part, std::size_t elementSize)
+{
+    const auto boundary = [&](std::size_t p) -> std::size_t {
+        if (p == 0)
+            return 0;
+        if (p >= parts)
+            return count;
+
+        const std::size_t bytes = static_cast<std::size_t>(static_cast<double>(count) * elementSize * p / parts);
+        const std::size_t aligned = bytes / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        const std::size_t element = (aligned + elementSize - 1) / elementSize;
+        return element < count ? element : count;
+    };
+
+    return indexRange { boundary(part), boundary(part + 1) };
+}
+
+/**
+ * Value-initializes a range. Called by each worker on its own partition
+ * before anything else writes it, it places the pages on that worker's node.
+ */
+template <typename T>
+inline void firstTouch(T* data, const indexRange& range)
+{
+    for (std::size_t i = range.first; i < range.last; ++i)
+        new (data + i) T();
+}
+
+/**
+ * An array of trivially destructible elements in huge pages, left
+ * untouched for first-touch placement: initialize with firstTouch, from the
+ * workers that will use each partition.
+ */
+template <typename T>
+struct largeArray {
+    static_assert(std::is_trivially_destructible<T>::value, "largeArray does not run destructors");
+
+    largeArray() = default;
+
+    explicit largeArray(std::size_t count, pageMode mode = pageMode::transparentHuge)
+    {
+        allocate(count, mode);
+    }
+
+    largeArray(const largeArray&) = delete;
+    largeArray& operator=(const largeArray&) = delete;
+
+    largeArray(largeArray&& other)
+    {
+        *this = std::move(other);
+    }
+
+    largeArray& operator=(largeArray&& other)
+    {
+        std::swap(elements, other.elements);
+        std::swap(count, other.count);
+        std::swap(obtained, other.obtained);
+        return *this;
+    }
+
+    ~largeArray()
+    {
+        freePages(elements, count * sizeof(T));
+    }
+
+    /**
+     * @return False when out of memory, leaving the array empty
+     */
+    bool allocate(std::size_t n, pageMode mode = pageMode::transparentHuge)
+    {
+        freePages(elements, count * sizeof(T));
+        elements = static_cast<T*>(allocatePages(n * sizeof(T), mode, &obtained));
+        count = elements ? n : 0;
+
+        return elements != nullptr;
+    }
+
+    T* data() { return elements; }
+    const T* data() const { return elements; }
+    std::size_t size() const { return count; }
+    pageMode mode() const { return obtained; }
+
+    T& operator[](std::size_t index) { return elements[index]; }
+    const T& operator[](std::size_t index) const { return elements[index]; }
+
+    indexRange partition(std::size_t parts, std::size_t part) const
+    {
+        return partitionRange(count, parts, part, sizeof(T));
+    }
+
+private:
+    T* elements { nullptr };
+    std::size_t count { 0 };
+    pageMode obtained { pageMode::normal };
+};
+} // namespace lia
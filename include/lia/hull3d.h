@@ -0,0 +1,491 @@
+#pragma once
+
+#include "mathbase.h"
+#include "predicates.h"
+#include "vec3.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace lia {
+/**
+ * A closed convex triangle mesh in half-edge form.
+ *
+ * Face f is made of half-edges 3f, 3f + 1 and 3f + 2, counter-clockwise seen
+ * from outside; triangles[e] is the hull vertex half-edge e starts at and
+ * halfedges[e] its twin on the neighbouring face, as in delaunayTriangulation.
+ */
+struct convexHull {
+    std::vector<vec3> vertices;
+    std::vector<uint32_t> pointIndices; // the input point of each hull vertex
+    std::vector<uint32_t> triangles;
+    std::vector<uint32_t> halfedges;
+
+    std::size_t faceCount() const
+    {
+        return triangles.size() / 3;
+    }
+
+    void clear()
+    {
+        vertices.clear();
+        pointIndices.clear();
+        triangles.clear();
+        halfedges.clear();
+    }
+};
+
+namespace detail {
+    constexpr uint32_t HULL_NONE = 0xFFFFFFFFu;
+
+    // bounds the rounding error of a plane test on float input, relative to its
+    // absolute terms; about 7 units of 2^-53 with a wide margin
+    constexpr double HULL_FILTER_ERROR = 1e-14;
+
+    // indices of the points with the smallest and largest x, y and z, as min x, max x, min y, ...
+    inline void extremePoints(const vec3* points, std::size_t count, uint32_t (&indices)[6])
+    {
+        float lower[3] = { points[0].x, points[0].y, points[0].z };
+        float upper[3] = { points[0].x, points[0].y, points[0].z };
+        for (uint32_t& index : indices)
+            index = 0;
+
+        for (std::size_t i = 1; i < count; ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                const float value = points[i][axis];
+                if (value < lower[axis]) {
+                    lower[axis] = value;
+                    indices[2 * axis] = static_cast<uint32_t>(i);
+                }
+                if (value > upper[axis]) {
+                    upper[axis] = value;
+                    indices[2 * axis + 1] = static_cast<uint32_t>(i);
+                }
+            }
+        }
+    }
+} // namespace detail
+
+/**
+ * 3D convex hulls by quickhull.
+ *
+ * Whether a point is above a face is decided by the exact orient3d, so every
+ * edge of the hull is convex and every input point is on or inside it, even
+ * for nearly coplanar input. Coplanar regions stay triangulated, and may
+ * contain thin triangles. Keep one quickhull object per thread and
+ * reuse it: faces and conflict lists keep their storage between calls, so a
+ * warmed-up object does not allocate for hulls of similar size.
+ */
+struct quickhull {
+    /**
+     * Computes the hull of count points.
+     *
+     * @param maxVertices When nonzero, stop once the hull has this many vertices.
+     * Points are then added farthest first, giving the best inner approximation
+     * for the budget, as physics engines want for collision shapes. Budgets of
+     * 1 to 3 are raised to 4, so they return the initial tetrahedron.
+     * @return False for fewer than four points or input flat within a relative
+     * tolerance, leaving hull empty
+     */
+    bool compute(const vec3* points, std::size_t count, convexHull& hull, std::size_t maxVertices = 0)
+    {
+        hull.clear();
+        if (count < 4)
+            return false;
+
+        faces.clear();
+        freeFaces.clear();
+        pending.clear();
+
+        float extent = 0.0f;
+        uint32_t extremes[6];
+        detail::extremePoints(points, count, extremes);
+        for (int axis = 0; axis < 3; ++axis)
+            extent += std::max(std::abs(points[extremes[2 * axis]][axis]), std::abs(points[extremes[2 * axis + 1]][axis]));
+        tolerance = 3.0f * FLT_EPSILON * extent;
+
+        uint32_t simplex[4];
+        if (!initialSimplex(points, count, extremes, simplex))
+            return false;
+
+        // a closed hull needs a tetrahedron, so smaller budgets stop at it
+        std::size_t vertexCount = 4;
+        const bool budget = maxVertices != 0;
+        if (budget && vertexCount >= maxVertices)
+            return finish(points, count, hull);
+
+        for (;;) {
+            const uint32_t face = budget ? farthestConflictFace() : nextConflictFace();
+            if (face == detail::HULL_NONE)
+                break;
+
+            addPoint(points, face);
+            ++vertexCount;
+            if (budget && vertexCount >= maxVertices)
+                break;
+        }
+
+        return finish(points, count, hull);
+    }
+
+private:
+    struct face {
+        uint32_t v[3];
+        uint32_t neighbors[3]; // the face across edge v[i] -> v[i + 1]
+        double origin[3]; // v[0]
+        double normal[3]; // (v[1] - v[0]) x (v[2] - v[0]), not normalized
+        double bound[3]; // the normal's terms in absolute value, for the rounding error bound
+        double scale; // 1 / |normal|
+        bool alive;
+        uint32_t visited;
+        uint32_t farthest; // the conflict point farthest above the plane
+        double farthestDistance;
+        std::vector<uint32_t> conflicts;
+
+        double distance(const vec3& p) const
+        {
+            return (normal[0] * (p.x - origin[0]) + normal[1] * (p.y - origin[1]) + normal[2] * (p.z - origin[2])) * scale;
+        }
+    };
+
+    struct searchStep {
+        uint32_t face;
+        uint32_t edge;
+        uint32_t remaining;
+    };
+
+    struct horizonEdge {
+        uint32_t a, b;
+        uint32_t outside;
+        uint32_t outsideEdge;
+    };
+
+    std::vector<face> faces;
+    std::vector<uint32_t> freeFaces;
+    std::vector<uint32_t> pending;
+    std::vector<uint32_t> visible;
+    std::vector<horizonEdge> horizon;
+    std::vector<uint32_t> created;
+    std::vector<uint32_t> orphans;
+    std::vector<uint32_t> remap;
+    std::vector<searchStep> stack;
+    std::vector<uint32_t> vertexOf;
+    float tolerance { 0.0f };
+    uint32_t stamp { 0 };
+
+    uint32_t createFace(const vec3* points, uint32_t a, uint32_t b, uint32_t c)
+    {
+        uint32_t index;
+        if (!freeFaces.empty()) {
+            index = freeFaces.back();
+            freeFaces.pop_back();
+        } else {
+            index = static_cast<uint32_t>(faces.size());
+            faces.emplace_back();
+        }
+
+        face& f = faces[index];
+        f.v[0] = a;
+        f.v[1] = b;
+        f.v[2] = c;
+        f.neighbors[0] = f.neighbors[1] = f.neighbors[2] = detail::HULL_NONE;
+
+        f.origin[0] = points[a].x;
+        f.origin[1] = points[a].y;
+        f.origin[2] = points[a].z;
+        const double u[3] = { points[b].x - f.origin[0], points[b].y - f.origin[1], points[b].z - f.origin[2] };
+        const double w[3] = { points[c].x - f.origin[0], points[c].y - f.origin[1], points[c].z - f.origin[2] };
+        for (int i = 0; i < 3; ++i) {
+            const int j = (i + 1) % 3, k = (i + 2) % 3;
+            f.normal[i] = u[j] * w[k] - u[k] * w[j];
+            f.bound[i] = std::abs(u[j] * w[k]) + std::abs(u[k] * w[j]);
+        }
+        const double length = std::sqrt(f.normal[0] * f.normal[0] + f.normal[1] * f.normal[1] + f.normal[2] * f.normal[2]);
+        f.scale = length > 0.0 ? 1.0 / length : 0.0;
+
+        f.alive = true;
+        f.visited = 0;
+        f.farthest = detail::HULL_NONE;
+        f.farthestDistance = 0.0;
+        f.conflicts.clear();
+
+        return index;
+    }
+
+    // true when p is strictly above the face, exactly: the plane test in double
+    // decides unless p is within its rounding error of the plane
+    static bool above(const vec3* points, const face& f, const vec3& p)
+    {
+        const double d[3] = { p.x - f.origin[0], p.y - f.origin[1], p.z - f.origin[2] };
+        const double height = f.normal[0] * d[0] + f.normal[1] * d[1] + f.normal[2] * d[2];
+        const double error = detail::HULL_FILTER_ERROR * (f.bound[0] * std::abs(d[0]) + f.bound[1] * std::abs(d[1]) + f.bound[2] * std::abs(d[2]));
+        if (height > error)
+            return true;
+        if (height < -error)
+            return false;
+
+        return orient3d(points[f.v[0]], points[f.v[1]], points[f.v[2]], p) < 0.0;
+    }
+
+    // hands the point to the first face it is above, if any
+    template <typename Faces>
+    void assignConflict(const vec3* points, const Faces& candidates, uint32_t point)
+    {
+        for (uint32_t index : candidates) {
+            face& f = faces[index];
+            if (!above(points, f, points[point]))
+                continue;
+
+            f.conflicts.push_back(point);
+            const double distance = f.distance(points[point]);
+            if (f.farthest == detail::HULL_NONE || distance > f.farthestDistance) {
+                f.farthestDistance = distance;
+                f.farthest = point;
+            }
+            return;
+        }
+    }
+
+    bool initialSimplex(const vec3* points, std::size_t count, const uint32_t (&extremes)[6], uint32_t (&simplex)[4])
+    {
+        // the most distant pair of extreme points, then the farthest point from their line and from their plane
+        float best = 0.0f;
+        for (int i = 0; i < 6; ++i) {
+            for (int j = i + 1; j < 6; ++j) {
+                const vec3 d = points[extremes[j]] - points[extremes[i]];
+                if (dot(d, d) > best) {
+                    best = dot(d, d);
+                    simplex[0] = extremes[i];
+                    simplex[1] = extremes[j];
+                }
+            }
+        }
+        if (std::sqrt(best) <= tolerance)
+            return false;
+
+        const vec3 a = points[simplex[0]];
+        const vec3 axis = normalize(points[simplex[1]] - a);
+        best = 0.0f;
+        for (std::size_t i = 0; i < count; ++i) {
+            const vec3 d = points[i] - a;
+            const vec3 off = d - axis * dot(d, axis);
+            if (dot(off, off) > best) {
+                best = dot(off, off);
+                simplex[2] = static_cast<uint32_t>(i);
+            }
+        }
+        if (std::sqrt(best) <= tolerance)
+            return false;
+
+        const vec3 normal = normalize(cross(points[simplex[1]] - a, points[simplex[2]] - a));
+        best = 0.0f;
+        for (std::size_t i = 0; i < count; ++i) {
+            const float d = std::abs(dot(normal, points[i] - a));
+            if (d > best) {
+                best = d;
+                simplex[3] = static_cast<uint32_t>(i);
+            }
+        }
+        if (best <= tolerance)
+            return false;
+
+        // orient the base away from the apex, then the three sides follow
+        uint32_t v0 = simplex[0], v1 = simplex[1], v2 = simplex[2];
+        const uint32_t v3 = simplex[3];
+        const double side = orient3d(points[v0], points[v1], points[v2], points[v3]);
+        if (side == 0.0)
+            return false;
+        if (side < 0.0)
+            std::swap(v1, v2);
+
+        const uint32_t tetrahedron[4][3] = { { v0, v1, v2 }, { v0, v3, v1 }, { v1, v3, v2 }, { v2, v3, v0 } };
+        for (const auto& t : tetrahedron)
+            createFace(points, t[0], t[1], t[2]);
+
+        for (uint32_t f = 0; f < 4; ++f) {
+            for (int i = 0; i < 3; ++i) {
+                const uint32_t from = faces[f].v[i], to = faces[f].v[(i + 1) % 3];
+                for (uint32_t g = 0; g < 4; ++g) {
+                    for (int j = 0; j < 3; ++j) {
+                        if (faces[g].v[j] == to && faces[g].v[(j + 1) % 3] == from)
+                            faces[f].neighbors[i] = g;
+                    }
+                }
+            }
+        }
+
+        // points inside the tetrahedron are pruned here and never looked at again
+        const uint32_t first[4] = { 0, 1, 2, 3 };
+        for (std::size_t i = 0; i < count; ++i) {
+            const uint32_t point = static_cast<uint32_t>(i);
+            if (point != v0 && point != v1 && point != v2 && point != v3)
+                assignConflict(points, first, point);
+        }
+
+        for (uint32_t f = 0; f < 4; ++f) {
+            if (!faces[f].conflicts.empty())
+                pending.push_back(f);
+        }
+
+        return true;
+    }
+
+    uint32_t nextConflictFace()
+    {
+        while (!pending.empty()) {
+            const uint32_t f = pending.back();
+            if (faces[f].alive && !faces[f].conflicts.empty())
+                return f;
+            pending.pop_back();
+        }
+
+        return detail::HULL_NONE;
+    }
+
+    uint32_t farthestConflictFace() const
+    {
+        uint32_t best = detail::HULL_NONE;
+        double distance = 0.0;
+        for (uint32_t f = 0; f < faces.size(); ++f) {
+            if (faces[f].alive && !faces[f].conflicts.empty() && (best == detail::HULL_NONE || faces[f].farthestDistance > distance)) {
+                distance = faces[f].farthestDistance;
+                best = f;
+            }
+        }
+
+        return best;
+    }
+
+    void addPoint(const vec3* points, uint32_t start)
+    {
+        const uint32_t eye = faces[start].farthest;
+        const vec3& p = points[eye];
+
+        // depth-first search over the faces the eye sees; visiting the edges in
+        // order yields the horizon as a counter-clockwise loop
+        ++stamp;
+        visible.assign(1, start);
+        horizon.clear();
+        faces[start].visited = stamp;
+        stack.assign(1, { start, 0, 3 });
+
+        while (!stack.empty()) {
+            searchStep& top = stack.back();
+            if (top.remaining == 0) {
+                stack.pop_back();
+                continue;
+            }
+
+            const uint32_t f = top.face;
+            const uint32_t edge = top.edge;
+            top.edge = (edge + 1) % 3;
+            --top.remaining;
+
+            const uint32_t n = faces[f].neighbors[edge];
+            if (faces[n].visited == stamp)
+                continue;
+
+            if (above(points, faces[n], p)) {
+                // continue right after the edge the neighbour was entered through
+                faces[n].visited = stamp;
+                visible.push_back(n);
+                stack.push_back({ n, (sharedEdge(n, f) + 1) % 3, 2 });
+            } else {
+                horizon.push_back({ faces[f].v[edge], faces[f].v[(edge + 1) % 3], n, sharedEdge(n, f) });
+            }
+        }
+
+        // fan new faces from the eye over the horizon
+        created.clear();
+        for (const horizonEdge& h : horizon) {
+            const uint32_t f = createFace(points, h.a, h.b, eye);
+            faces[f].neighbors[0] = h.outside;
+            faces[h.outside].neighbors[h.outsideEdge] = f;
+            created.push_back(f);
+        }
+
+        for (std::size_t i = 0; i < created.size(); ++i) {
+            const uint32_t next = created[(i + 1) % created.size()];
+            faces[created[i]].neighbors[1] = next;
+            faces[next].neighbors[2] = created[i];
+        }
+
+        // hand the conflict points of the removed faces to the new ones; the rest are inside now
+        orphans.clear();
+        for (uint32_t f : visible) {
+            faces[f].alive = false;
+            orphans.insert(orphans.end(), faces[f].conflicts.begin(), faces[f].conflicts.end());
+            faces[f].conflicts.clear();
+            freeFaces.push_back(f);
+        }
+
+        for (uint32_t point : orphans) {
+            if (point != eye)
+                assignConflict(points, created, point);
+        }
+
+        for (uint32_t f : created) {
+            if (!faces[f].conflicts.empty())
+                pending.push_back(f);
+        }
+    }
+
+    // the edge of face f that borders face other
+    uint32_t sharedEdge(uint32_t f, uint32_t other) const
+    {
+        uint32_t edge = 0;
+        while (faces[f].neighbors[edge] != other)
+            ++edge;
+
+        return edge;
+    }
+
+    bool finish(const vec3* points, std::size_t count, convexHull& hull)
+    {
+        remap.assign(faces.size(), detail::HULL_NONE);
+        uint32_t faceCount = 0;
+        for (uint32_t f = 0; f < faces.size(); ++f) {
+            if (faces[f].alive)
+                remap[f] = faceCount++;
+        }
+
+        hull.triangles.resize(3 * static_cast<std::size_t>(faceCount));
+        hull.halfedges.resize(3 * static_cast<std::size_t>(faceCount));
+
+        // hull vertices are numbered in order of first use
+        if (vertexOf.size() < count)
+            vertexOf.resize(count, detail::HULL_NONE);
+
+        for (uint32_t f = 0; f < faces.size(); ++f) {
+            if (!faces[f].alive)
+                continue;
+
+            const face& current = faces[f];
+            const uint32_t base = 3 * remap[f];
+            for (uint32_t i = 0; i < 3; ++i) {
+                const uint32_t point = current.v[i];
+                if (vertexOf[point] == detail::HULL_NONE) {
+                    vertexOf[point] = static_cast<uint32_t>(hull.vertices.size());
+                    hull.pointIndices.push_back(point);
+                    hull.vertices.push_back(points[point]);
+                }
+                hull.triangles[base + i] = vertexOf[point];
+
+                const uint32_t n = current.neighbors[i];
+                hull.halfedges[base + i] = 3 * remap[n] + sharedEdge(n, f);
+            }
+        }
+
+        // leave the map clean for the next call
+        for (uint32_t point : hull.pointIndices)
+            vertexOf[point] = detail::HULL_NONE;
+
+        return true;
+    }
+};
+} // namespace lia
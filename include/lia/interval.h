@@ -0,0 +1,413 @@
+#pragma once
+
+#include "mathbase.h"
+#include "mat4.h"
+#include "vec3.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+
+namespace lia {
+namespace detail {
+    // the largest float below x; -inf and NaN stay as they are
+    inline float nextDown(float x)
+    {
+        if (!(x > -std::numeric_limits<float>::infinity()))
+            return x;
+        if (x == 0.0f)
+            return -std::numeric_limits<float>::denorm_min();
+
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        bits = x > 0.0f ? bits - 1u : bits + 1u;
+        std::memcpy(&x, &bits, sizeof(bits));
+
+        return x;
+    }
+
+    inline float nextUp(float x)
+    {
+        return -nextDown(-x);
+    }
+
+    // a * b with 0 * inf taken as 0: an infinite bound stands for unbounded
+    // finite values, whose product with an exact 0 is 0, where IEEE gives NaN
+    inline float boundProduct(float a, float b)
+    {
+        return a == 0.0f || b == 0.0f ? 0.0f : a * b;
+    }
+
+    // bounds the rounding error of a four-term sum of products, gamma_4 plus the
+    // error of computing the bound, and the absolute error of underflow
+    constexpr float SUM4_RELATIVE_ERROR = 3e-7f;
+    constexpr float SUM4_ABSOLUTE_ERROR = 1e-44f;
+} // namespace detail
+
+/**
+ * A closed interval of floats that always contains the exact result.
+ *
+ * Operations round to nearest and then step one float outward, which is
+ * conservative in any rounding mode without touching the FPU control word.
+ */
+struct interval {
+    float lower { 0.0f };
+    float upper { 0.0f };
+
+    interval() = default;
+
+    interval(float value)
+        : lower(value)
+        , upper(value)
+    { }
+
+    interval(float lo, float hi)
+        : lower(lo)
+        , upper(hi)
+    { }
+
+    static interval entire()
+    {
+        return interval(-std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
+    }
+
+    float width() const
+    {
+        return detail::nextUp(upper - lower);
+    }
+
+    float midpoint() const
+    {
+        return lower * 0.5f + upper * 0.5f;
+    }
+
+    bool contains(float value) const
+    {
+        return lower <= value && value <= upper;
+    }
+
+    interval& operator+=(const interval& i)
+    {
+        lower = detail::nextDown(lower + i.lower);
+        upper = detail::nextUp(upper + i.upper);
+
+        return (*this);
+    }
+
+    interval& operator-=(const interval& i)
+    {
+        const float lo = detail::nextDown(lower - i.upper);
+        upper = detail::nextUp(upper - i.lower);
+        lower = lo;
+
+        return (*this);
+    }
+
+    /**
+     * Negative parts of i are ignored. A friend, found by argument-dependent
+     * lookup only, so it does not hide ::sqrt from the rest of lia.
+     */
+    friend interval sqrt(const interval& i)
+    {
+        return interval(std::max(0.0f, detail::nextDown(std::sqrt(std::max(0.0f, i.lower)))),
+                        detail::nextUp(std::sqrt(std::max(0.0f, i.upper))));
+    }
+};
+
+inline interval operator+(const interval& a, const interval& b)
+{
+    return interval(detail::nextDown(a.lower + b.lower), detail::nextUp(a.upper + b.upper));
+}
+
+inline interval operator-(const interval& a, const interval& b)
+{
+    return interval(detail::nextDown(a.lower - b.upper), detail::nextUp(a.upper - b.lower));
+}
+
+inline interval operator-(const interval& i)
+{
+    return interval(-i.upper, -i.lower);
+}
+
+inline interval operator*(const interval& a, const interval& b)
+{
+    const float p0 = detail::boundProduct(a.lower, b.lower);
+    const float p1 = detail::boundProduct(a.lower, b.upper);
+    const float p2 = detail::boundProduct(a.upper, b.lower);
+    const float p3 = detail::boundProduct(a.upper, b.upper);
+
+    return interval(detail::nextDown(std::min(std::min(p0, p1), std::min(p2, p3))),
+                    detail::nextUp(std::max(std::max(p0, p1), std::max(p2, p3))));
+}
+
+inline interval operator*(const interval& i, float scalar)
+{
+    const float a = detail::boundProduct(i.lower, scalar);
+    const float b = detail::boundProduct(i.upper, scalar);
+
+    return interval(detail::nextDown(std::min(a, b)), detail::nextUp(std::max(a, b)));
+}
+
+/**
+ * The entire line when the divisor contains zero.
+ */
+inline interval operator/(const interval& a, const interval& b)
+{
+    if (b.contains(0.0f))
+        return interval::entire();
+
+    const float q0 = a.lower / b.lower;
+    const float q1 = a.lower / b.upper;
+    const float q2 = a.upper / b.lower;
+    const float q3 = a.upper / b.upper;
+
+    return interval(detail::nextDown(std::min(std::min(q0, q1), std::min(q2, q3))),
+                    detail::nextUp(std::max(std::max(q0, q1), std::max(q2, q3))));
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const interval& i)
+{
+    stream << "[" << i.lower << ", " << i.upper << "]";
+
+    return stream;
+}
+
+/**
+ * i * i, tighter than the product when i straddles zero.
+ */
+inline interval square(const interval& i)
+{
+    const float a = i.lower * i.lower;
+    const float b = i.upper * i.upper;
+    if (i.lower >= 0.0f)
+        return interval(detail::nextDown(a), detail::nextUp(b));
+    if (i.upper <= 0.0f)
+        return interval(detail::nextDown(b), detail::nextUp(a));
+
+    return interval(0.0f, detail::nextUp(std::max(a, b)));
+}
+
+/**
+ * The smallest interval containing both.
+ */
+inline interval hull(const interval& a, const interval& b)
+{
+    return interval(std::min(a.lower, b.lower), std::max(a.upper, b.upper));
+}
+
+inline bool overlaps(const interval& a, const interval& b)
+{
+    return a.lower <= b.upper && b.lower <= a.upper;
+}
+
+/**
+ * A vector of intervals, or equally an axis-aligned box.
+ */
+struct ivec3 {
+    interval x;
+    interval y;
+    interval z;
+
+    ivec3() = default;
+
+    ivec3(const interval& xx, const interval& yy, const interval& zz)
+        : x(xx)
+        , y(yy)
+        , z(zz)
+    { }
+
+    ivec3(const vec3& point)
+        : x(point.x)
+        , y(point.y)
+        , z(point.z)
+    { }
+
+    ivec3(const vec3& lower, const vec3& upper)
+        : x(lower.x, upper.x)
+        , y(lower.y, upper.y)
+        , z(lower.z, upper.z)
+    { }
+
+    interval& operator[](int index)
+    {
+        return ((&x)[index]);
+    }
+
+    const interval& operator[](int index) const
+    {
+        return ((&x)[index]);
+    }
+
+    vec3 lower() const
+    {
+        return vec3(x.lower, y.lower, z.lower);
+    }
+
+    vec3 upper() const
+    {
+        return vec3(x.upper, y.upper, z.upper);
+    }
+
+    bool contains(const vec3& point) const
+    {
+        return x.contains(point.x) && y.contains(point.y) && z.contains(point.z);
+    }
+
+    ivec3& operator+=(const ivec3& v)
+    {
+        x += v.x;
+        y += v.y;
+        z += v.z;
+
+        return (*this);
+    }
+
+    ivec3& operator-=(const ivec3& v)
+    {
+        x -= v.x;
+        y -= v.y;
+        z -= v.z;
+
+        return (*this);
+    }
+};
+
+inline ivec3 operator+(const ivec3& a, const ivec3& b)
+{
+    return ivec3(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+inline ivec3 operator-(const ivec3& a, const ivec3& b)
+{
+    return ivec3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+inline ivec3 operator-(const ivec3& v)
+{
+    return ivec3(-v.x, -v.y, -v.z);
+}
+
+inline ivec3 operator*(const ivec3& v, const interval& scalar)
+{
+    return ivec3(v.x * scalar, v.y * scalar, v.z * scalar);
+}
+
+inline ivec3 operator*(const ivec3& v, float scalar)
+{
+    return ivec3(v.x * scalar, v.y * scalar, v.z * scalar);
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const ivec3& v)
+{
+    stream << "ivec3(" << v.x << ", " << v.y << ", " << v.z << ")";
+
+    return stream;
+}
+
+inline interval dot(const ivec3& v1, const ivec3& v2)
+{
+    return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+}
+
+inline ivec3 cross(const ivec3& v1, const ivec3& v2)
+{
+    return ivec3(v1.y * v2.z - v1.z * v2.y,
+                 v1.z * v2.x - v1.x * v2.z,
+                 v1.x * v2.y - v1.y * v2.x);
+}
+
+inline interval magnitude(const ivec3& v)
+{
+    return sqrt(square(v.x) + square(v.y) + square(v.z));
+}
+
+inline ivec3 hull(const ivec3& a, const ivec3& b)
+{
+    return ivec3(hull(a.x, b.x), hull(a.y, b.y), hull(a.z, b.z));
+}
+
+inline bool overlaps(const ivec3& a, const ivec3& b)
+{
+    return overlaps(a.x, b.x) && overlaps(a.y, b.y) && overlaps(a.z, b.z);
+}
+
+/**
+ * Row-order transform of a box by an affine matrix, the last column is ignored.
+ *
+ * Each output axis is Arvo's sum of per-axis extremes, computed in round to
+ * nearest and then widened once by the error bound of the sum. That is tighter
+ * and cheaper than a step outward after every operation, and still contains
+ * the transform of every point in the box.
+ */
+inline ivec3 operator*(const ivec3& box, const mat4& mat)
+{
+    ivec3 result;
+    for (int j = 0; j < 3; ++j) {
+        float lo = mat(3, j);
+        float hi = mat(3, j);
+        float size = std::abs(mat(3, j));
+        for (int i = 0; i < 3; ++i) {
+            const float a = detail::boundProduct(box[i].lower, mat(i, j));
+            const float b = detail::boundProduct(box[i].upper, mat(i, j));
+            lo += std::min(a, b);
+            hi += std::max(a, b);
+            size += std::max(std::abs(a), std::abs(b));
+        }
+
+        // opposite infinities in one sum, from unbounded boxes or matrices, bound nothing
+        const float error = size * detail::SUM4_RELATIVE_ERROR + detail::SUM4_ABSOLUTE_ERROR;
+        const float bottom = lo - error;
+        const float top = hi + error;
+        result[j] = std::isnan(bottom) || std::isnan(top) ? interval::entire() : interval(detail::nextDown(bottom), detail::nextUp(top));
+    }
+
+    return result;
+}
+
+/**
+ * Transforms count boxes, e.g. animated bounds for culling.
+ */
+inline void transformBoxes(const mat4& mat, const ivec3* in, ivec3* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = in[i] * mat;
+}
+
+/**
+ * The bounds of count points; exact, since min and max do not round.
+ */
+inline ivec3 bounds(const vec3* points, std::size_t count)
+{
+    if (count == 0)
+        return ivec3();
+
+    vec3 lower = points[0];
+    vec3 upper = points[0];
+    for (std::size_t i = 1; i < count; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            lower[axis] = std::min(lower[axis], points[i][axis]);
+            upper[axis] = std::max(upper[axis], points[i][axis]);
+        }
+    }
+
+    return ivec3(lower, upper);
+}
+
+/**
+ * The hull of count boxes, as a BVH refit merges its children.
+ */
+inline ivec3 bounds(const ivec3* boxes, std::size_t count)
+{
+    if (count == 0)
+        return ivec3();
+
+    ivec3 result = boxes[0];
+    for (std::size_t i = 1; i < count; ++i)
+        result = hull(result, boxes[i]);
+
+    return result;
+}
+} // namespace lia
@@ -4,7 +4,29 @@
 #include "vec3.h"
 #include "vec4.h"
 
+#include "arena.h"
+#include "clip2d.h"
+#include "color.h"
+#include "curves.h"
+#include "delaunay.h"
+#include "fixed.h"
+#include "format.h"
+#include "hull3d.h"
+#include "interval.h"
 #include "mat4.h"
+#include "noise.h"
+#include "parse.h"
+#include "path2d.h"
+#include "poisson.h"
+#include "predicates.h"
 #include "quaternion.h"
+#include "random.h"
+#include "sampling.h"
+#include "sh.h"
+#include "snapshot.h"
+#include "streaming.h"
+#include "transform.h"
+#include "transformpool.h"
+#include "triplebuffer.h"
 
 #include "mathbase.h"
\ No newline at end of file
@@ -304,8 +304,8 @@ inline mat4 translate(const mat4& mat, const vec3& translation)
  */
 inline mat4 rotate(const mat4& mat, const float& angle, const vec3& vec)
 {
-    const float cos_ = std::cos(angle);
-    const float sin_ = std::sin(angle);
+    const float cos_ = fcos(angle);
+    const float sin_ = fsin(angle);
     const float d = 1.0f - cos_;
 
     const vec3 axis = normalize(vec);
@@ -325,8 +325,8 @@ inline mat4 rotate(const mat4& mat, const float& angle, const vec3& vec)
  */
 inline mat4 rotateX(const mat4& mat, const float& angle)
 {
-    const float cos_ = std::cos(angle);
-    const float sin_ = std::sin(angle);
+    const float cos_ = fcos(angle);
+    const float sin_ = fsin(angle);
 
     return mat * mat4(1, 0, 0, 0, 0, cos_, sin_, 0, 0, -sin_, cos_, 0, 0, 0, 0, 1);
 }
@@ -336,8 +336,8 @@ inline mat4 rotateX(const mat4& mat, const float& angle)
  */
 inline mat4 rotateY(const mat4& mat, const float& angle)
 {
-    const float cos_ = std::cos(angle);
-    const float sin_ = std::sin(angle);
+    const float cos_ = fcos(angle);
+    const float sin_ = fsin(angle);
 
     return mat * mat4(cos_, 0, -sin_, 0, 0, 1, 0, 0, sin_, 0, cos_, 0, 0, 0, 0, 1);
 }
@@ -347,8 +347,8 @@ inline mat4 rotateY(const mat4& mat, const float& angle)
  */
 inline mat4 rotateZ(const mat4& mat, const float& angle)
 {
-    const float cos_ = std::cos(angle);
-    const float sin_ = std::sin(angle);
+    const float cos_ = fcos(angle);
+    const float sin_ = fsin(angle);
 
     return mat * mat4(cos_, sin_, 0, 0, -sin_, cos_, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
 }
@@ -381,7 +381,7 @@ inline mat4 orthographic(float left, float right, float bottom, float top, float
  */
 inline mat4 perspective(float fov, float aspect, float near_, float far_)
 {
-    const float top = near_ * std::tan((fov / 2.0f));
+    const float top = near_ * ftan(fov / 2.0f);
     const float bottom = -top;
     const float right = top * aspect;
     const float left = -right;
@@ -1,15 +1,429 @@
 #pragma once
 
-#include "vec3.h"
-
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <ostream>
 
+#include "vec3.h"
+
+/**
+ * Defining LIA_DETERMINISTIC (CMake option of the same name) makes float results
+ * bit-identical on every IEEE 754 machine: fsin, fcos, ftan, facos, fatan2,
+ * fpow, flog2 and fcbrt switch from libm to lia's own kernels, which lia uses
+ * everywhere. Sums in lia always run in source order, and pairwiseSum fixes the
+ * tree of larger ones.
+ *
+ * FMA contraction, which would fuse a * b + c differently per compiler and
+ * target, is a compiler flag the header cannot set: the CMake option adds
+ * -ffp-contract=off (/fp:precise on MSVC) to the lia target, so link lia or
+ * pass the flag yourself when defining the macro by hand.
+ */
+#ifdef LIA_DETERMINISTIC
+#if defined(__FAST_MATH__)
+#error "LIA_DETERMINISTIC cannot be combined with -ffast-math"
+#endif
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+#error "LIA_DETERMINISTIC needs float math at float precision, e.g. SSE2 instead of x87"
+#endif
+#endif
+
 namespace lia {
 constexpr float TOLERANCE = 2e-37f;
 constexpr double PI = 3.1415926535897931;
 constexpr double TAU = 6.28318530717;
 
+namespace detail {
+    // pi / 2 in three parts; k times the first two is exact for |k| < 2^20 (fdlibm)
+    constexpr double PIO2_1 = 1.57079632673412561417e+00;
+    constexpr double PIO2_2 = 6.07710050630396597660e-11;
+    constexpr double PIO2_2T = 2.02226624879595063154e-21;
+
+    // 1.5 * 2^52: adding it rounds a double below 2^51 to an integer held in the low bits
+    constexpr double ROUNDING_SHIFT = 6755399441055744.0;
+
+    inline uint64_t doubleBits(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // quadrant of x, and x minus that many quarter turns
+    inline int reduceQuarterTurns(float x, double& r)
+    {
+        // beyond the exact range, first take an exact remainder by the double 2 pi
+        double d = static_cast<double>(x);
+        if (std::abs(d) > 1e6)
+            d = std::fmod(d, 6.28318530717958647692);
+
+        const double shifted = d * 0.63661977236758134308 + ROUNDING_SHIFT;
+        const double k = shifted - ROUNDING_SHIFT;
+        r = ((d - k * PIO2_1) - k * PIO2_2) - k * PIO2_2T;
+
+        return static_cast<int>(doubleBits(shifted) & 3u);
+    }
+
+    // fdlibm's minimax polynomials on [-pi / 4, pi / 4]
+    inline double sinKernel(double r)
+    {
+        const double z = r * r;
+        const double p = 8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06 + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)));
+        return r + r * z * (-1.66666666666666324348e-01 + z * p);
+    }
+
+    inline double cosKernel(double r)
+    {
+        const double z = r * r;
+        const double p = 4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 + z * (2.48015872894767294178e-05 + z * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11))));
+        return (1.0 - 0.5 * z) + z * z * p;
+    }
+
+    /**
+     * sin and cos from basic double operations only, so the result is the same
+     * wherever IEEE 754 is; within one float ulp of the true value.
+     */
+    inline float deterministicSin(float x)
+    {
+        if (!std::isfinite(x))
+            return x - x;
+
+        double r;
+        switch (reduceQuarterTurns(x, r)) {
+        case 0:
+            return static_cast<float>(sinKernel(r));
+        case 1:
+            return static_cast<float>(cosKernel(r));
+        case 2:
+            return static_cast<float>(-sinKernel(r));
+        default:
+            return static_cast<float>(-cosKernel(r));
+        }
+    }
+
+    inline float deterministicCos(float x)
+    {
+        if (!std::isfinite(x))
+            return x - x;
+
+        double r;
+        switch (reduceQuarterTurns(x, r)) {
+        case 0:
+            return static_cast<float>(cosKernel(r));
+        case 1:
+            return static_cast<float>(-sinKernel(r));
+        case 2:
+            return static_cast<float>(-cosKernel(r));
+        default:
+            return static_cast<float>(sinKernel(r));
+        }
+    }
+
+    // fdlibm's rational approximation, asin(t) = t + t * asinRational(t^2) for |t| <= 0.5
+    inline double asinRational(double z)
+    {
+        const double p = z * (1.66666666666666657415e-01 + z * (-3.25565818622400915405e-01 + z * (2.01212532134862925881e-01
+            + z * (-4.00555345006794114027e-02 + z * (7.91534994289814532176e-04 + z * 3.47933107596021167570e-05)))));
+        const double q = 1.0 + z * (-2.40339491173441421878e+00 + z * (2.02094576023350569471e+00 + z * (-6.88283971605453293030e-01
+            + z * 7.70381505559019352791e-02)));
+        return p / q;
+    }
+
+    inline float deterministicAcos(float x)
+    {
+        const double halfPi = PIO2_1 + PIO2_2;
+        const double d = static_cast<double>(x);
+        if (!(std::abs(d) <= 1.0))
+            return std::numeric_limits<float>::quiet_NaN();
+        if (std::abs(d) <= 0.5)
+            return static_cast<float>(halfPi - (d + d * asinRational(d * d)));
+
+        // acos(x) = 2 asin(sqrt((1 - |x|) / 2)), reflected for negative x
+        const double z = (1.0 - std::abs(d)) * 0.5;
+        const double s = std::sqrt(z);
+        const double angle = 2.0 * (s + s * asinRational(z));
+        return static_cast<float>(d > 0.0 ? angle : 2.0 * halfPi - angle);
+    }
+
+    // 1 / (2n + 1), for the atan series below
+    constexpr double ODD_RECIPROCALS[10] = { 1.0, 1.0 / 3.0, 1.0 / 5.0, 1.0 / 7.0, 1.0 / 9.0, 1.0 / 11.0, 1.0 / 13.0, 1.0 / 15.0, 1.0 / 17.0, 1.0 / 19.0 };
+
+    inline float deterministicTan(float x)
+    {
+        if (!std::isfinite(x))
+            return x - x;
+
+        double r;
+        const int quadrant = reduceQuarterTurns(x, r);
+        const double s = sinKernel(r);
+        const double c = cosKernel(r);
+        return static_cast<float>(quadrant & 1 ? -c / s : s / c);
+    }
+
+    // atan on [0, 1]: two halvings, atan(t) = 2 atan(t / (1 + sqrt(1 + t^2))),
+    // bring t under 0.2 for the series
+    inline double atanKernel(double t)
+    {
+        t = t / (1.0 + std::sqrt(1.0 + t * t));
+        t = t / (1.0 + std::sqrt(1.0 + t * t));
+
+        const double t2 = t * t;
+        double p = 0.0;
+        for (int n = 9; n >= 0; --n)
+            p = p * -t2 + ODD_RECIPROCALS[n];
+
+        return 4.0 * t * p;
+    }
+
+    inline float deterministicAtan2(float y, float x)
+    {
+        if (std::isnan(x) || std::isnan(y))
+            return std::numeric_limits<float>::quiet_NaN();
+
+        // infinities act as unit lengths against finite values
+        double dy = y;
+        double dx = x;
+        if (std::isinf(x) || std::isinf(y)) {
+            dy = std::copysign(std::isinf(y) ? 1.0 : 0.0, dy);
+            dx = std::copysign(std::isinf(x) ? 1.0 : 0.0, dx);
+        }
+
+        const double ax = std::abs(dx);
+        const double ay = std::abs(dy);
+        double angle = 0.0;
+        if (ay > 0.0)
+            angle = ay <= ax ? atanKernel(ay / ax) : (PIO2_1 + PIO2_2) - atanKernel(ax / ay);
+        if (std::signbit(dx))
+            angle = PI - angle;
+
+        return static_cast<float>(std::copysign(angle, dy));
+    }
+
+    // 1 / c and log2 c for the centers c of 16 equal slices of [0.699, 1.398) by float bits,
+    // with c = 1 for the slice holding 1 so that log2 of a power of two is exact
+    constexpr double LOG2_INVERSE[16] = { 1.3989071038251366, 1.3403141361256545, 1.2864321608040201, 1.2367149758454106,
+        1.1906976744186046, 1.147982062780269, 1.1082251082251082, 1.0711297071129706, 1.0364372469635628, 1.0,
+        0.94814814814814818, 0.8951048951048951, 0.84768211920529801, 0.80503144654088055, 0.76646706586826352, 0.73142857142857143 };
+    constexpr double LOG2_CENTER[16] = { -0.48430016171595752, -0.42257117196425142, -0.36337537945635118, -0.30651304250067468,
+        -0.25180715041053969, -0.19910010007969525, -0.14825095858394247, -0.099133192019251318, -0.051632768415322362, 0.0,
+        0.076815597050830839, 0.15987133677838941, 0.23840473932507891, 0.31288295528435528, 0.38370429247405213, 0.45121111183232882 };
+
+    // 2^(j / 32)
+    constexpr double EXP2_TABLE[32] = { 1.0, 1.0218971486541166, 1.0442737824274138, 1.0671404006768237, 1.0905077326652577,
+        1.1143867425958924, 1.1387886347566916, 1.1637248587775775, 1.189207115002721, 1.215247359980469, 1.241857812073484,
+        1.2690509571917332, 1.2968395546510096, 1.3252366431597413, 1.3542555469368927, 1.383909881963832, 1.4142135623730951,
+        1.4451808069770467, 1.4768261459394993, 1.5091644275934228, 1.5422108254079407, 1.5759808451078865, 1.6104903319492543,
+        1.6457554781539649, 1.681792830507429, 1.7186192981224779, 1.7562521603732995, 1.7947090750031072, 1.8340080864093424,
+        1.8741676341103, 1.9152065613971474, 1.9571441241754002 };
+
+    /**
+     * log2 of a positive finite float, within 2^-37 absolute: the exponent, plus
+     * log2 c from the table, plus log2(1 + r) for r = z / c - 1 with |r| < 0.03
+     * by a fitted quintic.
+     */
+    inline double log2Kernel(float x)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        int exponent = 0;
+        if (bits < 0x00800000u) {
+            // subnormal: scale by 2^23 into the normal range
+            x *= 8388608.0f;
+            std::memcpy(&bits, &x, sizeof(bits));
+            exponent = -23;
+        }
+
+        // z in [0.699, 1.398) with x = z * 2^e
+        const uint32_t offset = bits - 0x3f330000u;
+        const int index = static_cast<int>((offset >> 19) & 15u);
+        exponent += static_cast<int32_t>(offset) >> 23;
+        const uint32_t zBits = bits - (offset & 0xff800000u);
+        float z;
+        std::memcpy(&z, &zBits, sizeof(z));
+
+        const double r = static_cast<double>(z) * LOG2_INVERSE[index] - 1.0;
+        const double r2 = r * r;
+        const double p = r * (1.4426950409090171 + r * -0.72134744053404387) + r2 * r * (0.48089817648959488 + r * -0.36096788096203475 + r2 * 0.2888882305711527);
+
+        return (static_cast<double>(exponent) + LOG2_CENTER[index]) + p;
+    }
+
+    /**
+     * 2^y for |y| < 1000, within 2^-43 relative: 2^(k / 32) from the table and
+     * its exponent bits, times a fitted quartic for 2^r with |r| <= 1 / 64.
+     */
+    inline double exp2Kernel(double y)
+    {
+        const double shifted = y * 32.0 + ROUNDING_SHIFT;
+        const uint64_t k = doubleBits(shifted);
+        const double r = y - (shifted - ROUNDING_SHIFT) * (1.0 / 32.0);
+
+        // the low bits of k hold the rounded y * 32 in two's complement
+        const uint64_t scaleBits = doubleBits(EXP2_TABLE[k & 31u]) + ((k >> 5) << 52);
+        double scale;
+        std::memcpy(&scale, &scaleBits, sizeof(scale));
+
+        const double r2 = r * r;
+        return scale + scale * (r * (0.69314718053518298 + r * 0.24022650697128664) + r2 * r * (0.05550451521492486 + r * 0.009618102795508553));
+    }
+
+    inline float deterministicLog2(float x)
+    {
+        if (std::isnan(x) || x < 0.0f)
+            return std::numeric_limits<float>::quiet_NaN();
+        if (x == 0.0f)
+            return -std::numeric_limits<float>::infinity();
+        if (std::isinf(x))
+            return x;
+
+        return static_cast<float>(log2Kernel(x));
+    }
+
+    inline float deterministicPow(float x, float y)
+    {
+        if (y == 0.0f || x == 1.0f)
+            return 1.0f;
+        if (std::isnan(x) || std::isnan(y))
+            return std::numeric_limits<float>::quiet_NaN();
+
+        // negative bases only have real powers for integer exponents
+        float sign = 1.0f;
+        if (std::signbit(x)) {
+            if (std::isfinite(y) && std::floor(y) != y)
+                return std::numeric_limits<float>::quiet_NaN();
+            if (std::isfinite(y) && std::fmod(y, 2.0f) != 0.0f)
+                sign = -1.0f;
+            x = -x;
+        }
+
+        if (x == 1.0f)
+            return 1.0f;
+        if (x == 0.0f)
+            return sign * (y > 0.0f ? 0.0f : std::numeric_limits<float>::infinity());
+        if (std::isinf(x))
+            return sign * (y > 0.0f ? x : 0.0f);
+
+        // past the float range, where exp2Kernel need not go
+        const double t = static_cast<double>(y) * log2Kernel(x);
+        if (t >= 128.0)
+            return sign * std::numeric_limits<float>::infinity();
+        if (t < -151.0)
+            return sign * 0.0f;
+
+        return sign * static_cast<float>(exp2Kernel(t));
+    }
+
+    inline float deterministicCbrt(float x)
+    {
+        if (x == 0.0f || !std::isfinite(x))
+            return x;
+
+        return std::copysign(static_cast<float>(exp2Kernel(log2Kernel(std::abs(x)) * (1.0 / 3.0))), x);
+    }
+} // namespace detail
+
+/**
+ * The transcendental functions as lia evaluates them: libm by default, lia's
+ * own kernels under LIA_DETERMINISTIC. sqrt needs no replacement, IEEE 754
+ * rounds it correctly everywhere.
+ */
+inline float fsin(float x)
+{
+#ifdef LIA_DETERMINISTIC
+    return detail::deterministicSin(x);
+#else
+    return std::sin(x);
+#endif
+}
+
+inline float fcos(float x)
+{
+#ifdef LIA_DETERMINISTIC
+    return detail::deterministicCos(x);
+#else
+    return std::cos(x);
+#endif
+}
+
+inline float ftan(float x)
+{
+#ifdef LIA_DETERMINISTIC
+    return detail::deterministicTan(x);
+#else
+    return std::tan(x);
+#endif
+}
+
+inline float facos(float x)
+{
+#ifdef LIA_DETERMINISTIC
+    return detail::deterministicAcos(x);
+#else
+    return std::acos(x);
+#endif
+}
+
+inline float fatan2(float y, float x)
+{
+#ifdef LIA_DETERMINISTIC
+    return detail::deterministicAtan2(y, x);
+#else
+    return std::atan2(y, x);
+#endif
+}
+
+inline float fpow(float x, float y)
+{
+#ifdef LIA_DETERMINISTIC
+    return detail::deterministicPow(x, y);
+#else
+    return std::pow(x, y);
+#endif
+}
+
+inline float flog2(float x)
+{
+#ifdef LIA_DETERMINISTIC
+    return detail::deterministicLog2(x);
+#else
+    return std::log2(x);
+#endif
+}
+
+inline float fcbrt(float x)
+{
+#ifdef LIA_DETERMINISTIC
+    return detail::deterministicCbrt(x);
+#else
+    return std::cbrt(x);
+#endif
+}
+
+/**
+ * Sum of count values over a pairwise tree that depends only on count: blocks
+ * of 64 are summed in order and halves are split at block boundaries. Jobs that
+ * each reduce one subtree and combine the results the same way give the same
+ * bits for any thread count, and rounding error grows with log(count).
+ */
+template <typename T>
+inline T pairwiseSum(const T* values, std::size_t count)
+{
+    if (count <= 64) {
+        T sum = T();
+        for (std::size_t i = 0; i < count; ++i)
+            sum += values[i];
+
+        return sum;
+    }
+
+    const std::size_t half = (count / 64 + 1) / 2 * 64;
+    return pairwiseSum(values, half) + pairwiseSum(values + half, count - half);
+}
+
 inline float radians(const float degrees)
 {
     return degrees * 0.0174532925f;
@@ -0,0 +1,637 @@
+#pragma once
+
+#include "mathbase.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "vec4.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lia {
+/**
+ * A 4D noise value with its analytic gradient, which do not fit in one vec4.
+ */
+struct noiseSample4 {
+    float value { 0.0f };
+    vec4 derivative;
+};
+
+namespace detail {
+    // Large primes decorrelating the lattice axes, the product with the seed is the corner hash.
+    constexpr uint32_t NOISE_PRIME_X = 501125321u;
+    constexpr uint32_t NOISE_PRIME_Y = 1136930381u;
+    constexpr uint32_t NOISE_PRIME_Z = 1720413743u;
+    constexpr uint32_t NOISE_PRIME_W = 1066037191u;
+
+    inline uint32_t noiseHash(uint32_t seed, uint32_t x, uint32_t y, uint32_t z = 0, uint32_t w = 0)
+    {
+        uint32_t h = seed ^ x ^ y ^ z ^ w;
+        h *= 0x27d4eb2du;
+        return h ^ (h >> 15u);
+    }
+
+    inline int fastFloor(float f)
+    {
+        const int i = static_cast<int>(f);
+        return f < static_cast<float>(i) ? i - 1 : i;
+    }
+
+    inline float quintic(float t)
+    {
+        return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+    }
+
+    inline float quinticDerivative(float t)
+    {
+        return 30.0f * t * t * (t * (t - 2.0f) + 1.0f);
+    }
+
+    inline float hashToSigned(uint32_t h)
+    {
+        return static_cast<float>(h >> 8u) * (2.0f / 16777216.0f) - 1.0f;
+    }
+
+    inline vec2 gradient2(uint32_t h)
+    {
+        static const float table[8][2] = {
+            { 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f },
+            { 0.70710678f, 0.70710678f }, { -0.70710678f, 0.70710678f },
+            { 0.70710678f, -0.70710678f }, { -0.70710678f, -0.70710678f }
+        };
+
+        const float* g = table[(h >> 24u) & 7u];
+        return vec2(g[0], g[1]);
+    }
+
+    inline vec3 gradient3(uint32_t h)
+    {
+        // cube edge midpoints, four of them repeated to fill a power of two
+        static const float table[16][3] = {
+            { 1, 1, 0 }, { -1, 1, 0 }, { 1, -1, 0 }, { -1, -1, 0 },
+            { 1, 0, 1 }, { -1, 0, 1 }, { 1, 0, -1 }, { -1, 0, -1 },
+            { 0, 1, 1 }, { 0, -1, 1 }, { 0, 1, -1 }, { 0, -1, -1 },
+            { 1, 1, 0 }, { 0, -1, 1 }, { -1, 1, 0 }, { 0, -1, -1 }
+        };
+
+        const float* g = table[(h >> 24u) & 15u];
+        return vec3(g[0], g[1], g[2]);
+    }
+
+    inline vec4 gradient4(uint32_t h)
+    {
+        // 32 hypercube edge midpoints: one zero component and three signed ones
+        static const float table[32][4] = {
+            { 0, 1, 1, 1 }, { 0, -1, 1, 1 }, { 0, 1, -1, 1 }, { 0, -1, -1, 1 },
+            { 0, 1, 1, -1 }, { 0, -1, 1, -1 }, { 0, 1, -1, -1 }, { 0, -1, -1, -1 },
+            { 1, 0, 1, 1 }, { -1, 0, 1, 1 }, { 1, 0, -1, 1 }, { -1, 0, -1, 1 },
+            { 1, 0, 1, -1 }, { -1, 0, 1, -1 }, { 1, 0, -1, -1 }, { -1, 0, -1, -1 },
+            { 1, 1, 0, 1 }, { -1, 1, 0, 1 }, { 1, -1, 0, 1 }, { -1, -1, 0, 1 },
+            { 1, 1, 0, -1 }, { -1, 1, 0, -1 }, { 1, -1, 0, -1 }, { -1, -1, 0, -1 },
+            { 1, 1, 1, 0 }, { -1, 1, 1, 0 }, { 1, -1, 1, 0 }, { -1, -1, 1, 0 },
+            { 1, 1, -1, 0 }, { -1, 1, -1, 0 }, { 1, -1, -1, 0 }, { -1, -1, -1, 0 }
+        };
+
+        const float* g = table[(h >> 24u) & 31u];
+        return vec4(g[0], g[1], g[2], g[3]);
+    }
+
+    // Shared lattice interpolation; Gradient selects Perlin (true) or value (false) noise.
+    template <bool Gradient>
+    inline vec3 latticeNoise(const vec2& p, uint32_t seed)
+    {
+        const int ix = fastFloor(p.x);
+        const int iy = fastFloor(p.y);
+        const float fx = p.x - static_cast<float>(ix);
+        const float fy = p.y - static_cast<float>(iy);
+
+        const uint32_t x0 = static_cast<uint32_t>(ix) * NOISE_PRIME_X, x1 = x0 + NOISE_PRIME_X;
+        const uint32_t y0 = static_cast<uint32_t>(iy) * NOISE_PRIME_Y, y1 = y0 + NOISE_PRIME_Y;
+
+        const uint32_t h[4] = { noiseHash(seed, x0, y0), noiseHash(seed, x1, y0), noiseHash(seed, x0, y1), noiseHash(seed, x1, y1) };
+
+        vec2 g[4];
+        float v[4];
+        for (int i = 0; i < 4; ++i) {
+            const vec2 offset(fx - static_cast<float>(i & 1), fy - static_cast<float>(i >> 1));
+            g[i] = Gradient ? gradient2(h[i]) : vec2(0.0f);
+            v[i] = Gradient ? dot(g[i], offset) : hashToSigned(h[i]);
+        }
+
+        const float ux = quintic(fx), uy = quintic(fy);
+        const float dux = quinticDerivative(fx), duy = quinticDerivative(fy);
+
+        const float k1 = v[1] - v[0];
+        const float k2 = v[2] - v[0];
+        const float k3 = v[0] - v[1] - v[2] + v[3];
+
+        const vec2 d = g[0] + (g[1] - g[0]) * ux + (g[2] - g[0]) * uy + (g[0] - g[1] - g[2] + g[3]) * (ux * uy)
+            + vec2(dux * (k1 + k3 * uy), duy * (k2 + k3 * ux));
+
+        return vec3(v[0] + k1 * ux + k2 * uy + k3 * ux * uy, d.x, d.y);
+    }
+
+    template <bool Gradient>
+    inline vec4 latticeNoise(const vec3& p, uint32_t seed)
+    {
+        const int ix = fastFloor(p.x);
+        const int iy = fastFloor(p.y);
+        const int iz = fastFloor(p.z);
+        const vec3 f(p.x - static_cast<float>(ix), p.y - static_cast<float>(iy), p.z - static_cast<float>(iz));
+
+        const uint32_t x0 = static_cast<uint32_t>(ix) * NOISE_PRIME_X, x1 = x0 + NOISE_PRIME_X;
+        const uint32_t y0 = static_cast<uint32_t>(iy) * NOISE_PRIME_Y, y1 = y0 + NOISE_PRIME_Y;
+        const uint32_t z0 = static_cast<uint32_t>(iz) * NOISE_PRIME_Z, z1 = z0 + NOISE_PRIME_Z;
+
+        // corners in x-fastest order: a b c d on z0, e f g h on z1
+        vec3 g[8];
+        float v[8];
+        for (int i = 0; i < 8; ++i) {
+            const uint32_t h = noiseHash(seed, (i & 1) ? x1 : x0, (i & 2) ? y1 : y0, (i & 4) ? z1 : z0);
+            const vec3 offset = f - vec3(static_cast<float>(i & 1), static_cast<float>((i >> 1) & 1), static_cast<float>(i >> 2));
+            g[i] = Gradient ? gradient3(h) : vec3(0.0f);
+            v[i] = Gradient ? dot(g[i], offset) : hashToSigned(h);
+        }
+
+        const vec3 u(quintic(f.x), quintic(f.y), quintic(f.z));
+        const vec3 du(quinticDerivative(f.x), quinticDerivative(f.y), quinticDerivative(f.z));
+
+        const float k1 = v[1] - v[0];
+        const float k2 = v[2] - v[0];
+        const float k3 = v[4] - v[0];
+        const float k4 = v[0] - v[1] - v[2] + v[3];
+        const float k5 = v[0] - v[2] - v[4] + v[6];
+        const float k6 = v[0] - v[1] - v[4] + v[5];
+        const float k7 = -v[0] + v[1] + v[2] - v[3] + v[4] - v[5] - v[6] + v[7];
+
+        const float value = v[0] + k1 * u.x + k2 * u.y + k3 * u.z + k4 * u.x * u.y
+            + k5 * u.y * u.z + k6 * u.z * u.x + k7 * u.x * u.y * u.z;
+
+        const vec3 d = g[0] + (g[1] - g[0]) * u.x + (g[2] - g[0]) * u.y + (g[4] - g[0]) * u.z
+            + (g[0] - g[1] - g[2] + g[3]) * (u.x * u.y)
+            + (g[0] - g[2] - g[4] + g[6]) * (u.y * u.z)
+            + (g[0] - g[1] - g[4] + g[5]) * (u.z * u.x)
+            + (-g[0] + g[1] + g[2] - g[3] + g[4] - g[5] - g[6] + g[7]) * (u.x * u.y * u.z)
+            + vec3(du.x * (k1 + k4 * u.y + k6 * u.z + k7 * u.y * u.z),
+                   du.y * (k2 + k5 * u.z + k4 * u.x + k7 * u.z * u.x),
+                   du.z * (k3 + k6 * u.x + k5 * u.y + k7 * u.x * u.y));
+
+        return vec4(value, d.x, d.y, d.z);
+    }
+
+    // the 16 corners of a 4D cell, each weighted by the product of per-axis fades
+    template <bool Gradient>
+    inline noiseSample4 latticeNoise(const vec4& p, uint32_t seed)
+    {
+        const uint32_t primes[4] = { NOISE_PRIME_X, NOISE_PRIME_Y, NOISE_PRIME_Z, NOISE_PRIME_W };
+        uint32_t base[4];
+        vec4 f, u, du;
+        for (int axis = 0; axis < 4; ++axis) {
+            const int cell = fastFloor(p[axis]);
+            base[axis] = static_cast<uint32_t>(cell) * primes[axis];
+            f[axis] = p[axis] - static_cast<float>(cell);
+            u[axis] = quintic(f[axis]);
+            du[axis] = quinticDerivative(f[axis]);
+        }
+
+        noiseSample4 result;
+        for (int corner = 0; corner < 16; ++corner) {
+            uint32_t coords[4];
+            vec4 offset;
+            float factors[4];
+            float weight = 1.0f;
+
+            for (int axis = 0; axis < 4; ++axis) {
+                const int bit = (corner >> axis) & 1;
+                coords[axis] = base[axis] + (bit ? primes[axis] : 0u);
+                offset[axis] = f[axis] - static_cast<float>(bit);
+                factors[axis] = bit ? u[axis] : 1.0f - u[axis];
+                weight *= factors[axis];
+            }
+
+            const uint32_t h = noiseHash(seed, coords[0], coords[1], coords[2], coords[3]);
+            const vec4 g = Gradient ? gradient4(h) : vec4(0.0f);
+            const float v = Gradient ? dot(g, offset) : hashToSigned(h);
+            result.value += weight * v;
+
+            // the weight with one axis' fade replaced by its derivative
+            for (int axis = 0; axis < 4; ++axis) {
+                float partial = ((corner >> axis) & 1) ? du[axis] : -du[axis];
+                for (int other = 0; other < 4; ++other)
+                    partial *= other == axis ? 1.0f : factors[other];
+                result.derivative[axis] += weight * g[axis] + partial * v;
+            }
+        }
+
+        return result;
+    }
+} // namespace detail
+
+/**
+ * Value noise in [-1, 1].
+ */
+inline float valueNoise(const vec2& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<false>(p, seed).x;
+}
+
+inline float valueNoise(const vec3& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<false>(p, seed).x;
+}
+
+inline float valueNoise(const vec4& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<false>(p, seed).value;
+}
+
+/**
+ * Value noise with its analytic gradient: (value, d/dx, d/dy).
+ */
+inline vec3 valueNoiseWithDerivative(const vec2& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<false>(p, seed);
+}
+
+/**
+ * Value noise with its analytic gradient: (value, d/dx, d/dy, d/dz).
+ */
+inline vec4 valueNoiseWithDerivative(const vec3& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<false>(p, seed);
+}
+
+inline noiseSample4 valueNoiseWithDerivative(const vec4& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<false>(p, seed);
+}
+
+/**
+ * Perlin gradient noise with a quintic fade, roughly in [-1, 1].
+ */
+inline float perlin(const vec2& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<true>(p, seed).x;
+}
+
+inline float perlin(const vec3& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<true>(p, seed).x;
+}
+
+inline float perlin(const vec4& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<true>(p, seed).value;
+}
+
+/**
+ * Perlin noise with its analytic gradient: (value, d/dx, d/dy).
+ */
+inline vec3 perlinWithDerivative(const vec2& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<true>(p, seed);
+}
+
+/**
+ * Perlin noise with its analytic gradient: (value, d/dx, d/dy, d/dz).
+ */
+inline vec4 perlinWithDerivative(const vec3& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<true>(p, seed);
+}
+
+inline noiseSample4 perlinWithDerivative(const vec4& p, uint32_t seed = 0)
+{
+    return detail::latticeNoise<true>(p, seed);
+}
+
+/**
+ * Simplex noise with its analytic gradient: (value, d/dx, d/dy), roughly in [-1, 1].
+ */
+inline vec3 simplexWithDerivative(const vec2& p, uint32_t seed = 0)
+{
+    const float F2 = 0.36602540378f; // (sqrt(3) - 1) / 2
+    const float G2 = 0.21132486540f; // (3 - sqrt(3)) / 6
+
+    const float s = (p.x + p.y) * F2;
+    const int i = detail::fastFloor(p.x + s);
+    const int j = detail::fastFloor(p.y + s);
+    const float t = static_cast<float>(i + j) * G2;
+    const vec2 x0(p.x - (static_cast<float>(i) - t), p.y - (static_cast<float>(j) - t));
+
+    const int i1 = x0.x > x0.y ? 1 : 0;
+    const int j1 = 1 - i1;
+
+    const vec2 corners[3] = {
+        x0,
+        vec2(x0.x - static_cast<float>(i1) + G2, x0.y - static_cast<float>(j1) + G2),
+        vec2(x0.x - 1.0f + 2.0f * G2, x0.y - 1.0f + 2.0f * G2)
+    };
+    const uint32_t xi = static_cast<uint32_t>(i) * detail::NOISE_PRIME_X;
+    const uint32_t yi = static_cast<uint32_t>(j) * detail::NOISE_PRIME_Y;
+    const uint32_t hashes[3] = {
+        detail::noiseHash(seed, xi, yi),
+        detail::noiseHash(seed, xi + (i1 ? detail::NOISE_PRIME_X : 0u), yi + (j1 ? detail::NOISE_PRIME_Y : 0u)),
+        detail::noiseHash(seed, xi + detail::NOISE_PRIME_X, yi + detail::NOISE_PRIME_Y)
+    };
+
+    float value = 0.0f;
+    vec2 derivative;
+    for (int c = 0; c < 3; ++c) {
+        // corners out of reach get a zero falloff rather than a branch
+        const vec2& d = corners[c];
+        const float falloff = std::max(0.5f - dot(d, d), 0.0f);
+        const vec2 g = detail::gradient2(hashes[c]);
+        const float gd = dot(g, d);
+        const float t2 = falloff * falloff;
+        const float t4 = t2 * t2;
+
+        value += t4 * gd;
+        derivative += d * (-8.0f * t2 * falloff * gd) + g * t4;
+    }
+
+    return vec3(value, derivative.x, derivative.y) * 99.0f;
+}
+
+/**
+ * Simplex noise with its analytic gradient: (value, d/dx, d/dy, d/dz), roughly in [-1, 1].
+ */
+inline vec4 simplexWithDerivative(const vec3& p, uint32_t seed = 0)
+{
+    const float F3 = 1.0f / 3.0f;
+    const float G3 = 1.0f / 6.0f;
+
+    const float s = (p.x + p.y + p.z) * F3;
+    const int i = detail::fastFloor(p.x + s);
+    const int j = detail::fastFloor(p.y + s);
+    const int k = detail::fastFloor(p.z + s);
+    const float t = static_cast<float>(i + j + k) * G3;
+    const vec3 x0 = p - vec3(static_cast<float>(i) - t, static_cast<float>(j) - t, static_cast<float>(k) - t);
+
+    // rank the components to find the simplex the point lies in
+    const int xy = x0.x >= x0.y, yz = x0.y >= x0.z, xz = x0.x >= x0.z;
+    const int i1 = xy & xz, j1 = (1 - xy) & yz, k1 = (1 - yz) & (1 - xz);
+    const int i2 = xy | xz, j2 = (1 - xy) | yz, k2 = (1 - yz) | (1 - xz);
+
+    const int steps[4][3] = { { 0, 0, 0 }, { i1, j1, k1 }, { i2, j2, k2 }, { 1, 1, 1 } };
+    const uint32_t xi = static_cast<uint32_t>(i) * detail::NOISE_PRIME_X;
+    const uint32_t yi = static_cast<uint32_t>(j) * detail::NOISE_PRIME_Y;
+    const uint32_t zi = static_cast<uint32_t>(k) * detail::NOISE_PRIME_Z;
+
+    float value = 0.0f;
+    vec3 derivative;
+    for (int c = 0; c < 4; ++c) {
+        const vec3 d = x0 - vec3(static_cast<float>(steps[c][0]), static_cast<float>(steps[c][1]), static_cast<float>(steps[c][2])) + vec3(G3 * static_cast<float>(c));
+        const float falloff = std::max(0.6f - dot(d, d), 0.0f);
+        const uint32_t h = detail::noiseHash(seed,
+                                             xi + (steps[c][0] ? detail::NOISE_PRIME_X : 0u),
+                                             yi + (steps[c][1] ? detail::NOISE_PRIME_Y : 0u),
+                                             zi + (steps[c][2] ? detail::NOISE_PRIME_Z : 0u));
+        const vec3 g = detail::gradient3(h);
+        const float gd = dot(g, d);
+        const float t2 = falloff * falloff;
+        const float t4 = t2 * t2;
+
+        value += t4 * gd;
+        derivative += d * (-8.0f * t2 * falloff * gd) + g * t4;
+    }
+
+    return vec4(value, derivative.x, derivative.y, derivative.z) * 32.0f;
+}
+
+/**
+ * Simplex noise with its analytic gradient, roughly in [-1, 1].
+ */
+inline noiseSample4 simplexWithDerivative(const vec4& p, uint32_t seed = 0)
+{
+    const float F4 = 0.30901699437f; // (sqrt(5) - 1) / 4
+    const float G4 = 0.13819660113f; // (5 - sqrt(5)) / 20
+    const uint32_t primes[4] = { detail::NOISE_PRIME_X, detail::NOISE_PRIME_Y, detail::NOISE_PRIME_Z, detail::NOISE_PRIME_W };
+
+    const float s = (p.x + p.y + p.z + p.w) * F4;
+    int cell[4];
+    for (int axis = 0; axis < 4; ++axis)
+        cell[axis] = detail::fastFloor(p[axis] + s);
+    const float t = static_cast<float>(cell[0] + cell[1] + cell[2] + cell[3]) * G4;
+
+    vec4 x0;
+    uint32_t base[4];
+    for (int axis = 0; axis < 4; ++axis) {
+        x0[axis] = p[axis] - (static_cast<float>(cell[axis]) - t);
+        base[axis] = static_cast<uint32_t>(cell[axis]) * primes[axis];
+    }
+
+    // rank the components; the simplex steps along the largest first
+    int rank[4] = { 0, 0, 0, 0 };
+    for (int a = 0; a < 3; ++a) {
+        for (int b = a + 1; b < 4; ++b) {
+            const int greater = x0[a] >= x0[b];
+            rank[a] += greater;
+            rank[b] += 1 - greater;
+        }
+    }
+
+    noiseSample4 result;
+    for (int c = 0; c < 5; ++c) {
+        uint32_t coords[4];
+        vec4 d;
+        for (int axis = 0; axis < 4; ++axis) {
+            const int step = rank[axis] >= 4 - c;
+            coords[axis] = base[axis] + (step ? primes[axis] : 0u);
+            d[axis] = x0[axis] - static_cast<float>(step) + G4 * static_cast<float>(c);
+        }
+
+        const float falloff = std::max(0.6f - dot(d, d), 0.0f);
+        const vec4 g = detail::gradient4(detail::noiseHash(seed, coords[0], coords[1], coords[2], coords[3]));
+        const float gd = dot(g, d);
+        const float t2 = falloff * falloff;
+        const float t4 = t2 * t2;
+
+        result.value += t4 * gd;
+        for (int axis = 0; axis < 4; ++axis)
+            result.derivative[axis] += d[axis] * (-8.0f * t2 * falloff * gd) + g[axis] * t4;
+    }
+
+    result.value *= 27.0f;
+    result.derivative *= 27.0f;
+    return result;
+}
+
+inline float simplex(const vec2& p, uint32_t seed = 0)
+{
+    return simplexWithDerivative(p, seed).x;
+}
+
+inline float simplex(const vec3& p, uint32_t seed = 0)
+{
+    return simplexWithDerivative(p, seed).x;
+}
+
+inline float simplex(const vec4& p, uint32_t seed = 0)
+{
+    return simplexWithDerivative(p, seed).value;
+}
+
+/**
+ * Fractal Brownian motion over Perlin noise.
+ *
+ * @param octaves The number of noise layers
+ * @param lacunarity Frequency multiplier between octaves
+ * @param gain Amplitude multiplier between octaves
+ */
+inline float fbm(const vec2& p, int octaves, float lacunarity = 2.0f, float gain = 0.5f, uint32_t seed = 0)
+{
+    float sum = 0.0f, amplitude = 1.0f, frequency = 1.0f;
+    for (int i = 0; i < octaves; ++i) {
+        sum += amplitude * perlin(p * frequency, seed + static_cast<uint32_t>(i));
+        frequency *= lacunarity;
+        amplitude *= gain;
+    }
+
+    return sum;
+}
+
+inline float fbm(const vec3& p, int octaves, float lacunarity = 2.0f, float gain = 0.5f, uint32_t seed = 0)
+{
+    float sum = 0.0f, amplitude = 1.0f, frequency = 1.0f;
+    for (int i = 0; i < octaves; ++i) {
+        sum += amplitude * perlin(p * frequency, seed + static_cast<uint32_t>(i));
+        frequency *= lacunarity;
+        amplitude *= gain;
+    }
+
+    return sum;
+}
+
+/**
+ * fBm with its analytic gradient: (value, d/dx, d/dy, d/dz).
+ */
+inline vec4 fbmWithDerivative(const vec3& p, int octaves, float lacunarity = 2.0f, float gain = 0.5f, uint32_t seed = 0)
+{
+    vec4 sum;
+    float amplitude = 1.0f, frequency = 1.0f;
+    for (int i = 0; i < octaves; ++i) {
+        const vec4 n = perlinWithDerivative(p * frequency, seed + static_cast<uint32_t>(i));
+        sum.x += amplitude * n.x;
+        sum.y += amplitude * frequency * n.y;
+        sum.z += amplitude * frequency * n.z;
+        sum.w += amplitude * frequency * n.w;
+        frequency *= lacunarity;
+        amplitude *= gain;
+    }
+
+    return sum;
+}
+
+/**
+ * Ridged multifractal: octaves of (1 - |noise|)^2, producing sharp crests.
+ */
+inline float ridged(const vec2& p, int octaves, float lacunarity = 2.0f, float gain = 0.5f, uint32_t seed = 0)
+{
+    float sum = 0.0f, amplitude = 1.0f, frequency = 1.0f;
+    for (int i = 0; i < octaves; ++i) {
+        const float n = 1.0f - std::abs(perlin(p * frequency, seed + static_cast<uint32_t>(i)));
+        sum += amplitude * n * n;
+        frequency *= lacunarity;
+        amplitude *= gain;
+    }
+
+    return sum;
+}
+
+inline float ridged(const vec3& p, int octaves, float lacunarity = 2.0f, float gain = 0.5f, uint32_t seed = 0)
+{
+    float sum = 0.0f, amplitude = 1.0f, frequency = 1.0f;
+    for (int i = 0; i < octaves; ++i) {
+        const float n = 1.0f - std::abs(perlin(p * frequency, seed + static_cast<uint32_t>(i)));
+        sum += amplitude * n * n;
+        frequency *= lacunarity;
+        amplitude *= gain;
+    }
+
+    return sum;
+}
+
+/**
+ * Evaluates Perlin noise at count points given as separate coordinate arrays.
+ *
+ * The structure-of-arrays layout keeps loads contiguous. The loop bodies are
+ * branch-free: corners are hashed instead of looked up in a permutation
+ * table, gradients come from small tables, and simplex corners out of reach
+ * are masked with a zero falloff instead of skipped.
+ */
+inline void perlin(const float* x, const float* y, float* out, std::size_t count, uint32_t seed = 0)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = detail::latticeNoise<true>(vec2(x[i], y[i]), seed).x;
+}
+
+inline void perlin(const float* x, const float* y, const float* z, float* out, std::size_t count, uint32_t seed = 0)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = detail::latticeNoise<true>(vec3(x[i], y[i], z[i]), seed).x;
+}
+
+inline void valueNoise(const float* x, const float* y, float* out, std::size_t count, uint32_t seed = 0)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = detail::latticeNoise<false>(vec2(x[i], y[i]), seed).x;
+}
+
+inline void valueNoise(const float* x, const float* y, const float* z, float* out, std::size_t count, uint32_t seed = 0)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = detail::latticeNoise<false>(vec3(x[i], y[i], z[i]), seed).x;
+}
+
+inline void simplex(const float* x, const float* y, float* out, std::size_t count, uint32_t seed = 0)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = simplexWithDerivative(vec2(x[i], y[i]), seed).x;
+}
+
+inline void simplex(const float* x, const float* y, const float* z, float* out, std::size_t count, uint32_t seed = 0)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = simplexWithDerivative(vec3(x[i], y[i], z[i]), seed).x;
+}
+
+/**
+ * Evaluates Perlin noise on a regular 3D grid, x-fastest.
+ *
+ * @param origin The position of the first sample
+ * @param spacing The distance between neighbouring samples
+ * @param out Receives sizeX * sizeY * sizeZ values
+ */
+inline void perlinGrid(const vec3& origin, float spacing, int sizeX, int sizeY, int sizeZ, float* out, uint32_t seed = 0)
+{
+    const std::size_t row = static_cast<std::size_t>(sizeX);
+    float xs[256], ys[256], zs[256];
+
+    for (int z = 0; z < sizeZ; ++z) {
+        for (int y = 0; y < sizeY; ++y) {
+            for (std::size_t first = 0; first < row; first += 256) {
+                const std::size_t n = std::min<std::size_t>(256, row - first);
+                for (std::size_t i = 0; i < n; ++i) {
+                    xs[i] = origin.x + static_cast<float>(first + i) * spacing;
+                    ys[i] = origin.y + static_cast<float>(y) * spacing;
+                    zs[i] = origin.z + static_cast<float>(z) * spacing;
+                }
+
+                float* dst = out + (static_cast<std::size_t>(z) * sizeY + y) * row + first;
+                perlin(xs, ys, zs, dst, n, seed);
+            }
+        }
+    }
+}
+
+/**
+ * Evaluates 2D fBm on a regular grid, x-fastest, e.g. for a terrain heightmap chunk.
+ */
+inline void fbmGrid(const vec2& origin, float spacing, int sizeX, int sizeY, int octaves, float* out, float lacunarity = 2.0f, float gain = 0.5f, uint32_t seed = 0)
+{
+    for (int y = 0; y < sizeY; ++y)
+        for (int x = 0; x < sizeX; ++x)
+            out[y * sizeX + x] = fbm(origin + vec2(static_cast<float>(x), static_cast<float>(y)) * spacing, octaves, lacunarity, gain, seed);
+}
+} // namespace lia
@@ -0,0 +1,449 @@
+#pragma once
+
+#include "mathbase.h"
+#include "mat4.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "vec4.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+
+namespace lia {
+namespace detail {
+    inline bool isDigitStart(char c)
+    {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
+    }
+
+    inline bool isLetter(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    inline bool isIdentifier(char c)
+    {
+        return isLetter(c) || (c >= '0' && c <= '9');
+    }
+
+    // whitespace, newlines and the punctuation of lists, tuples and lia's own output
+    inline bool isSeparator(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';' || c == '(' || c == ')' || c == '['
+            || c == ']' || c == '{' || c == '}';
+    }
+
+    // inf, infinity and nan in any case: identifiers that read as numbers
+    inline bool isNonFinite(const char* word, const char* end)
+    {
+        const auto is = [&](const char* name) {
+            const std::size_t length = std::strlen(name);
+            if (static_cast<std::size_t>(end - word) != length)
+                return false;
+            for (std::size_t i = 0; i < length; ++i) {
+                if ((word[i] | 0x20) != name[i])
+                    return false;
+            }
+            return true;
+        };
+
+        return is("inf") || is("infinity") || is("nan");
+    }
+
+    /**
+     * Parses one float at p, returning the end of the number or null. Uses
+     * std::from_chars where the library has it, strtof on a copy otherwise;
+     * both reject values that overflow to infinity or underflow to zero.
+     */
+    inline const char* parseFloat(const char* p, const char* end, float& value)
+    {
+        if (p < end && *p == '+')
+            ++p;
+#if defined(__cpp_lib_to_chars)
+        const std::from_chars_result result = std::from_chars(p, end, value);
+        return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+        char buffer[64];
+        std::size_t n = 0;
+        while (p + n < end && n < sizeof(buffer) - 1 && (isDigitStart(p[n]) || isIdentifier(p[n])))
+            ++n;
+        std::memcpy(buffer, p, n);
+        buffer[n] = '\0';
+
+        char* stop = nullptr;
+        errno = 0;
+        const float parsed = std::strtof(buffer, &stop);
+        if (stop == buffer || (errno == ERANGE && (std::isinf(parsed) || parsed == 0.0f)))
+            return nullptr;
+
+        value = parsed;
+        return p + (stop - buffer);
+#endif
+    }
+
+    // skips separators and identifiers such as the vec3 of vec3(1, 2, 3)
+    inline const char* skipToNumber(const char* p, const char* end)
+    {
+        while (p < end) {
+            if (isDigitStart(*p))
+                return p;
+
+            if (isLetter(*p)) {
+                const char* word = p;
+                while (p < end && isIdentifier(*p))
+                    ++p;
+                if (isNonFinite(word, p))
+                    return word;
+            } else if (isSeparator(*p)) {
+                ++p;
+            } else {
+                return nullptr;
+            }
+        }
+
+        return nullptr;
+    }
+
+    inline const char* lineEnd(const char* p, const char* end)
+    {
+        const void* newline = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+        return newline ? static_cast<const char*>(newline) : end;
+    }
+
+    inline bool readFloats(std::istream& stream, float* out, std::size_t n)
+    {
+        using traits = std::char_traits<char>;
+
+        char buffer[64];
+        for (std::size_t parsed = 0; parsed < n;) {
+            const int c = stream.peek();
+            if (c == traits::eof())
+                break;
+
+            const char ch = traits::to_char_type(c);
+            std::size_t length = 0;
+            if (isLetter(ch)) {
+                // an identifier, unless it is a word for infinity or NaN
+                while (stream.peek() != traits::eof() && isIdentifier(traits::to_char_type(stream.peek()))) {
+                    const char next = static_cast<char>(stream.get());
+                    if (length < sizeof(buffer))
+                        buffer[length++] = next;
+                }
+                if (!isNonFinite(buffer, buffer + length))
+                    continue;
+            } else if (isSeparator(ch)) {
+                stream.get();
+                continue;
+            } else if (!isDigitStart(ch)) {
+                break;
+            } else {
+                while (length < sizeof(buffer) && stream.peek() != traits::eof()) {
+                    const char next = traits::to_char_type(stream.peek());
+                    if (!isDigitStart(next) && !isIdentifier(next))
+                        break;
+                    buffer[length++] = static_cast<char>(stream.get());
+                }
+            }
+
+            if (!parseFloat(buffer, buffer + length, out[parsed++]))
+                break;
+            if (parsed == n)
+                return true;
+        }
+
+        stream.setstate(std::ios::failbit);
+        return false;
+    }
+} // namespace detail
+
+/**
+ * Reads n floats from [cursor, end), separated by whitespace, newlines or
+ * punctuation, and moves cursor past them. Identifiers are skipped, so the
+ * output of operator<< reads back.
+ *
+ * @return False on malformed or missing numbers, leaving cursor where it was
+ */
+inline bool parseFloats(const char*& cursor, const char* end, float* out, std::size_t n)
+{
+    const char* p = cursor;
+    for (std::size_t i = 0; i < n; ++i) {
+        p = detail::skipToNumber(p, end);
+        if (!p)
+            return false;
+
+        p = detail::parseFloat(p, end, out[i]);
+        if (!p)
+            return false;
+    }
+
+    cursor = p;
+    return true;
+}
+
+inline bool parse(const char*& cursor, const char* end, vec2& v)
+{
+    return parseFloats(cursor, end, &v.x, 2);
+}
+
+inline bool parse(const char*& cursor, const char* end, vec3& v)
+{
+    return parseFloats(cursor, end, &v.x, 3);
+}
+
+inline bool parse(const char*& cursor, const char* end, vec4& v)
+{
+    return parseFloats(cursor, end, &v.x, 4);
+}
+
+/**
+ * Sixteen values, row by row.
+ */
+inline bool parse(const char*& cursor, const char* end, mat4& m)
+{
+    float values[16];
+    if (!parseFloats(cursor, end, values, 16))
+        return false;
+
+    for (int i = 0; i < 16; ++i)
+        m(i / 4, i % 4) = values[i];
+
+    return true;
+}
+
+/**
+ * Reads count values of type T, e.g. a CSV column block of vec3.
+ *
+ * @return The number of values read before the first failure
+ */
+template <typename T>
+inline std::size_t parse(const char*& cursor, const char* end, T* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!parse(cursor, end, out[i]))
+            return i;
+    }
+
+    return count;
+}
+
+inline std::istream& operator>>(std::istream& stream, vec2& v)
+{
+    detail::readFloats(stream, &v.x, 2);
+    return stream;
+}
+
+inline std::istream& operator>>(std::istream& stream, vec3& v)
+{
+    detail::readFloats(stream, &v.x, 3);
+    return stream;
+}
+
+inline std::istream& operator>>(std::istream& stream, vec4& v)
+{
+    detail::readFloats(stream, &v.x, 4);
+    return stream;
+}
+
+inline std::istream& operator>>(std::istream& stream, mat4& m)
+{
+    float values[16];
+    if (detail::readFloats(stream, values, 16)) {
+        for (int i = 0; i < 16; ++i)
+            m(i / 4, i % 4) = values[i];
+    }
+
+    return stream;
+}
+
+/**
+ * Splits [data, data + size) into parts ranges that start at line starts, for
+ * loading the parts on separate threads.
+ *
+ * @param offsets Receives parts + 1 offsets; part i is [offsets[i], offsets[i + 1])
+ */
+inline void splitLines(const char* data, std::size_t size, std::size_t parts, std::vector<std::size_t>& offsets)
+{
+    offsets.assign(1, 0);
+    for (std::size_t i = 1; i < parts; ++i) {
+        std::size_t at = std::max(offsets.back(), size / parts * i);
+        if (at > 0 && at < size)
+            at = static_cast<std::size_t>(detail::lineEnd(data + at - 1, data + size) - data) + 1;
+        offsets.push_back(std::min(at, size));
+    }
+    offsets.push_back(size);
+}
+
+inline std::size_t countLines(const char* first, const char* last)
+{
+    std::size_t lines = 0;
+    for (const char* p = first; p < last; ++lines)
+        p = detail::lineEnd(p, last) + 1;
+
+    return lines;
+}
+
+struct objVertices {
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    std::vector<vec2> texcoords;
+
+    void clear()
+    {
+        positions.clear();
+        normals.clear();
+        texcoords.clear();
+    }
+
+    void append(const objVertices& other)
+    {
+        positions.insert(positions.end(), other.positions.begin(), other.positions.end());
+        normals.insert(normals.end(), other.normals.begin(), other.normals.end());
+        texcoords.insert(texcoords.end(), other.texcoords.begin(), other.texcoords.end());
+    }
+};
+
+/**
+ * Appends the v, vn and vt records of OBJ text; faces and everything else are
+ * skipped. Parts from splitLines load independently and append in order.
+ *
+ * @return False on a malformed vertex record
+ */
+inline bool loadObj(const char* first, const char* last, objVertices& out)
+{
+    for (const char* p = first; p < last;) {
+        const char* end = detail::lineEnd(p, last);
+        if (end - p >= 2 && p[0] == 'v') {
+            const char* cursor = p + 2;
+            if (p[1] == ' ' || p[1] == '\t') {
+                vec3 v;
+                if (!parse(cursor, end, v))
+                    return false;
+                out.positions.push_back(v);
+            } else if (p[1] == 'n') {
+                vec3 v;
+                if (!parse(cursor, end, v))
+                    return false;
+                out.normals.push_back(v);
+            } else if (p[1] == 't') {
+                vec2 v;
+                if (!parse(cursor, end, v))
+                    return false;
+                out.texcoords.push_back(v);
+            }
+        }
+        p = end + 1;
+    }
+
+    return true;
+}
+
+/**
+ * The vertex element of an ASCII PLY header.
+ */
+struct plyHeader {
+    std::size_t vertexCount { 0 };
+    std::size_t bodyOffset { 0 }; // the first vertex line
+    int propertyCount { 0 };
+    int position[3] { -1, -1, -1 };
+    int normal[3] { -1, -1, -1 };
+
+    /**
+     * @return False unless the text is ASCII PLY whose first element is the
+     * vertices, with scalar properties x, y and z
+     */
+    bool parse(const char* data, std::size_t size)
+    {
+        const char* last = data + size;
+        const char* p = data;
+        bool vertexElement = false;
+        bool format = false;
+        int elements = 0;
+        *this = plyHeader();
+
+        for (int line = 0; p < last; ++line) {
+            const char* end = detail::lineEnd(p, last);
+            const std::size_t length = static_cast<std::size_t>(end - p) - (end > p && end[-1] == '\r' ? 1 : 0);
+            const auto startsWith = [&](const char* prefix) {
+                const std::size_t n = std::strlen(prefix);
+                return length >= n && std::memcmp(p, prefix, n) == 0;
+            };
+
+            if (line == 0 && !startsWith("ply"))
+                return false;
+            if (startsWith("format "))
+                format = startsWith("format ascii ");
+            else if (startsWith("element ")) {
+                vertexElement = ++elements == 1 && startsWith("element vertex ");
+                if (vertexElement)
+                    vertexCount = static_cast<std::size_t>(std::strtoull(p + 15, nullptr, 10));
+            } else if (startsWith("property ") && vertexElement) {
+                if (startsWith("property list"))
+                    return false;
+
+                // the name is the last word
+                const char* name = p + length;
+                while (name > p && name[-1] != ' ')
+                    --name;
+                const std::string word(name, p + length);
+                const char* names[6] = { "x", "y", "z", "nx", "ny", "nz" };
+                for (int i = 0; i < 6; ++i) {
+                    if (word == names[i])
+                        (i < 3 ? position[i] : normal[i - 3]) = propertyCount;
+                }
+                ++propertyCount;
+            } else if (startsWith("end_header")) {
+                bodyOffset = static_cast<std::size_t>(std::min(end + 1, last) - data);
+                return format && vertexCount > 0 && position[0] >= 0 && position[1] >= 0 && position[2] >= 0 && propertyCount <= 64;
+            }
+
+            p = end + 1;
+        }
+
+        return false;
+    }
+};
+
+/**
+ * Appends the vertices on the lines of [first, last), which start at vertex
+ * firstVertex; lines past the vertex count are the faces and are ignored.
+ * For threads, split the body with splitLines and use countLines for each
+ * part's first vertex.
+ *
+ * @param normals Receives normals when not null and the file has them
+ * @return False on a malformed vertex line
+ */
+inline bool loadPly(const plyHeader& header, const char* first, const char* last, std::size_t firstVertex,
+                    std::vector<vec3>& positions, std::vector<vec3>* normals = nullptr)
+{
+    const bool withNormals = normals && header.normal[0] >= 0 && header.normal[1] >= 0 && header.normal[2] >= 0;
+    float values[64];
+
+    std::size_t vertex = firstVertex;
+    for (const char* p = first; p < last && vertex < header.vertexCount; ++vertex) {
+        const char* end = detail::lineEnd(p, last);
+        const char* cursor = p;
+        if (!parseFloats(cursor, end, values, static_cast<std::size_t>(header.propertyCount)))
+            return false;
+
+        positions.push_back(vec3(values[header.position[0]], values[header.position[1]], values[header.position[2]]));
+        if (withNormals)
+            normals->push_back(vec3(values[header.normal[0]], values[header.normal[1]], values[header.normal[2]]));
+        p = end + 1;
+    }
+
+    return true;
+}
+} // namespace lia
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "curves.h"
+#include "mathbase.h"
+#include "vec2.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lia {
+/**
+ * All functions in this file write into caller-provided buffers and return the
+ * number of elements the full result needs. When the buffer is too small only
+ * the first capacity elements are written, so a call with capacity 0 measures.
+ */
+
+namespace detail {
+    inline float cross2(const vec2& a, const vec2& b)
+    {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    inline void emit(vec2* out, std::size_t capacity, std::size_t& written, const vec2& p)
+    {
+        if (written < capacity)
+            out[written] = p;
+        ++written;
+    }
+
+    // closed-form approximations of the parabola arc-length integral and its inverse
+    inline float approxParabolaIntegral(float x)
+    {
+        const float d = 0.67f;
+        return x / (1.0f - d + std::sqrt(std::sqrt(d * d * d * d + 0.25f * x * x)));
+    }
+
+    inline float approxParabolaInvIntegral(float x)
+    {
+        const float b = 0.39f;
+        return x * (1.0f - b + std::sqrt(b * b + 0.25f * x * x));
+    }
+
+    // appends the flattened quadratic without its start point
+    inline void flattenQuadraticTail(const vec2& p0, const vec2& p1, const vec2& p2, float tolerance,
+                                     vec2* out, std::size_t capacity, std::size_t& written)
+    {
+        const vec2 dd = p1 * 2.0f - p0 - p2;
+        const float u0 = dot(p1 - p0, dd);
+        const float u2 = dot(p2 - p1, dd);
+        const float crossProduct = cross2(p2 - p0, dd);
+        const float x0 = u0 / crossProduct;
+        const float x2 = u2 / crossProduct;
+        const float scale = std::abs(crossProduct) / (magnitude(dd) * std::abs(x2 - x0));
+
+        const float a0 = approxParabolaIntegral(x0);
+        const float a2 = approxParabolaIntegral(x2);
+        const float sqrtTolerance = std::sqrt(tolerance);
+
+        float value = 0.0f;
+        if (std::isfinite(scale)) {
+            const float da = std::abs(a2 - a0);
+            const float sqrtScale = std::sqrt(scale);
+            if ((x0 < 0.0f) == (x2 < 0.0f)) {
+                value = da * sqrtScale;
+            } else {
+                // the curve passes the cusp of the parabola, bound by the tolerance there
+                const float xMin = sqrtTolerance / sqrtScale;
+                value = sqrtTolerance * da / approxParabolaIntegral(xMin);
+            }
+        }
+
+        const int n = std::max(1, static_cast<int>(std::ceil(0.5f * value / sqrtTolerance)));
+        if (n > 1) {
+            const float v0 = approxParabolaInvIntegral(a0);
+            const float v2 = approxParabolaInvIntegral(a2);
+            const float invRange = 1.0f / (v2 - v0);
+
+            for (int i = 1; i < n; ++i) {
+                const float a = a0 + (a2 - a0) * (static_cast<float>(i) / static_cast<float>(n));
+                const float t = (approxParabolaInvIntegral(a) - v0) * invRange;
+                const float mt = 1.0f - t;
+                emit(out, capacity, written, p0 * (mt * mt) + p1 * (2.0f * mt * t) + p2 * (t * t));
+            }
+        }
+
+        emit(out, capacity, written, p2);
+    }
+} // namespace detail
+
+/**
+ * Flattens a quadratic Bezier with the parabola-integral method (Levien 2019),
+ * which spaces points so that every chord is within tolerance of the curve
+ * using close to the minimum number of segments.
+ *
+ * @return The number of polyline points, start point included
+ */
+inline std::size_t flattenQuadratic(const vec2& p0, const vec2& p1, const vec2& p2, float tolerance, vec2* out, std::size_t capacity)
+{
+    std::size_t written = 0;
+    detail::emit(out, capacity, written, p0);
+    detail::flattenQuadraticTail(p0, p1, p2, tolerance, out, capacity, written);
+
+    return written;
+}
+
+/**
+ * Flattens a cubic Bezier by approximating it with quadratics within a tenth of
+ * the tolerance, then flattening those with the remaining budget.
+ *
+ * @return The number of polyline points, start point included
+ */
+inline std::size_t flattenCubic(const vec2& p0, const vec2& p1, const vec2& p2, const vec2& p3, float tolerance, vec2* out, std::size_t capacity)
+{
+    const float quadTolerance = 0.1f * tolerance;
+
+    // error of approximating with n quadratics is |p3 - 3 p2 + 3 p1 - p0| * sqrt(3) / 36 / n^3
+    const vec2 third = p3 - p2 * 3.0f + p1 * 3.0f - p0;
+    const float errorSq = dot(third, third) * (1.0f / 432.0f);
+    const int n = std::max(1, static_cast<int>(std::ceil(fpow(errorSq / (quadTolerance * quadTolerance), 1.0f / 6.0f))));
+
+    const cubicCurve<vec2> curve = bezierCurve(p0, p1, p2, p3);
+    const float dt = 1.0f / static_cast<float>(n);
+
+    std::size_t written = 0;
+    detail::emit(out, capacity, written, p0);
+
+    vec2 start = p0;
+    for (int i = 0; i < n; ++i) {
+        const float t0 = static_cast<float>(i) * dt;
+        const float t1 = i + 1 == n ? 1.0f : t0 + dt;
+        const vec2 end = curve.position(t1);
+
+        // quadratic through the sub-cubic: control at (3 (q1 + q2) - q0 - q3) / 4
+        const vec2 q1 = start + curve.tangent(t0) * (dt / 3.0f);
+        const vec2 q2 = end - curve.tangent(t1) * (dt / 3.0f);
+        const vec2 control = ((q1 + q2) * 3.0f - start - end) * 0.25f;
+
+        detail::flattenQuadraticTail(start, control, end, tolerance - quadTolerance, out, capacity, written);
+        start = end;
+    }
+
+    return written;
+}
+
+enum class lineJoin {
+    miter,
+    bevel,
+    round
+};
+
+enum class lineCap {
+    butt,
+    square,
+    round
+};
+
+struct strokeStyle {
+    float width { 1.0f };
+    lineJoin join { lineJoin::miter };
+    lineCap cap { lineCap::butt };
+    float miterLimit { 4.0f };
+    float tolerance { 0.25f }; // maximum deviation of round joins and caps from the true arc
+    bool closed { false };
+};
+
+namespace detail {
+    inline void emitTriangle(vec2* out, std::size_t capacity, std::size_t& written, const vec2& a, const vec2& b, const vec2& c)
+    {
+        emit(out, capacity, written, a);
+        emit(out, capacity, written, b);
+        emit(out, capacity, written, c);
+    }
+
+    // triangle fan around center sweeping from the offset `from` to `to` through the shorter arc
+    inline void emitArc(vec2* out, std::size_t capacity, std::size_t& written, const vec2& center, const vec2& from, float angle, float radius, float tolerance)
+    {
+        const float step = 2.0f * facos(std::max(-1.0f, 1.0f - tolerance / radius));
+        const int segments = std::max(1, static_cast<int>(std::ceil(std::abs(angle) / std::max(step, 1e-3f))));
+        const float delta = angle / static_cast<float>(segments);
+
+        vec2 previous = from;
+        for (int i = 1; i <= segments; ++i) {
+            const vec2 next = rotatePoint(delta * static_cast<float>(i), center + from, center) - center;
+            emitTriangle(out, capacity, written, center, center + previous, center + next);
+            previous = next;
+        }
+    }
+} // namespace detail
+
+/**
+ * Strokes a polyline into a triangle list (three vec2 per triangle).
+ * Consecutive points must be distinct.
+ *
+ * @return The number of vertices of the stroke
+ */
+inline std::size_t strokePolyline(const vec2* points, std::size_t count, const strokeStyle& style, vec2* out, std::size_t capacity)
+{
+    std::size_t written = 0;
+    if (count < 2)
+        return written;
+
+    const float hw = style.width * 0.5f;
+    const std::size_t segments = style.closed ? count : count - 1;
+
+    auto direction = [&](std::size_t segment) {
+        return normalize(points[(segment + 1) % count] - points[segment]);
+    };
+
+    for (std::size_t s = 0; s < segments; ++s) {
+        const vec2& a = points[s];
+        const vec2& b = points[(s + 1) % count];
+        const vec2 d = direction(s);
+        const vec2 n = vec2(-d.y, d.x) * hw;
+
+        vec2 start = a, end = b;
+        if (!style.closed && style.cap == lineCap::square) {
+            if (s == 0)
+                start -= d * hw;
+            if (s + 1 == segments)
+                end += d * hw;
+        }
+
+        detail::emitTriangle(out, capacity, written, start + n, start - n, end + n);
+        detail::emitTriangle(out, capacity, written, end + n, start - n, end - n);
+
+        // join with the next segment
+        if (s + 1 == segments && !style.closed)
+            break;
+
+        const vec2 nextD = direction((s + 1) % segments);
+        const float turn = detail::cross2(d, nextD);
+        if (std::abs(turn) < 1e-6f && dot(d, nextD) > 0.0f)
+            continue;
+
+        // the outer side of the turn is opposite to the turn direction
+        const float side = turn > 0.0f ? -1.0f : 1.0f;
+        const vec2 from = vec2(-d.y, d.x) * (hw * side);
+        const vec2 to = vec2(-nextD.y, nextD.x) * (hw * side);
+
+        switch (style.join) {
+        case lineJoin::round:
+            detail::emitArc(out, capacity, written, b, from, fatan2(detail::cross2(from, to), dot(from, to)), hw, style.tolerance);
+            break;
+        case lineJoin::miter: {
+            const vec2 bisector = from + to;
+            const float cosHalf = magnitude(bisector) / (2.0f * hw);
+            if (cosHalf > 1e-6f && 1.0f / cosHalf <= style.miterLimit) {
+                const vec2 tip = b + normalize(bisector) * (hw / cosHalf);
+                detail::emitTriangle(out, capacity, written, b + from, tip, b + to);
+            }
+            detail::emitTriangle(out, capacity, written, b, b + from, b + to);
+            break;
+        }
+        default:
+            detail::emitTriangle(out, capacity, written, b, b + from, b + to);
+            break;
+        }
+    }
+
+    if (!style.closed && style.cap == lineCap::round) {
+        const vec2 d0 = direction(0);
+        const vec2 d1 = direction(count - 2);
+        const float pi = static_cast<float>(PI);
+        detail::emitArc(out, capacity, written, points[0], vec2(d0.y, -d0.x) * hw, -pi, hw, style.tolerance);
+        detail::emitArc(out, capacity, written, points[count - 1], vec2(-d1.y, d1.x) * hw, -pi, hw, style.tolerance);
+    }
+
+    return written;
+}
+
+namespace detail {
+    inline bool pointInTriangle(const vec2& p, const vec2& a, const vec2& b, const vec2& c)
+    {
+        return cross2(b - a, p - a) >= 0.0f && cross2(c - b, p - b) >= 0.0f && cross2(a - c, p - c) >= 0.0f;
+    }
+} // namespace detail
+
+/**
+ * Triangulates a simple polygon (either winding) by ear clipping.
+ *
+ * @param indices Receives 3 * (count - 2) vertex indices
+ * @param scratch Workspace of count entries
+ * @return The number of indices written
+ */
+inline std::size_t triangulate(const vec2* polygon, std::size_t count, uint32_t* indices, uint32_t* scratch)
+{
+    if (count < 3)
+        return 0;
+
+    float area = 0.0f;
+    for (std::size_t i = 0, j = count - 1; i < count; j = i++)
+        area += detail::cross2(polygon[j], polygon[i]);
+
+    // work on a counter-clockwise vertex order
+    for (std::size_t i = 0; i < count; ++i)
+        scratch[i] = static_cast<uint32_t>(area > 0.0f ? i : count - 1 - i);
+
+    std::size_t remaining = count;
+    std::size_t written = 0;
+    std::size_t current = 0;
+    std::size_t attempts = 0;
+
+    while (remaining > 3) {
+        const std::size_t prev = (current + remaining - 1) % remaining;
+        const std::size_t next = (current + 1) % remaining;
+        const vec2& a = polygon[scratch[prev]];
+        const vec2& b = polygon[scratch[current]];
+        const vec2& c = polygon[scratch[next]];
+
+        bool ear = detail::cross2(b - a, c - b) > 0.0f;
+        for (std::size_t k = 0; ear && k < remaining; ++k) {
+            if (k == prev || k == current || k == next)
+                continue;
+
+            const vec2& p = polygon[scratch[k]];
+            ear = !detail::pointInTriangle(p, a, b, c);
+        }
+
+        // a degenerate or self-intersecting input has no ears left; clip anyway to terminate
+        if (ear || attempts >= remaining) {
+            indices[written++] = scratch[prev];
+            indices[written++] = scratch[current];
+            indices[written++] = scratch[next];
+
+            for (std::size_t k = current; k + 1 < remaining; ++k)
+                scratch[k] = scratch[k + 1];
+            --remaining;
+
+            current = current % remaining;
+            attempts = 0;
+        } else {
+            current = next;
+            ++attempts;
+        }
+    }
+
+    indices[written++] = scratch[0];
+    indices[written++] = scratch[1];
+    indices[written++] = scratch[2];
+
+    return written;
+}
+} // namespace lia
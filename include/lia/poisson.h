@@ -0,0 +1,449 @@
+#pragma once
+
+#include "mathbase.h"
+#include "random.h"
+#include "sampling.h"
+#include "vec2.h"
+#include "vec3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lia {
+namespace detail {
+    template <typename T>
+    struct pointTraits;
+
+    template <>
+    struct pointTraits<vec2> {
+        static constexpr int dimension = 2;
+
+        // uniform by area in the annulus between r and 2r
+        static vec2 annulus(pcg32& rng, float r)
+        {
+            const float angle = static_cast<float>(TAU) * toUnitFloat(rng.next());
+            const float distance = r * std::sqrt(1.0f + 3.0f * toUnitFloat(rng.next()));
+            return vec2(distance * fcos(angle), distance * fsin(angle));
+        }
+
+        static vec2 uniform(pcg32& rng, const vec2& lower, const vec2& upper)
+        {
+            return vec2(lower.x + (upper.x - lower.x) * toUnitFloat(rng.next()),
+                lower.y + (upper.y - lower.y) * toUnitFloat(rng.next()));
+        }
+    };
+
+    template <>
+    struct pointTraits<vec3> {
+        static constexpr int dimension = 3;
+
+        // uniform by volume in the shell between r and 2r
+        static vec3 annulus(pcg32& rng, float r)
+        {
+            const vec3 direction = sampleSphere(vec2(toUnitFloat(rng.next()), toUnitFloat(rng.next())));
+            return direction * (r * fcbrt(1.0f + 7.0f * toUnitFloat(rng.next())));
+        }
+
+        static vec3 uniform(pcg32& rng, const vec3& lower, const vec3& upper)
+        {
+            return vec3(lower.x + (upper.x - lower.x) * toUnitFloat(rng.next()),
+                lower.y + (upper.y - lower.y) * toUnitFloat(rng.next()),
+                lower.z + (upper.z - lower.z) * toUnitFloat(rng.next()));
+        }
+    };
+
+    template <typename T>
+    inline bool insideBox(const T& p, const T& lower, const T& upper)
+    {
+        for (int d = 0; d < pointTraits<T>::dimension; ++d) {
+            if (p[d] < lower[d] || p[d] >= upper[d])
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Bucketed uniform grid for fixed-radius neighbour queries over a point array.
+     * Cells are hashed into a table, so memory follows the point count rather than the extent.
+     */
+    template <typename T>
+    struct spatialHash {
+        const T* points;
+        float inverseCell;
+        uint32_t mask;
+        std::vector<uint32_t> bucketStart;
+        std::vector<uint32_t> items;
+        std::vector<uint64_t> itemCells;
+
+        spatialHash(const T* points, std::size_t count, float cellSize)
+            : points(points)
+            , inverseCell(1.0f / cellSize)
+        {
+            uint32_t size = 1;
+            while (size < 2 * count)
+                size <<= 1;
+            mask = size - 1;
+
+            std::vector<uint64_t> cells(count);
+            bucketStart.assign(size + 1, 0);
+            for (std::size_t i = 0; i < count; ++i) {
+                cells[i] = cellKey(points[i], 0, 0, 0);
+                ++bucketStart[bucket(cells[i]) + 1];
+            }
+            for (uint32_t b = 0; b < size; ++b)
+                bucketStart[b + 1] += bucketStart[b];
+
+            std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+            items.resize(count);
+            itemCells.resize(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const uint32_t slot = fill[bucket(cells[i])]++;
+                items[slot] = static_cast<uint32_t>(i);
+                itemCells[slot] = cells[i];
+            }
+        }
+
+        uint64_t cellKey(const T& p, int dx, int dy, int dz) const
+        {
+            uint64_t key = 0;
+            const int offsets[3] = { dx, dy, dz };
+            for (int d = 0; d < pointTraits<T>::dimension; ++d) {
+                const int64_t c = static_cast<int64_t>(std::floor(p[d] * inverseCell)) + offsets[d];
+                key |= (static_cast<uint64_t>(c) & 0x1FFFFFu) << (21 * d);
+            }
+
+            return key;
+        }
+
+        uint32_t bucket(uint64_t key) const
+        {
+            key ^= key >> 33;
+            key *= 0xFF51AFD7ED558CCDull;
+            key ^= key >> 33;
+            return static_cast<uint32_t>(key) & mask;
+        }
+
+        // calls visit(index) for every point in the cells around p, at most one cell away
+        template <typename Visitor>
+        void query(const T& p, Visitor visit) const
+        {
+            const int reachZ = pointTraits<T>::dimension == 3 ? 1 : 0;
+            for (int dz = -reachZ; dz <= reachZ; ++dz) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        const uint64_t key = cellKey(p, dx, dy, dz);
+                        const uint32_t b = bucket(key);
+                        for (uint32_t slot = bucketStart[b]; slot < bucketStart[b + 1]; ++slot) {
+                            if (itemCells[slot] == key)
+                                visit(items[slot]);
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    // Bridson's algorithm on a dense background grid of cell r / sqrt(d), holding at most one sample per cell
+    template <typename T>
+    inline void bridson(const T& lower, const T& upper, float radius, uint32_t seed, const T* existing, std::size_t existingCount, int attempts, std::vector<T>& out)
+    {
+        const int dimension = pointTraits<T>::dimension;
+        const float cell = radius / std::sqrt(static_cast<float>(dimension));
+        const float inverseCell = 1.0f / cell;
+        const float radiusSquared = radius * radius;
+
+        // the grid reaches one radius past the box so existing points just outside are seen
+        int size[3] = { 1, 1, 1 };
+        float origin[3] = { 0.0f, 0.0f, 0.0f };
+        std::size_t cellCount = 1;
+        for (int d = 0; d < dimension; ++d) {
+            origin[d] = lower[d] - radius;
+            size[d] = std::max(1, static_cast<int>(std::ceil((upper[d] - lower[d] + 2.0f * radius) / cell)));
+            cellCount *= static_cast<std::size_t>(size[d]);
+        }
+
+        std::vector<int32_t> grid(cellCount, -1);
+        std::vector<T> samples;
+        std::vector<uint32_t> active;
+
+        const auto cellOf = [&](const T& p, int (&c)[3]) {
+            c[0] = c[1] = c[2] = 0;
+            for (int d = 0; d < dimension; ++d)
+                c[d] = std::min(size[d] - 1, std::max(0, static_cast<int>((p[d] - origin[d]) * inverseCell)));
+        };
+        const auto cellIndex = [&](const int (&c)[3]) {
+            return (static_cast<std::size_t>(c[2]) * size[1] + c[1]) * size[0] + c[0];
+        };
+
+        const auto fits = [&](const T& p) {
+            int c[3];
+            cellOf(p, c);
+            int from[3], to[3];
+            for (int d = 0; d < 3; ++d) {
+                from[d] = d < dimension ? std::max(0, c[d] - 2) : 0;
+                to[d] = d < dimension ? std::min(size[d] - 1, c[d] + 2) : 0;
+            }
+
+            // cells two steps away on every axis are at least radius away and skipped
+            int n[3];
+            for (n[2] = from[2]; n[2] <= to[2]; ++n[2]) {
+                for (n[1] = from[1]; n[1] <= to[1]; ++n[1]) {
+                    const int32_t* row = grid.data() + cellIndex(n) - n[0];
+                    const bool outerRow = std::abs(n[1] - c[1]) == 2 && (dimension == 2 || std::abs(n[2] - c[2]) == 2);
+                    for (n[0] = from[0]; n[0] <= to[0]; ++n[0]) {
+                        const int32_t s = row[n[0]];
+                        if (s < 0 || (outerRow && std::abs(n[0] - c[0]) == 2))
+                            continue;
+
+                        const T delta = samples[s] - p;
+                        if (dot(delta, delta) < radiusSquared)
+                            return false;
+                    }
+                }
+            }
+
+            return true;
+        };
+
+        const auto add = [&](const T& p) {
+            int c[3];
+            cellOf(p, c);
+            grid[cellIndex(c)] = static_cast<int32_t>(samples.size());
+            samples.push_back(p);
+        };
+
+        T reachLower = lower, reachUpper = upper;
+        for (int d = 0; d < dimension; ++d) {
+            reachLower[d] -= radius;
+            reachUpper[d] += radius;
+        }
+
+        for (std::size_t i = 0; i < existingCount; ++i) {
+            if (insideBox(existing[i], reachLower, reachUpper) && fits(existing[i]))
+                add(existing[i]);
+        }
+
+        const std::size_t firstNew = samples.size();
+        pcg32 rng(seed);
+
+        for (int k = 0; k < attempts && active.empty(); ++k) {
+            const T p = pointTraits<T>::uniform(rng, lower, upper);
+            if (fits(p)) {
+                active.push_back(static_cast<uint32_t>(samples.size()));
+                add(p);
+            }
+        }
+
+        while (!active.empty()) {
+            const std::size_t pick = rng.next() % active.size();
+            const T center = samples[active[pick]];
+
+            bool found = false;
+            for (int k = 0; k < attempts; ++k) {
+                const T p = center + pointTraits<T>::annulus(rng, radius);
+                if (insideBox(p, lower, upper) && fits(p)) {
+                    active.push_back(static_cast<uint32_t>(samples.size()));
+                    add(p);
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found) {
+                active[pick] = active.back();
+                active.pop_back();
+            }
+        }
+
+        out.insert(out.end(), samples.begin() + static_cast<std::ptrdiff_t>(firstNew), samples.end());
+    }
+} // namespace detail
+
+/**
+ * Poisson-disk samples in a box with Bridson's algorithm: no two samples are
+ * closer than radius and no more fit. Replaces out.
+ *
+ * @param attempts Candidates tried around each sample before it retires
+ */
+inline void poissonDisk(const vec2& lower, const vec2& upper, float radius, uint32_t seed, std::vector<vec2>& out, int attempts = 30)
+{
+    out.clear();
+    detail::bridson<vec2>(lower, upper, radius, seed, nullptr, 0, attempts, out);
+}
+
+inline void poissonDisk(const vec3& lower, const vec3& upper, float radius, uint32_t seed, std::vector<vec3>& out, int attempts = 30)
+{
+    out.clear();
+    detail::bridson<vec3>(lower, upper, radius, seed, nullptr, 0, attempts, out);
+}
+
+/**
+ * Poisson-disk sampling that also keeps its distance to existing samples, e.g.
+ * those of neighbouring regions generated earlier. Appends only the new samples to out.
+ */
+inline void poissonDisk(const vec2& lower, const vec2& upper, float radius, uint32_t seed, const vec2* existing, std::size_t existingCount, std::vector<vec2>& out, int attempts = 30)
+{
+    detail::bridson<vec2>(lower, upper, radius, seed, existing, existingCount, attempts, out);
+}
+
+inline void poissonDisk(const vec3& lower, const vec3& upper, float radius, uint32_t seed, const vec3* existing, std::size_t existingCount, std::vector<vec3>& out, int attempts = 30)
+{
+    detail::bridson<vec3>(lower, upper, radius, seed, existing, existingCount, attempts, out);
+}
+
+/**
+ * Seamless Poisson-disk sampling of an unbounded plane in square tiles, for
+ * streaming large terrains and generating tiles in parallel.
+ *
+ * Tiles fall into four phases by the parity of their coordinates. Tiles of one
+ * phase never touch, so all of them can be generated at once; run phase 0,
+ * then 1, 2 and 3, passing each tile the samples of its already generated
+ * neighbours. Every tile is seeded from its coordinates, so the result does
+ * not depend on the thread count or the order within a phase.
+ */
+struct poissonTiling {
+    float tileSize { 64.0f }; // must be at least radius
+    float radius { 1.0f };
+    uint32_t seed { 0 };
+    int attempts { 30 };
+
+    static int phase(int tileX, int tileY)
+    {
+        return (tileX & 1) | (tileY & 1) << 1;
+    }
+
+    vec2 tileMin(int tileX, int tileY) const
+    {
+        return vec2(static_cast<float>(tileX) * tileSize, static_cast<float>(tileY) * tileSize);
+    }
+
+    /**
+     * Appends the samples of one tile to out.
+     *
+     * @param neighbours Samples of the neighbouring tiles of earlier phases; only those within radius of the tile matter
+     */
+    void generate(int tileX, int tileY, const vec2* neighbours, std::size_t neighbourCount, std::vector<vec2>& out) const
+    {
+        const vec2 lower = tileMin(tileX, tileY);
+        const vec2 upper = lower + vec2(tileSize, tileSize);
+        const uint32_t tileSeed = detail::hashCombine(detail::hashCombine(seed, static_cast<uint32_t>(tileX)), static_cast<uint32_t>(tileY));
+
+        poissonDisk(lower, upper, radius, tileSeed, neighbours, neighbourCount, out, attempts);
+    }
+};
+
+/**
+ * Weighted sample elimination (Yuksel 2015): reduces a dense candidate set,
+ * e.g. uniform random points on a mesh, to target samples with blue-noise
+ * spacing by repeatedly removing the most crowded sample.
+ *
+ * Works on vec2 in the plane and on vec3 for points on surfaces; both use the
+ * planar packing density, with area the area of the sampled domain or surface.
+ * Candidates should outnumber the target by 3-5x.
+ *
+ * @param out Receives target samples in candidate order
+ * @return The number of samples written
+ */
+template <typename T>
+inline std::size_t eliminateSamples(const T* candidates, std::size_t count, std::size_t target, float area, T* out)
+{
+    if (target >= count) {
+        std::copy(candidates, candidates + count, out);
+        return count;
+    }
+
+    const float maxRadius = std::sqrt(area / (2.0f * std::sqrt(3.0f) * static_cast<float>(target)));
+    const float minRadius = maxRadius * 0.65f * (1.0f - fpow(static_cast<float>(target) / static_cast<float>(count), 1.5f));
+    const float reach = 2.0f * maxRadius;
+
+    // neighbour lists with their weights, in compressed rows
+    const detail::spatialHash<T> hash(candidates, count, reach);
+    std::vector<uint32_t> rowStart(count + 1, 0);
+    std::vector<uint32_t> neighbours;
+    std::vector<float> weights;
+    std::vector<float> totals(count, 0.0f);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const T& p = candidates[i];
+        hash.query(p, [&](uint32_t j) {
+            if (j == i)
+                return;
+
+            const T delta = candidates[j] - p;
+            const float distance = std::sqrt(dot(delta, delta));
+            if (distance >= reach)
+                return;
+
+            // (1 - d / reach)^8, the exponent the paper recommends
+            float w = 1.0f - std::max(distance, 2.0f * minRadius) / reach;
+            w *= w;
+            w *= w;
+            w *= w;
+            neighbours.push_back(j);
+            weights.push_back(w);
+            totals[i] += w;
+        });
+        rowStart[i + 1] = static_cast<uint32_t>(neighbours.size());
+    }
+
+    // max-heap on the total weights, tracking positions so weights can decrease in place
+    std::vector<uint32_t> heap(count);
+    std::vector<uint32_t> position(count);
+    for (std::size_t i = 0; i < count; ++i)
+        heap[i] = static_cast<uint32_t>(i);
+
+    std::size_t heapSize = count;
+    const auto place = [&](std::size_t slot, uint32_t item) {
+        heap[slot] = item;
+        position[item] = static_cast<uint32_t>(slot);
+    };
+    const auto siftDown = [&](std::size_t slot) {
+        const uint32_t item = heap[slot];
+        for (;;) {
+            std::size_t child = 2 * slot + 1;
+            if (child >= heapSize)
+                break;
+            if (child + 1 < heapSize && totals[heap[child + 1]] > totals[heap[child]])
+                ++child;
+            if (totals[heap[child]] <= totals[item])
+                break;
+            place(slot, heap[child]);
+            slot = child;
+        }
+        place(slot, item);
+    };
+
+    for (std::size_t slot = count / 2; slot-- > 0;)
+        siftDown(slot);
+    for (std::size_t slot = 0; slot < count; ++slot)
+        position[heap[slot]] = static_cast<uint32_t>(slot);
+
+    std::vector<uint8_t> removed(count, 0);
+    while (heapSize > target) {
+        const uint32_t top = heap[0];
+        removed[top] = 1;
+        place(0, heap[--heapSize]);
+        siftDown(0);
+
+        for (uint32_t k = rowStart[top]; k < rowStart[top + 1]; ++k) {
+            const uint32_t j = neighbours[k];
+            if (removed[j])
+                continue;
+            totals[j] -= weights[k];
+            siftDown(position[j]);
+        }
+    }
+
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!removed[i])
+            out[written++] = candidates[i];
+    }
+
+    return written;
+}
+} // namespace lia
@@ -0,0 +1,432 @@
+#pragma once
+
+#include "mathbase.h"
+#include "vec2.h"
+#include "vec3.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lia {
+namespace detail {
+    /**
+     * Exact floating-point expansion (Shewchuk 1997): the represented value is
+     * the exact sum of nonoverlapping components sorted by increasing magnitude.
+     *
+     * Only used on the rare exact path of the predicates, so it favours short
+     * code over the allocation-free staged evaluation.
+     */
+    struct expansion {
+        std::vector<double> components;
+
+        expansion() = default;
+
+        expansion(double value)
+        {
+            if (value != 0.0)
+                components.push_back(value);
+        }
+
+        int sign() const
+        {
+            if (components.empty())
+                return 0;
+
+            return components.back() > 0.0 ? 1 : -1;
+        }
+
+        double estimate() const
+        {
+            double sum = 0.0;
+            for (double c : components)
+                sum += c;
+
+            return sum;
+        }
+    };
+
+    inline void twoSum(double a, double b, double& x, double& y)
+    {
+        x = a + b;
+        const double bVirtual = x - a;
+        const double aVirtual = x - bVirtual;
+        y = (a - aVirtual) + (b - bVirtual);
+    }
+
+    inline void fastTwoSum(double a, double b, double& x, double& y)
+    {
+        x = a + b;
+        y = b - (x - a);
+    }
+
+    inline void twoProduct(double a, double b, double& x, double& y)
+    {
+        x = a * b;
+        y = std::fma(a, b, -x);
+    }
+
+    inline expansion growExpansion(const expansion& e, double b)
+    {
+        expansion h;
+        double q = b;
+        for (double component : e.components) {
+            double sum, error;
+            twoSum(q, component, sum, error);
+            if (error != 0.0)
+                h.components.push_back(error);
+            q = sum;
+        }
+
+        if (q != 0.0)
+            h.components.push_back(q);
+
+        return h;
+    }
+
+    inline expansion operator+(const expansion& e, const expansion& f)
+    {
+        expansion h = e;
+        for (double component : f.components)
+            h = growExpansion(h, component);
+
+        return h;
+    }
+
+    inline expansion operator-(const expansion& e)
+    {
+        expansion h = e;
+        for (double& component : h.components)
+            component = -component;
+
+        return h;
+    }
+
+    inline expansion operator-(const expansion& e, const expansion& f)
+    {
+        return e + (-f);
+    }
+
+    inline expansion scaleExpansion(const expansion& e, double b)
+    {
+        expansion h;
+        if (e.components.empty() || b == 0.0)
+            return h;
+
+        double q, error;
+        twoProduct(e.components[0], b, q, error);
+        if (error != 0.0)
+            h.components.push_back(error);
+
+        for (std::size_t i = 1; i < e.components.size(); ++i) {
+            double product1, product0, sum;
+            twoProduct(e.components[i], b, product1, product0);
+            twoSum(q, product0, sum, error);
+            if (error != 0.0)
+                h.components.push_back(error);
+            fastTwoSum(product1, sum, q, error);
+            if (error != 0.0)
+                h.components.push_back(error);
+        }
+
+        if (q != 0.0)
+            h.components.push_back(q);
+
+        return h;
+    }
+
+    inline expansion operator*(const expansion& e, const expansion& f)
+    {
+        expansion h;
+        for (double component : f.components)
+            h = h + scaleExpansion(e, component);
+
+        return h;
+    }
+
+    // Shewchuk's error bound coefficients for the first, floating-point stage
+    constexpr double PREDICATE_EPSILON = 1.1102230246251565e-16; // 2^-53
+    constexpr double ORIENT2D_BOUND = (3.0 + 16.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+    constexpr double ORIENT3D_BOUND = (7.0 + 56.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+    constexpr double INCIRCLE_BOUND = (10.0 + 96.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+    constexpr double INSPHERE_BOUND = (16.0 + 224.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+
+    /*
+     * The determinants are written once over the number type T: instantiated
+     * with double they are the filter estimate, with expansion they are exact.
+     * Differences are taken inside T so the exact path sees exact differences.
+     */
+    template <typename T>
+    inline T orient2dDeterminant(const vec2& a, const vec2& b, const vec2& c)
+    {
+        const T acx = T(a.x) - T(c.x), acy = T(a.y) - T(c.y);
+        const T bcx = T(b.x) - T(c.x), bcy = T(b.y) - T(c.y);
+
+        return acx * bcy - acy * bcx;
+    }
+
+    template <typename T>
+    inline T orient3dDeterminant(const vec3& a, const vec3& b, const vec3& c, const vec3& d)
+    {
+        const T adx = T(a.x) - T(d.x), ady = T(a.y) - T(d.y), adz = T(a.z) - T(d.z);
+        const T bdx = T(b.x) - T(d.x), bdy = T(b.y) - T(d.y), bdz = T(b.z) - T(d.z);
+        const T cdx = T(c.x) - T(d.x), cdy = T(c.y) - T(d.y), cdz = T(c.z) - T(d.z);
+
+        return adz * (bdx * cdy - cdx * bdy) + bdz * (cdx * ady - adx * cdy) + cdz * (adx * bdy - bdx * ady);
+    }
+
+    template <typename T>
+    inline T incircleDeterminant(const vec2& a, const vec2& b, const vec2& c, const vec2& d)
+    {
+        const T adx = T(a.x) - T(d.x), ady = T(a.y) - T(d.y);
+        const T bdx = T(b.x) - T(d.x), bdy = T(b.y) - T(d.y);
+        const T cdx = T(c.x) - T(d.x), cdy = T(c.y) - T(d.y);
+
+        const T alift = adx * adx + ady * ady;
+        const T blift = bdx * bdx + bdy * bdy;
+        const T clift = cdx * cdx + cdy * cdy;
+
+        return alift * (bdx * cdy - cdx * bdy) + blift * (cdx * ady - adx * cdy) + clift * (adx * bdy - bdx * ady);
+    }
+
+    template <typename T>
+    inline T insphereDeterminant(const vec3& a, const vec3& b, const vec3& c, const vec3& d, const vec3& e)
+    {
+        const T aex = T(a.x) - T(e.x), aey = T(a.y) - T(e.y), aez = T(a.z) - T(e.z);
+        const T bex = T(b.x) - T(e.x), bey = T(b.y) - T(e.y), bez = T(b.z) - T(e.z);
+        const T cex = T(c.x) - T(e.x), cey = T(c.y) - T(e.y), cez = T(c.z) - T(e.z);
+        const T dex = T(d.x) - T(e.x), dey = T(d.y) - T(e.y), dez = T(d.z) - T(e.z);
+
+        const T ab = aex * bey - bex * aey;
+        const T bc = bex * cey - cex * bey;
+        const T cd = cex * dey - dex * cey;
+        const T da = dex * aey - aex * dey;
+        const T ac = aex * cey - cex * aey;
+        const T bd = bex * dey - dex * bey;
+
+        const T abc = aez * bc - bez * ac + cez * ab;
+        const T bcd = bez * cd - cez * bd + dez * bc;
+        const T cda = cez * da + dez * ac + aez * cd;
+        const T dab = dez * ab + aez * bd + bez * da;
+
+        const T alift = aex * aex + aey * aey + aez * aez;
+        const T blift = bex * bex + bey * bey + bez * bez;
+        const T clift = cex * cex + cey * cey + cez * cez;
+        const T dlift = dex * dex + dey * dey + dez * dez;
+
+        return (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+    }
+
+    inline double exactResult(const expansion& e)
+    {
+        // the estimate can round to zero for tiny nonzero values, the sign must not
+        const double value = e.estimate();
+        const int sign = e.sign();
+        if (sign == 0)
+            return 0.0;
+
+        return (value > 0.0) == (sign > 0) && value != 0.0 ? value : static_cast<double>(sign) * 1e-300;
+    }
+
+    // filter stage: returns true and the determinant when its sign is certain
+    inline bool orient2dFilter(const vec2& a, const vec2& b, const vec2& c, double& det)
+    {
+        const double left = (double(a.x) - c.x) * (double(b.y) - c.y);
+        const double right = (double(a.y) - c.y) * (double(b.x) - c.x);
+        det = left - right;
+
+        return std::abs(det) > ORIENT2D_BOUND * (std::abs(left) + std::abs(right));
+    }
+
+    inline bool orient3dFilter(const vec3& a, const vec3& b, const vec3& c, const vec3& d, double& det)
+    {
+        const double adx = double(a.x) - d.x, ady = double(a.y) - d.y, adz = double(a.z) - d.z;
+        const double bdx = double(b.x) - d.x, bdy = double(b.y) - d.y, bdz = double(b.z) - d.z;
+        const double cdx = double(c.x) - d.x, cdy = double(c.y) - d.y, cdz = double(c.z) - d.z;
+
+        const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+        const double cdxady = cdx * ady, adxcdy = adx * cdy;
+        const double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+        det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+        const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz)
+            + (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz)
+            + (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+
+        return std::abs(det) > ORIENT3D_BOUND * permanent;
+    }
+
+    inline bool incircleFilter(const vec2& a, const vec2& b, const vec2& c, const vec2& d, double& det)
+    {
+        const double adx = double(a.x) - d.x, ady = double(a.y) - d.y;
+        const double bdx = double(b.x) - d.x, bdy = double(b.y) - d.y;
+        const double cdx = double(c.x) - d.x, cdy = double(c.y) - d.y;
+
+        const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+        const double cdxady = cdx * ady, adxcdy = adx * cdy;
+        const double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+        const double alift = adx * adx + ady * ady;
+        const double blift = bdx * bdx + bdy * bdy;
+        const double clift = cdx * cdx + cdy * cdy;
+
+        det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+        const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift
+            + (std::abs(cdxady) + std::abs(adxcdy)) * blift
+            + (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+
+        return std::abs(det) > INCIRCLE_BOUND * permanent;
+    }
+
+    inline bool insphereFilter(const vec3& a, const vec3& b, const vec3& c, const vec3& d, const vec3& e, double& det)
+    {
+        const double aex = double(a.x) - e.x, aey = double(a.y) - e.y, aez = double(a.z) - e.z;
+        const double bex = double(b.x) - e.x, bey = double(b.y) - e.y, bez = double(b.z) - e.z;
+        const double cex = double(c.x) - e.x, cey = double(c.y) - e.y, cez = double(c.z) - e.z;
+        const double dex = double(d.x) - e.x, dey = double(d.y) - e.y, dez = double(d.z) - e.z;
+
+        det = insphereDeterminant<double>(a, b, c, d, e);
+
+        const double abPlus = std::abs(aex * bey) + std::abs(bex * aey);
+        const double bcPlus = std::abs(bex * cey) + std::abs(cex * bey);
+        const double cdPlus = std::abs(cex * dey) + std::abs(dex * cey);
+        const double daPlus = std::abs(dex * aey) + std::abs(aex * dey);
+        const double acPlus = std::abs(aex * cey) + std::abs(cex * aey);
+        const double bdPlus = std::abs(bex * dey) + std::abs(dex * bey);
+
+        const double aezPlus = std::abs(aez), bezPlus = std::abs(bez), cezPlus = std::abs(cez), dezPlus = std::abs(dez);
+        const double alift = aex * aex + aey * aey + aez * aez;
+        const double blift = bex * bex + bey * bey + bez * bez;
+        const double clift = cex * cex + cey * cey + cez * cez;
+        const double dlift = dex * dex + dey * dey + dez * dez;
+
+        const double permanent = (cdPlus * bezPlus + bdPlus * cezPlus + bcPlus * dezPlus) * alift
+            + (daPlus * cezPlus + acPlus * dezPlus + cdPlus * aezPlus) * blift
+            + (abPlus * dezPlus + bdPlus * aezPlus + daPlus * bezPlus) * clift
+            + (bcPlus * aezPlus + acPlus * bezPlus + abPlus * cezPlus) * dlift;
+
+        return std::abs(det) > INSPHERE_BOUND * permanent;
+    }
+
+    inline int8_t signOf(double value)
+    {
+        return static_cast<int8_t>((value > 0.0) - (value < 0.0));
+    }
+} // namespace detail
+
+/**
+ * Positive if a, b, c are in counter-clockwise order, negative if clockwise and
+ * exactly zero if collinear. Only the sign is exact; the magnitude approximates
+ * twice the signed triangle area.
+ */
+inline double orient2d(const vec2& a, const vec2& b, const vec2& c)
+{
+    double det;
+    if (detail::orient2dFilter(a, b, c, det))
+        return det;
+
+    return detail::exactResult(detail::orient2dDeterminant<detail::expansion>(a, b, c));
+}
+
+/**
+ * Positive if d lies below the plane through a, b, c, where below is the side
+ * from which a, b, c appear clockwise; zero if coplanar (Shewchuk's convention).
+ */
+inline double orient3d(const vec3& a, const vec3& b, const vec3& c, const vec3& d)
+{
+    double det;
+    if (detail::orient3dFilter(a, b, c, d, det))
+        return det;
+
+    return detail::exactResult(detail::orient3dDeterminant<detail::expansion>(a, b, c, d));
+}
+
+/**
+ * Positive if d lies inside the circle through the counter-clockwise points
+ * a, b, c, negative outside and zero if the four points are cocircular.
+ */
+inline double incircle(const vec2& a, const vec2& b, const vec2& c, const vec2& d)
+{
+    double det;
+    if (detail::incircleFilter(a, b, c, d, det))
+        return det;
+
+    return detail::exactResult(detail::incircleDeterminant<detail::expansion>(a, b, c, d));
+}
+
+/**
+ * Positive if e lies inside the sphere through a, b, c, d, which must be
+ * ordered so that orient3d(a, b, c, d) is positive; zero if cospherical.
+ */
+inline double insphere(const vec3& a, const vec3& b, const vec3& c, const vec3& d, const vec3& e)
+{
+    double det;
+    if (detail::insphereFilter(a, b, c, d, e, det))
+        return det;
+
+    return detail::exactResult(detail::insphereDeterminant<detail::expansion>(a, b, c, d, e));
+}
+
+/**
+ * Writes the sign of orient2d for count triples.
+ *
+ * The filter runs over the whole batch first in a branch-free loop, then only
+ * the entries it could not decide take the exact path.
+ */
+inline void orient2d(const vec2* a, const vec2* b, const vec2* c, int8_t* signs, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        double det;
+        const bool certain = detail::orient2dFilter(a[i], b[i], c[i], det);
+        signs[i] = certain ? detail::signOf(det) : static_cast<int8_t>(2);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (signs[i] == 2)
+            signs[i] = static_cast<int8_t>(detail::orient2dDeterminant<detail::expansion>(a[i], b[i], c[i]).sign());
+    }
+}
+
+inline void orient3d(const vec3* a, const vec3* b, const vec3* c, const vec3* d, int8_t* signs, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        double det;
+        const bool certain = detail::orient3dFilter(a[i], b[i], c[i], d[i], det);
+        signs[i] = certain ? detail::signOf(det) : static_cast<int8_t>(2);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (signs[i] == 2)
+            signs[i] = static_cast<int8_t>(detail::orient3dDeterminant<detail::expansion>(a[i], b[i], c[i], d[i]).sign());
+    }
+}
+
+inline void incircle(const vec2* a, const vec2* b, const vec2* c, const vec2* d, int8_t* signs, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        double det;
+        const bool certain = detail::incircleFilter(a[i], b[i], c[i], d[i], det);
+        signs[i] = certain ? detail::signOf(det) : static_cast<int8_t>(2);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (signs[i] == 2)
+            signs[i] = static_cast<int8_t>(detail::incircleDeterminant<detail::expansion>(a[i], b[i], c[i], d[i]).sign());
+    }
+}
+
+inline void insphere(const vec3* a, const vec3* b, const vec3* c, const vec3* d, const vec3* e, int8_t* signs, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        double det;
+        const bool certain = detail::insphereFilter(a[i], b[i], c[i], d[i], e[i], det);
+        signs[i] = certain ? detail::signOf(det) : static_cast<int8_t>(2);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (signs[i] == 2)
+            signs[i] = static_cast<int8_t>(detail::insphereDeterminant<detail::expansion>(a[i], b[i], c[i], d[i], e[i]).sign());
+    }
+}
+} // namespace lia
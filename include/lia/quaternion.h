@@ -30,12 +30,12 @@ struct quaternion {
     {
         const vec3 halfAngles = eulerAngles * 0.5f;
 
-        const float cy = cos(halfAngles.z);
-        const float sy = sin(halfAngles.z);
-        const float cp = cos(halfAngles.y);
-        const float sp = sin(halfAngles.y);
-        const float cr = cos(halfAngles.x);
-        const float sr = sin(halfAngles.x);
+        const float cy = fcos(halfAngles.z);
+        const float sy = fsin(halfAngles.z);
+        const float cp = fcos(halfAngles.y);
+        const float sp = fsin(halfAngles.y);
+        const float cr = fcos(halfAngles.x);
+        const float sr = fsin(halfAngles.x);
 
         x = sr * cp * cy - cr * sp * sy;
         y = cr * sp * cy + sr * cp * sy;
@@ -204,6 +204,37 @@ inline quaternion Conjugate(const quaternion& q)
     return quaternion(-q.x, -q.y, -q.z, q.w);
 }
 
+inline float dot(const quaternion& q1, const quaternion& q2)
+{
+    return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+}
+
+inline quaternion normalize(const quaternion& q)
+{
+    return q / std::sqrt(dot(q, q));
+}
+
+/**
+ * Spherical linear interpolation between unit quaternions along the shortest arc.
+ *
+ * @param t Interpolation factor in [0, 1]
+ */
+inline quaternion slerp(const quaternion& q1, const quaternion& q2, float t)
+{
+    float cosTheta = dot(q1, q2);
+    const quaternion target = cosTheta < 0.0f ? q2 * -1.0f : q2;
+    cosTheta = std::abs(cosTheta);
+
+    // nearly parallel, fall back to normalized linear interpolation
+    if (cosTheta > 0.9995f)
+        return normalize(q1 * (1.0f - t) + target * t);
+
+    const float theta = facos(cosTheta);
+    const float invSin = 1.0f / fsin(theta);
+
+    return q1 * (fsin((1.0f - t) * theta) * invSin) + target * (fsin(t * theta) * invSin);
+}
+
 inline vec3 rotate(const vec3& v, const quaternion& q)
 {
     const vec3& b = q.GetVectorPart();
@@ -218,7 +249,7 @@ inline vec3 rotate(const vec3& v, const quaternion& q)
 inline quaternion rotationX(float angle)
 {
     const float halfAngle = angle * 0.5f;
-    return quaternion(sin(halfAngle), 0, 0, cos(halfAngle));
+    return quaternion(fsin(halfAngle), 0, 0, fcos(halfAngle));
 }
 
 /**
@@ -227,7 +258,7 @@ inline quaternion rotationX(float angle)
 inline quaternion rotationY(float angle)
 {
     const float halfAngle = angle * 0.5f;
-    return quaternion(0, sin(halfAngle), 0, cos(halfAngle));
+    return quaternion(0, fsin(halfAngle), 0, fcos(halfAngle));
 }
 
 /**
@@ -236,6 +267,6 @@ inline quaternion rotationY(float angle)
 inline quaternion rotationZ(float angle)
 {
     const float halfAngle = angle * 0.5f;
-    return quaternion(0, 0, sin(halfAngle), cos(halfAngle));
+    return quaternion(0, 0, fsin(halfAngle), fcos(halfAngle));
 }
 } // namespace lia
@@ -0,0 +1,375 @@
+#pragma once
+
+#include "mathbase.h"
+#include "sampling.h"
+#include "vec2.h"
+#include "vec3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace lia {
+namespace detail {
+    inline uint64_t splitMix64(uint64_t& state)
+    {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    inline uint32_t pcgOutput(uint64_t state)
+    {
+        const uint32_t xorshifted = static_cast<uint32_t>(((state >> 18u) ^ state) >> 27u);
+        const uint32_t rot = static_cast<uint32_t>(state >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+    }
+
+    constexpr uint64_t PCG_MULTIPLIER = 6364136223846793005ull;
+} // namespace detail
+
+/**
+ * PCG32 (XSH-RR) generator. Each stream is an independent sequence, so
+ * giving every thread its own stream index splits the work deterministically.
+ */
+struct pcg32 {
+    uint64_t state { 0x853c49e6748fea9bull };
+    uint64_t inc { 0xda3e39cb94b95bdbull };
+
+    pcg32() = default;
+
+    pcg32(uint64_t seed, uint64_t stream = 0)
+        : state(0)
+        , inc((stream << 1u) | 1u)
+    {
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next()
+    {
+        const uint64_t old = state;
+        state = old * detail::PCG_MULTIPLIER + inc;
+        return detail::pcgOutput(old);
+    }
+
+    /**
+     * Skips delta outputs in O(log delta).
+     */
+    void advance(uint64_t delta)
+    {
+        uint64_t curMult = detail::PCG_MULTIPLIER;
+        uint64_t curPlus = inc;
+        uint64_t accMult = 1u;
+        uint64_t accPlus = 0u;
+
+        while (delta > 0) {
+            if (delta & 1u) {
+                accMult *= curMult;
+                accPlus = accPlus * curMult + curPlus;
+            }
+            curPlus = (curMult + 1u) * curPlus;
+            curMult *= curMult;
+            delta >>= 1u;
+        }
+
+        state = accMult * state + accPlus;
+    }
+
+    void fill(uint32_t* out, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = next();
+    }
+};
+
+/**
+ * Eight interleaved PCG32 streams advanced in lockstep so that the state
+ * update maps onto 8-wide vector instructions.
+ *
+ * Lane i of stream s produces the same sequence as pcg32(seed, s * 8 + i).
+ */
+struct pcg32x8 {
+    uint64_t state[8];
+    uint64_t inc[8];
+
+    pcg32x8(uint64_t seed = 0, uint64_t stream = 0)
+    {
+        for (int lane = 0; lane < 8; ++lane) {
+            const pcg32 scalar(seed, stream * 8u + static_cast<uint64_t>(lane));
+            state[lane] = scalar.state;
+            inc[lane] = scalar.inc;
+        }
+    }
+
+    void next(uint32_t (&out)[8])
+    {
+        for (int lane = 0; lane < 8; ++lane) {
+            const uint64_t old = state[lane];
+            state[lane] = old * detail::PCG_MULTIPLIER + inc[lane];
+            out[lane] = detail::pcgOutput(old);
+        }
+    }
+
+    void fill(uint32_t* out, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            next(*reinterpret_cast<uint32_t(*)[8]>(out + i));
+
+        if (i < count) {
+            uint32_t tail[8];
+            next(tail);
+            for (std::size_t lane = 0; lane < 8 && i < count; ++i, ++lane)
+                out[i] = tail[lane];
+        }
+    }
+};
+
+/**
+ * xoshiro256+ generator; jump() advances by 2^128 outputs, so calling it
+ * k times gives thread k a non-overlapping subsequence.
+ */
+struct xoshiro256plus {
+    uint64_t s[4];
+
+    xoshiro256plus(uint64_t seed = 0)
+    {
+        for (uint64_t& word : s)
+            word = detail::splitMix64(seed);
+    }
+
+    /**
+     * The generator for the given thread, jumped threadIndex times from seed.
+     */
+    static xoshiro256plus forThread(uint64_t seed, uint32_t threadIndex)
+    {
+        xoshiro256plus result(seed);
+        for (uint32_t i = 0; i < threadIndex; ++i)
+            result.jump();
+
+        return result;
+    }
+
+    uint64_t next64()
+    {
+        const uint64_t result = s[0] + s[3];
+        const uint64_t t = s[1] << 17u;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = (s[3] << 45u) | (s[3] >> 19u);
+
+        return result;
+    }
+
+    // the low bits of xoshiro256+ are weak, only the upper half is used
+    uint32_t next()
+    {
+        return static_cast<uint32_t>(next64() >> 32u);
+    }
+
+    void jump()
+    {
+        const uint64_t jumpTable[4] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+
+        uint64_t t[4] = { 0, 0, 0, 0 };
+        for (uint64_t word : jumpTable) {
+            for (int bit = 0; bit < 64; ++bit) {
+                if (word & (1ull << bit)) {
+                    t[0] ^= s[0];
+                    t[1] ^= s[1];
+                    t[2] ^= s[2];
+                    t[3] ^= s[3];
+                }
+                next64();
+            }
+        }
+
+        s[0] = t[0];
+        s[1] = t[1];
+        s[2] = t[2];
+        s[3] = t[3];
+    }
+
+    void fill(uint32_t* out, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = next();
+    }
+};
+
+/**
+ * Philox4x32-10 counter-based generator (Salmon et al. 2011).
+ *
+ * @param counter The 128-bit counter, replaced by four random words
+ * @param key The 64-bit key
+ */
+inline void philox4x32(uint32_t (&counter)[4], const uint32_t (&key)[2])
+{
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+
+    for (int round = 0; round < 10; ++round) {
+        const uint64_t p0 = static_cast<uint64_t>(0xd2511f53u) * counter[0];
+        const uint64_t p1 = static_cast<uint64_t>(0xcd9e8d57u) * counter[2];
+
+        const uint32_t c1 = counter[1];
+        const uint32_t c3 = counter[3];
+        counter[0] = static_cast<uint32_t>(p1 >> 32u) ^ c1 ^ k0;
+        counter[1] = static_cast<uint32_t>(p1);
+        counter[2] = static_cast<uint32_t>(p0 >> 32u) ^ c3 ^ k1;
+        counter[3] = static_cast<uint32_t>(p0);
+
+        k0 += 0x9e3779b9u;
+        k1 += 0xbb67ae85u;
+    }
+}
+
+/**
+ * Stateless Philox stream: output i of stream s depends only on (seed, s, i),
+ * so any range of a stream can be generated in parallel without coordination.
+ * Output i is word i % 4 of the block for counter i / 4.
+ */
+struct philox {
+    uint32_t key[2];
+    uint64_t stream { 0 };
+    uint64_t position { 0 }; // index of the next output
+
+    philox(uint64_t seed = 0, uint64_t streamIndex = 0)
+        : key { static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32u) }
+        , stream(streamIndex)
+    { }
+
+    /**
+     * Positions the stream at output index.
+     */
+    void seek(uint64_t index)
+    {
+        position = index;
+    }
+
+    void fill(uint32_t* out, std::size_t count)
+    {
+        std::size_t i = 0;
+        while (i < count) {
+            const uint32_t* words = block(position / 4u);
+            for (std::size_t word = position % 4u; word < 4 && i < count; ++word, ++i, ++position)
+                out[i] = words[word];
+        }
+    }
+
+    uint32_t next()
+    {
+        const uint32_t value = block(position / 4u)[position % 4u];
+        ++position;
+        return value;
+    }
+
+private:
+    // the last block, so outputs taken a few at a time share it
+    uint32_t cached[4] = { 0, 0, 0, 0 };
+    uint32_t cachedInput[6] = { 0, 0, 0, 0, 0, 0 };
+    bool cachedValid { false };
+
+    const uint32_t* block(uint64_t counter)
+    {
+        const uint32_t input[6] = {
+            static_cast<uint32_t>(counter),
+            static_cast<uint32_t>(counter >> 32u),
+            static_cast<uint32_t>(stream),
+            static_cast<uint32_t>(stream >> 32u),
+            key[0],
+            key[1]
+        };
+        if (cachedValid && std::memcmp(input, cachedInput, sizeof(input)) == 0)
+            return cached;
+
+        std::memcpy(cachedInput, input, sizeof(input));
+        std::memcpy(cached, input, sizeof(cached));
+        philox4x32(cached, key);
+        cachedValid = true;
+        return cached;
+    }
+};
+
+namespace detail {
+    constexpr std::size_t RANDOM_CHUNK = 256;
+} // namespace detail
+
+/**
+ * Uniform floats in [0, 1). Generator is any of the lia generators.
+ */
+template <typename Generator>
+inline void randomFloats(Generator& generator, float* out, std::size_t count)
+{
+    uint32_t bits[detail::RANDOM_CHUNK];
+
+    for (std::size_t first = 0; first < count; first += detail::RANDOM_CHUNK) {
+        const std::size_t n = std::min(detail::RANDOM_CHUNK, count - first);
+        generator.fill(bits, n);
+
+        for (std::size_t i = 0; i < n; ++i)
+            out[first + i] = detail::toUnitFloat(bits[i]);
+    }
+}
+
+template <typename Generator>
+inline void randomVec2(Generator& generator, vec2* out, std::size_t count)
+{
+    // out may be null when count is 0, so do not touch it before checking
+    if (count == 0)
+        return;
+
+    randomFloats(generator, out->elementsPtr(), count * 2);
+}
+
+template <typename Generator>
+inline void randomVec3(Generator& generator, vec3* out, std::size_t count)
+{
+    // out may be null when count is 0, so do not touch it before checking
+    if (count == 0)
+        return;
+
+    randomFloats(generator, out->elementsPtr(), count * 3);
+}
+
+/**
+ * Uniformly distributed unit vectors on the circle.
+ */
+template <typename Generator>
+inline void randomUnitVec2(Generator& generator, vec2* out, std::size_t count)
+{
+    float angles[detail::RANDOM_CHUNK];
+
+    for (std::size_t first = 0; first < count; first += detail::RANDOM_CHUNK) {
+        const std::size_t n = std::min(detail::RANDOM_CHUNK, count - first);
+        randomFloats(generator, angles, n);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const float phi = angles[i] * static_cast<float>(TAU);
+            out[first + i] = vec2(fcos(phi), fsin(phi));
+        }
+    }
+}
+
+/**
+ * Uniformly distributed unit vectors on the sphere.
+ */
+template <typename Generator>
+inline void randomUnitVec3(Generator& generator, vec3* out, std::size_t count)
+{
+    vec2 u[detail::RANDOM_CHUNK];
+
+    for (std::size_t first = 0; first < count; first += detail::RANDOM_CHUNK) {
+        const std::size_t n = std::min(detail::RANDOM_CHUNK, count - first);
+        randomVec2(generator, u, n);
+        sampleSphere(u, out + first, n);
+    }
+}
+} // namespace lia
@@ -0,0 +1,350 @@
+#pragma once
+
+#include "mathbase.h"
+#include "vec2.h"
+#include "vec3.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lia {
+/**
+ * Number of Sobol dimensions with built-in direction numbers.
+ */
+constexpr uint32_t SOBOL_DIMENSIONS = 5;
+
+namespace detail {
+    struct sobolMatrices {
+        uint32_t v[SOBOL_DIMENSIONS][32];
+
+        sobolMatrices()
+        {
+            // primitive polynomial degree, coefficients and initial direction numbers (Joe & Kuo)
+            const uint32_t s[SOBOL_DIMENSIONS] = { 0, 1, 2, 3, 3 };
+            const uint32_t a[SOBOL_DIMENSIONS] = { 0, 0, 1, 1, 2 };
+            const uint32_t m[SOBOL_DIMENSIONS][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 3, 0 }, { 1, 3, 1 }, { 1, 1, 1 } };
+
+            // the first dimension is the van der Corput sequence
+            for (uint32_t i = 0; i < 32; ++i)
+                v[0][i] = 1u << (31 - i);
+
+            for (uint32_t d = 1; d < SOBOL_DIMENSIONS; ++d) {
+                for (uint32_t i = 0; i < 32; ++i) {
+                    if (i < s[d]) {
+                        v[d][i] = m[d][i] << (31 - i);
+                        continue;
+                    }
+
+                    uint32_t value = v[d][i - s[d]] ^ (v[d][i - s[d]] >> s[d]);
+                    for (uint32_t k = 1; k < s[d]; ++k)
+                        value ^= ((a[d] >> (s[d] - 1 - k)) & 1u) * v[d][i - k];
+
+                    v[d][i] = value;
+                }
+            }
+        }
+
+        static const sobolMatrices& get()
+        {
+            static const sobolMatrices instance;
+            return instance;
+        }
+    };
+
+    inline uint32_t reverseBits(uint32_t x)
+    {
+        x = (x << 16) | (x >> 16);
+        x = ((x & 0x00ff00ffu) << 8) | ((x & 0xff00ff00u) >> 8);
+        x = ((x & 0x0f0f0f0fu) << 4) | ((x & 0xf0f0f0f0u) >> 4);
+        x = ((x & 0x33333333u) << 2) | ((x & 0xccccccccu) >> 2);
+        x = ((x & 0x55555555u) << 1) | ((x & 0xaaaaaaaau) >> 1);
+        return x;
+    }
+
+    inline uint32_t hashCombine(uint32_t seed, uint32_t value)
+    {
+        return seed ^ (value + 0x9e3779b9u + (seed << 6) + (seed >> 2));
+    }
+
+    // Laine-Karras style permutation, only ever propagates bits upwards
+    inline uint32_t laineKarrasPermutation(uint32_t x, uint32_t seed)
+    {
+        x ^= x * 0x3d20adeau;
+        x += seed;
+        x *= (seed >> 16) | 1u;
+        x ^= x * 0x05526c56u;
+        x ^= x * 0x53a22864u;
+        return x;
+    }
+
+    inline uint32_t nestedUniformScramble(uint32_t x, uint32_t seed)
+    {
+        return reverseBits(laineKarrasPermutation(reverseBits(x), seed));
+    }
+
+    // maps the upper 24 bits to [0, 1), so the result never rounds up to 1
+    inline float toUnitFloat(uint32_t x)
+    {
+        return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+    }
+} // namespace detail
+
+/**
+ * Returns the raw 32-bit Sobol value of the point at index in the given dimension.
+ */
+inline uint32_t sobolBits(uint32_t index, uint32_t dimension)
+{
+    const uint32_t* v = detail::sobolMatrices::get().v[dimension];
+
+    uint32_t result = 0;
+    for (uint32_t bit = 0; bit < 32; ++bit)
+        result ^= v[bit] & (0u - ((index >> bit) & 1u));
+
+    return result;
+}
+
+/**
+ * @param index The index of the point in the sequence
+ * @param dimension The dimension, less than SOBOL_DIMENSIONS
+ */
+inline float sobol(uint32_t index, uint32_t dimension)
+{
+    return detail::toUnitFloat(sobolBits(index, dimension));
+}
+
+/**
+ * Owen-scrambled Sobol using hash-based nested uniform scrambling (Burley 2020).
+ *
+ * The index is shuffled as well, so distinct seeds give decorrelated sequences
+ * that keep the stratification of the original one. As in sobol2D, seed 0
+ * gives the unscrambled sequence.
+ */
+inline float sobolOwen(uint32_t index, uint32_t dimension, uint32_t seed)
+{
+    if (seed == 0)
+        return sobol(index, dimension);
+
+    const uint32_t shuffled = detail::nestedUniformScramble(index, seed);
+    const uint32_t bits = sobolBits(shuffled, dimension);
+    return detail::toUnitFloat(detail::nestedUniformScramble(bits, detail::hashCombine(seed, dimension)));
+}
+
+/**
+ * Radical inverse of index in the given prime base.
+ */
+inline float halton(uint32_t index, uint32_t base)
+{
+    const float invBase = 1.0f / static_cast<float>(base);
+
+    float result = 0.0f;
+    float factor = invBase;
+    while (index > 0) {
+        result += static_cast<float>(index % base) * factor;
+        index /= base;
+        factor *= invBase;
+    }
+
+    return std::min(result, 0.99999994f);
+}
+
+/**
+ * Roberts' R2 sequence, evaluated in 32-bit fixed point so it stays exact for every index.
+ */
+inline vec2 r2(uint32_t index)
+{
+    // 2^32 / g and 2^32 / g^2 where g is the plastic number
+    const uint32_t x = 0x80000000u + index * 0xc13fa9a9u;
+    const uint32_t y = 0x80000000u + index * 0x91e10da5u;
+
+    return vec2(detail::toUnitFloat(x), detail::toUnitFloat(y));
+}
+
+/**
+ * Writes count 2D Sobol points starting at first.
+ *
+ * @param seed Owen scrambling seed, 0 gives the unscrambled sequence as in sobolOwen
+ */
+inline void sobol2D(uint32_t first, std::size_t count, uint32_t seed, vec2* out)
+{
+    const detail::sobolMatrices& matrices = detail::sobolMatrices::get();
+    const uint32_t seedX = detail::hashCombine(seed, 0);
+    const uint32_t seedY = detail::hashCombine(seed, 1);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        uint32_t index = first + static_cast<uint32_t>(i);
+        if (seed != 0)
+            index = detail::nestedUniformScramble(index, seed);
+
+        uint32_t x = 0, y = 0;
+        for (uint32_t bit = 0; bit < 32; ++bit) {
+            const uint32_t mask = 0u - ((index >> bit) & 1u);
+            x ^= matrices.v[0][bit] & mask;
+            y ^= matrices.v[1][bit] & mask;
+        }
+
+        if (seed != 0) {
+            x = detail::nestedUniformScramble(x, seedX);
+            y = detail::nestedUniformScramble(y, seedY);
+        }
+
+        out[i] = vec2(detail::toUnitFloat(x), detail::toUnitFloat(y));
+    }
+}
+
+/**
+ * Writes count 2D Halton points (bases 2 and 3) starting at first.
+ */
+inline void halton2D(uint32_t first, std::size_t count, vec2* out)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const uint32_t index = first + static_cast<uint32_t>(i);
+
+        // base 2 is a plain bit reversal
+        out[i] = vec2(detail::toUnitFloat(detail::reverseBits(index)), halton(index, 3));
+    }
+}
+
+/**
+ * Writes count R2 points starting at first.
+ */
+inline void r2Sequence(uint32_t first, std::size_t count, vec2* out)
+{
+    uint32_t x = 0x80000000u + first * 0xc13fa9a9u;
+    uint32_t y = 0x80000000u + first * 0x91e10da5u;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = vec2(detail::toUnitFloat(x), detail::toUnitFloat(y));
+        x += 0xc13fa9a9u;
+        y += 0x91e10da5u;
+    }
+}
+
+/**
+ * Maps the unit square to the unit disk with Shirley's concentric mapping.
+ */
+inline vec2 sampleDisk(const vec2& u)
+{
+    const float a = 2.0f * u.x - 1.0f;
+    const float b = 2.0f * u.y - 1.0f;
+
+    if (a == 0.0f && b == 0.0f)
+        return vec2(0.0f);
+
+    const float quarterPi = static_cast<float>(PI / 4.0);
+
+    float r, phi;
+    if (std::abs(a) > std::abs(b)) {
+        r = a;
+        phi = quarterPi * (b / a);
+    } else {
+        r = b;
+        phi = 2.0f * quarterPi - quarterPi * (a / b);
+    }
+
+    return vec2(r * fcos(phi), r * fsin(phi));
+}
+
+/**
+ * Uniform direction on the unit sphere.
+ */
+inline vec3 sampleSphere(const vec2& u)
+{
+    const float z = 1.0f - 2.0f * u.x;
+    const float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+    const float phi = static_cast<float>(TAU) * u.y;
+
+    return vec3(r * fcos(phi), r * fsin(phi), z);
+}
+
+/**
+ * Uniform direction on the +z hemisphere.
+ */
+inline vec3 sampleHemisphere(const vec2& u)
+{
+    const float z = u.x;
+    const float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+    const float phi = static_cast<float>(TAU) * u.y;
+
+    return vec3(r * fcos(phi), r * fsin(phi), z);
+}
+
+/**
+ * Cosine-weighted direction on the +z hemisphere, pdf = z / PI.
+ */
+inline vec3 sampleCosineHemisphere(const vec2& u)
+{
+    const vec2 d = sampleDisk(u);
+    return vec3(d.x, d.y, std::sqrt(std::max(0.0f, 1.0f - d.x * d.x - d.y * d.y)));
+}
+
+/**
+ * Uniform barycentric coordinates (b1, b2) on a triangle; b0 = 1 - b1 - b2.
+ */
+inline vec2 sampleTriangle(const vec2& u)
+{
+    const float su = std::sqrt(u.x);
+    return vec2(u.y * su, 1.0f - su);
+}
+
+inline vec3 sampleTriangle(const vec2& u, const vec3& p0, const vec3& p1, const vec3& p2)
+{
+    const vec2 b = sampleTriangle(u);
+    return p0 * (1.0f - b.x - b.y) + p1 * b.x + p2 * b.y;
+}
+
+inline void sampleDisk(const vec2* u, vec2* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = sampleDisk(u[i]);
+}
+
+inline void sampleSphere(const vec2* u, vec3* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = sampleSphere(u[i]);
+}
+
+inline void sampleHemisphere(const vec2* u, vec3* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = sampleHemisphere(u[i]);
+}
+
+inline void sampleCosineHemisphere(const vec2* u, vec3* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = sampleCosineHemisphere(u[i]);
+}
+
+inline void sampleTriangle(const vec2* u, const vec3& p0, const vec3& p1, const vec3& p2, vec3* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = sampleTriangle(u[i], p0, p1, p2);
+}
+
+/**
+ * Builds an orthonormal basis around a unit normal without normalization
+ * or branches (Duff et al. 2017, revising Frisvad 2012).
+ */
+inline void orthonormalBasis(const vec3& n, vec3& tangent, vec3& bitangent)
+{
+    const float sign = std::copysign(1.0f, n.z);
+    const float a = -1.0f / (sign + n.z);
+    const float b = n.x * n.y * a;
+
+    tangent = vec3(1.0f + sign * n.x * n.x * a, sign * b, -sign * n.x);
+    bitangent = vec3(b, sign + n.y * n.y * a, -n.y);
+}
+
+/**
+ * Transforms directions given around +z into the frame of the unit normal n.
+ */
+inline void alignToNormal(const vec3* local, const vec3& n, vec3* out, std::size_t count)
+{
+    vec3 t, b;
+    orthonormalBasis(n, t, b);
+
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = t * local[i].x + b * local[i].y + n * local[i].z;
+}
+} // namespace lia
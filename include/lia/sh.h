@@ -0,0 +1,498 @@
+#pragma once
+
+#include "mat4.h"
+#include "mathbase.h"
+#include "quaternion.h"
+#include "vec3.h"
+
+#include <cstddef>
+
+namespace lia {
+/**
+ * RGB spherical harmonics with bands 0..Band, that is (Band + 1)^2 coefficients.
+ *
+ * The real orthonormal basis with the Condon-Shortley phase is used and the
+ * coefficients are stored in (l, m) order: index = l * (l + 1) + m.
+ */
+template <int Band>
+struct sh {
+    static_assert(Band >= 1 && Band <= 3, "lia::sh supports bands 1 to 3");
+
+    static constexpr int count = (Band + 1) * (Band + 1);
+
+    vec3 coeffs[count];
+
+    vec3& operator[](int index)
+    {
+        return coeffs[index];
+    }
+
+    const vec3& operator[](int index) const
+    {
+        return coeffs[index];
+    }
+
+    sh& operator+=(const sh& other)
+    {
+        for (int i = 0; i < count; ++i)
+            coeffs[i] += other.coeffs[i];
+
+        return (*this);
+    }
+
+    sh& operator*=(float scalar)
+    {
+        for (int i = 0; i < count; ++i)
+            coeffs[i] *= scalar;
+
+        return (*this);
+    }
+};
+
+using sh1 = sh<1>;
+using sh2 = sh<2>;
+using sh3 = sh<3>;
+
+/**
+ * Evaluates the SH basis functions of bands 0..Band for a unit direction.
+ *
+ * @param d The unit direction
+ * @param out Receives (Band + 1)^2 values
+ */
+template <int Band>
+inline void shBasis(const vec3& d, float* out)
+{
+    out[0] = 0.282094792f;
+
+    out[1] = -0.488602512f * d.y;
+    out[2] = 0.488602512f * d.z;
+    out[3] = -0.488602512f * d.x;
+
+    if (Band < 2)
+        return;
+
+    const float xx = d.x * d.x;
+    const float yy = d.y * d.y;
+    const float zz = d.z * d.z;
+
+    out[4] = 1.092548431f * d.x * d.y;
+    out[5] = -1.092548431f * d.y * d.z;
+    out[6] = 0.315391565f * (3.0f * zz - 1.0f);
+    out[7] = -1.092548431f * d.x * d.z;
+    out[8] = 0.546274215f * (xx - yy);
+
+    if (Band < 3)
+        return;
+
+    out[9] = -0.590043589f * d.y * (3.0f * xx - yy);
+    out[10] = 2.890611442f * d.x * d.y * d.z;
+    out[11] = -0.457045799f * d.y * (5.0f * zz - 1.0f);
+    out[12] = 0.373176332f * d.z * (5.0f * zz - 3.0f);
+    out[13] = -0.457045799f * d.x * (5.0f * zz - 1.0f);
+    out[14] = 1.445305721f * d.z * (xx - yy);
+    out[15] = -0.590043589f * d.x * (xx - 3.0f * yy);
+}
+
+template <int Band>
+inline vec3 evaluate(const sh<Band>& s, const vec3& direction)
+{
+    float basis[sh<Band>::count];
+    shBasis<Band>(direction, basis);
+
+    vec3 result;
+    for (int i = 0; i < sh<Band>::count; ++i)
+        result += s.coeffs[i] * basis[i];
+
+    return result;
+}
+
+/**
+ * Evaluates the function at an array of unit directions.
+ *
+ * The coefficients are split into planar RGB arrays up front so the loop body
+ * is a fixed-size, branch-free dot product that vectorizes across directions.
+ */
+template <int Band>
+inline void evaluate(const sh<Band>& s, const vec3* directions, vec3* out, std::size_t count)
+{
+    constexpr int n = sh<Band>::count;
+
+    float r[n], g[n], b[n];
+    for (int i = 0; i < n; ++i) {
+        r[i] = s.coeffs[i].x;
+        g[i] = s.coeffs[i].y;
+        b[i] = s.coeffs[i].z;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        float basis[n];
+        shBasis<Band>(directions[i], basis);
+
+        float rr = 0.0f, gg = 0.0f, bb = 0.0f;
+        for (int k = 0; k < n; ++k) {
+            rr += r[k] * basis[k];
+            gg += g[k] * basis[k];
+            bb += b[k] * basis[k];
+        }
+
+        out[i] = vec3(rr, gg, bb);
+    }
+}
+
+/**
+ * Projects weighted radiance samples onto the SH basis.
+ *
+ * @param directions Unit sample directions
+ * @param values Radiance of each sample
+ * @param weights Solid angle of each sample
+ */
+template <int Band>
+inline sh<Band> shProject(const vec3* directions, const vec3* values, const float* weights, std::size_t count)
+{
+    constexpr int n = sh<Band>::count;
+
+    float r[n] = {}, g[n] = {}, b[n] = {};
+    for (std::size_t i = 0; i < count; ++i) {
+        float basis[n];
+        shBasis<Band>(directions[i], basis);
+
+        const vec3 value = values[i] * weights[i];
+        for (int k = 0; k < n; ++k) {
+            r[k] += value.x * basis[k];
+            g[k] += value.y * basis[k];
+            b[k] += value.z * basis[k];
+        }
+    }
+
+    sh<Band> result;
+    for (int k = 0; k < n; ++k)
+        result.coeffs[k] = vec3(r[k], g[k], b[k]);
+
+    return result;
+}
+
+/**
+ * Projects radiance samples distributed uniformly over the sphere onto the SH basis.
+ */
+template <int Band>
+inline sh<Band> shProject(const vec3* directions, const vec3* values, std::size_t count)
+{
+    constexpr int n = sh<Band>::count;
+
+    float r[n] = {}, g[n] = {}, b[n] = {};
+    for (std::size_t i = 0; i < count; ++i) {
+        float basis[n];
+        shBasis<Band>(directions[i], basis);
+
+        for (int k = 0; k < n; ++k) {
+            r[k] += values[i].x * basis[k];
+            g[k] += values[i].y * basis[k];
+            b[k] += values[i].z * basis[k];
+        }
+    }
+
+    sh<Band> result;
+    const float weight = count ? static_cast<float>(4.0 * PI) / static_cast<float>(count) : 0.0f;
+    for (int k = 0; k < n; ++k)
+        result.coeffs[k] = vec3(r[k], g[k], b[k]) * weight;
+
+    return result;
+}
+
+/**
+ * Projects a cubemap onto the SH basis.
+ *
+ * Faces are ordered +X, -X, +Y, -Y, +Z, -Z using the OpenGL cubemap
+ * orientation, each face holds size * size texels in row-major order.
+ */
+template <int Band>
+inline sh<Band> shProjectCubemap(const vec3* const faces[6], int size)
+{
+    constexpr int n = sh<Band>::count;
+
+    float r[n] = {}, g[n] = {}, b[n] = {};
+    float totalWeight = 0.0f;
+    const float texel = 2.0f / static_cast<float>(size);
+
+    for (int face = 0; face < 6; ++face) {
+        for (int y = 0; y < size; ++y) {
+            const float v = (static_cast<float>(y) + 0.5f) * texel - 1.0f;
+
+            for (int x = 0; x < size; ++x) {
+                const float u = (static_cast<float>(x) + 0.5f) * texel - 1.0f;
+
+                vec3 direction;
+                switch (face) {
+                case 0: direction = vec3(1.0f, -v, -u); break;
+                case 1: direction = vec3(-1.0f, -v, u); break;
+                case 2: direction = vec3(u, 1.0f, v); break;
+                case 3: direction = vec3(u, -1.0f, -v); break;
+                case 4: direction = vec3(u, -v, 1.0f); break;
+                default: direction = vec3(-u, -v, -1.0f); break;
+                }
+
+                // differential solid angle of the texel, normalized below
+                const float lengthSq = 1.0f + u * u + v * v;
+                const float weight = 1.0f / (lengthSq * std::sqrt(lengthSq));
+                totalWeight += weight;
+
+                float basis[n];
+                shBasis<Band>(direction / std::sqrt(lengthSq), basis);
+
+                const vec3 value = faces[face][y * size + x] * weight;
+                for (int k = 0; k < n; ++k) {
+                    r[k] += value.x * basis[k];
+                    g[k] += value.y * basis[k];
+                    b[k] += value.z * basis[k];
+                }
+            }
+        }
+    }
+
+    sh<Band> result;
+    const float norm = totalWeight > 0.0f ? static_cast<float>(4.0 * PI) / totalWeight : 0.0f;
+    for (int k = 0; k < n; ++k)
+        result.coeffs[k] = vec3(r[k], g[k], b[k]) * norm;
+
+    return result;
+}
+
+/**
+ * Convolves radiance with the clamped cosine lobe, producing irradiance
+ * that can be evaluated directly at surface normals.
+ */
+template <int Band>
+inline sh<Band> shConvolveCosine(const sh<Band>& s)
+{
+    const float bands[4] = {
+        static_cast<float>(PI),
+        static_cast<float>(2.0 * PI / 3.0),
+        static_cast<float>(PI / 4.0),
+        0.0f
+    };
+
+    sh<Band> result;
+    for (int l = 0; l <= Band; ++l)
+        for (int i = l * l; i < (l + 1) * (l + 1); ++i)
+            result.coeffs[i] = s.coeffs[i] * bands[l];
+
+    return result;
+}
+
+namespace detail {
+    // Fixed generic directions; any 2l + 1 of them give an invertible basis matrix for band l.
+    inline const vec3& shSampleDirection(int index)
+    {
+        static const vec3 directions[7] = {
+            normalize(vec3(0.866f, 0.287f, 0.409f)),
+            normalize(vec3(-0.231f, 0.922f, -0.311f)),
+            normalize(vec3(0.172f, -0.405f, 0.898f)),
+            normalize(vec3(-0.718f, -0.554f, 0.421f)),
+            normalize(vec3(0.513f, 0.117f, -0.850f)),
+            normalize(vec3(-0.602f, 0.395f, 0.694f)),
+            normalize(vec3(0.091f, -0.847f, -0.523f))
+        };
+
+        return directions[index];
+    }
+
+    // Inverse of Y[k][m] = Y_lm(d_k) for the sample directions of band l.
+    template <int L>
+    struct shBandInverse {
+        static constexpr int size = 2 * L + 1;
+
+        float m[size][size];
+
+        shBandInverse()
+        {
+            double a[size][2 * size];
+
+            for (int k = 0; k < size; ++k) {
+                float basis[16];
+                shBasis<3>(shSampleDirection(k), basis);
+
+                for (int j = 0; j < size; ++j) {
+                    a[k][j] = basis[L * L + j];
+                    a[k][size + j] = (k == j) ? 1.0 : 0.0;
+                }
+            }
+
+            // Gauss-Jordan elimination with partial pivoting
+            for (int col = 0; col < size; ++col) {
+                int pivot = col;
+                for (int row = col + 1; row < size; ++row)
+                    if (std::abs(a[row][col]) > std::abs(a[pivot][col]))
+                        pivot = row;
+
+                for (int j = 0; j < 2 * size; ++j)
+                    std::swap(a[col][j], a[pivot][j]);
+
+                const double inv = 1.0 / a[col][col];
+                for (int j = 0; j < 2 * size; ++j)
+                    a[col][j] *= inv;
+
+                for (int row = 0; row < size; ++row) {
+                    if (row == col)
+                        continue;
+
+                    const double f = a[row][col];
+                    for (int j = 0; j < 2 * size; ++j)
+                        a[row][j] -= f * a[col][j];
+                }
+            }
+
+            for (int i = 0; i < size; ++i)
+                for (int j = 0; j < size; ++j)
+                    m[i][j] = static_cast<float>(a[i][size + j]);
+        }
+
+        static const shBandInverse& get()
+        {
+            static const shBandInverse instance;
+            return instance;
+        }
+    };
+
+    template <int L, typename InverseRotation>
+    inline void shBuildBandRotation(float (&out)[2 * L + 1][2 * L + 1], InverseRotation inverseRotate)
+    {
+        constexpr int size = 2 * L + 1;
+        const shBandInverse<L>& inv = shBandInverse<L>::get();
+
+        // B[k][m] = Y_lm(R^-1 d_k), the rotated function sampled at the fixed directions
+        float b[size][size];
+        for (int k = 0; k < size; ++k) {
+            float basis[16];
+            shBasis<3>(inverseRotate(shSampleDirection(k)), basis);
+
+            for (int j = 0; j < size; ++j)
+                b[k][j] = basis[L * L + j];
+        }
+
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                float sum = 0.0f;
+                for (int k = 0; k < size; ++k)
+                    sum += inv.m[i][k] * b[k][j];
+                out[i][j] = sum;
+            }
+        }
+    }
+
+    template <int L>
+    inline void shApplyBandRotation(const float (&m)[2 * L + 1][2 * L + 1], const vec3* in, vec3* out)
+    {
+        constexpr int size = 2 * L + 1;
+
+        for (int i = 0; i < size; ++i) {
+            float r = 0.0f, g = 0.0f, b = 0.0f;
+            for (int j = 0; j < size; ++j) {
+                r += m[i][j] * in[j].x;
+                g += m[i][j] * in[j].y;
+                b += m[i][j] * in[j].z;
+            }
+            out[i] = vec3(r, g, b);
+        }
+    }
+} // namespace detail
+
+/**
+ * Per-band rotation matrices for SH coefficients.
+ *
+ * Building the matrices costs a handful of basis evaluations, so build once per
+ * rotation and apply it to every probe that shares it.
+ */
+struct shRotation {
+    float band1[3][3];
+    float band2[5][5];
+    float band3[7][7];
+
+    /**
+     * @param q The unit quaternion to rotate by
+     */
+    shRotation(const quaternion& q)
+    {
+        const quaternion inverse = Conjugate(q);
+        build([&inverse](const vec3& d) { return rotate(d, inverse); });
+    }
+
+    /**
+     * @param m The rotation matrix, using the row-vector convention of mat4
+     */
+    shRotation(const mat4& m)
+    {
+        // the inverse of an orthonormal matrix is its transpose, i.e. column-order multiplication
+        build([&m](const vec3& d) {
+            const vec4 r = m * vec4(d.x, d.y, d.z, 0.0f);
+            return vec3(r.x, r.y, r.z);
+        });
+    }
+
+private:
+    template <typename InverseRotation>
+    void build(InverseRotation inverseRotate)
+    {
+        detail::shBuildBandRotation<1>(band1, inverseRotate);
+        detail::shBuildBandRotation<2>(band2, inverseRotate);
+        detail::shBuildBandRotation<3>(band3, inverseRotate);
+    }
+};
+
+namespace detail {
+    // one specialization per band count, so sh<1> never forms pointers past its four coefficients
+    template <int Band>
+    struct shRotateBands;
+
+    template <>
+    struct shRotateBands<1> {
+        static void apply(const shRotation& rotation, const vec3* in, vec3* out)
+        {
+            shApplyBandRotation<1>(rotation.band1, in + 1, out + 1);
+        }
+    };
+
+    template <>
+    struct shRotateBands<2> {
+        static void apply(const shRotation& rotation, const vec3* in, vec3* out)
+        {
+            shRotateBands<1>::apply(rotation, in, out);
+            shApplyBandRotation<2>(rotation.band2, in + 4, out + 4);
+        }
+    };
+
+    template <>
+    struct shRotateBands<3> {
+        static void apply(const shRotation& rotation, const vec3* in, vec3* out)
+        {
+            shRotateBands<2>::apply(rotation, in, out);
+            shApplyBandRotation<3>(rotation.band3, in + 9, out + 9);
+        }
+    };
+} // namespace detail
+
+template <int Band>
+inline sh<Band> rotate(const sh<Band>& s, const shRotation& rotation)
+{
+    sh<Band> result;
+    result.coeffs[0] = s.coeffs[0];
+    detail::shRotateBands<Band>::apply(rotation, s.coeffs, result.coeffs);
+
+    return result;
+}
+
+template <int Band>
+inline sh<Band> rotate(const sh<Band>& s, const quaternion& q)
+{
+    return rotate(s, shRotation(q));
+}
+
+/**
+ * Rotates an array of probes by the same rotation.
+ */
+template <int Band>
+inline void rotate(const shRotation& rotation, const sh<Band>* in, sh<Band>* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = rotate(in[i], rotation);
+}
+} // namespace lia
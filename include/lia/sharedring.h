@@ -0,0 +1,298 @@
+#pragma once
+
+#include "mathbase.h"
+#include "binary.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lia {
+constexpr uint32_t SHARED_RING_VERSION = 1;
+
+/**
+ * Start of the shared region. Slots follow at multiples of BINARY_ALIGNMENT,
+ * each a sharedRingSlot and then the frame's elements.
+ */
+struct sharedRingHeader {
+    char magic[4]; // "LIAR"
+    uint32_t version;
+    binaryType type;
+    uint32_t slotCount;
+    uint64_t count; // elements per frame
+    uint64_t slotSize; // bytes from one slot to the next
+    alignas(BINARY_ALIGNMENT) std::atomic<uint64_t> published; // frames published so far
+};
+
+struct alignas(BINARY_ALIGNMENT) sharedRingSlot {
+    std::atomic<uint64_t> sequence; // odd while the writer is in the slot
+    uint64_t frame; // written under the sequence like the elements
+};
+
+/**
+ * A frame read in place. Use the elements, then check it is still valid; if
+ * not, the writer came round to the slot meanwhile and the frame is torn.
+ */
+template <typename T>
+struct sharedFrame {
+    const T* data { nullptr };
+    std::size_t count { 0 };
+    uint64_t number { 0 };
+    uint64_t sequence { 0 };
+    const sharedRingSlot* slot { nullptr };
+};
+
+/**
+ * Frames of count elements published by one process to readers in others
+ * through POSIX shared memory, without copies or locks.
+ *
+ * The writer fills the slots in turn, and a sequence counter per slot, odd
+ * while it is being written, lets readers detect that a slot changed under
+ * them, as a seqlock does. Readers take the newest frame, so they are
+ * never blocked by the writer and the writer never waits for them; a reader
+ * only sees a torn frame when it holds one for longer than the writer takes
+ * to go round the other slots.
+ */
+template <typename T>
+struct sharedRing {
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared rings need address-free 64-bit atomics");
+
+    sharedRing() = default;
+    sharedRing(const sharedRing&) = delete;
+    sharedRing& operator=(const sharedRing&) = delete;
+
+    ~sharedRing()
+    {
+        close();
+    }
+
+    /**
+     * Creates or replaces the shared memory object and maps it for writing.
+     *
+     * @param name As for shm_open, e.g. "/lia-transforms"
+     * @param slotCount At least 2; more slots give readers longer to use a frame
+     */
+    bool create(const char* name, std::size_t count, uint32_t slotCount = 4)
+    {
+        close();
+        if (slotCount < 2)
+            return false;
+
+        const uint64_t slotSize = detail::alignUp(sizeof(sharedRingSlot) + count * sizeof(T), BINARY_ALIGNMENT);
+        const std::size_t total = static_cast<std::size_t>(firstSlot() + slotSize * slotCount);
+        if (!map(name, total, true))
+            return false;
+
+        header = new (base) sharedRingHeader();
+        header->version = SHARED_RING_VERSION;
+        header->type = binaryTypeOf(static_cast<const T*>(nullptr));
+        header->slotCount = slotCount;
+        header->count = count;
+        header->slotSize = slotSize;
+        header->published.store(0, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < slotCount; ++i) {
+            sharedRingSlot* s = new (base + firstSlot() + slotSize * i) sharedRingSlot();
+            s->sequence.store(0, std::memory_order_relaxed);
+            s->frame = 0;
+        }
+
+        // readers check the magic last
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(header->magic, "LIAR", 4);
+        return true;
+    }
+
+    /**
+     * Maps an existing ring for reading.
+     *
+     * @return False unless it was created for the same element type
+     */
+    bool open(const char* name)
+    {
+        close();
+        if (!map(name, 0, false))
+            return false;
+
+        header = reinterpret_cast<sharedRingHeader*>(base);
+        const bool valid = mappedSize >= sizeof(sharedRingHeader) && std::memcmp(header->magic, "LIAR", 4) == 0
+            && header->version == SHARED_RING_VERSION && header->type == binaryTypeOf(static_cast<const T*>(nullptr))
+            && header->slotCount >= 2 && header->slotSize >= sizeof(sharedRingSlot) + header->count * sizeof(T)
+            && firstSlot() + header->slotSize * header->slotCount <= mappedSize;
+        if (!valid)
+            close();
+
+        return valid;
+    }
+
+    void close()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        if (base)
+            munmap(base, mappedSize);
+#endif
+        base = nullptr;
+        header = nullptr;
+        mappedSize = 0;
+        writing = nullptr;
+    }
+
+    /**
+     * Removes the name; mappings stay valid until they are closed.
+     */
+    static bool remove(const char* name)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        return shm_unlink(name) == 0;
+#else
+        (void)name;
+        return false;
+#endif
+    }
+
+    std::size_t size() const
+    {
+        return header ? static_cast<std::size_t>(header->count) : 0;
+    }
+
+    /**
+     * The writer's next slot, to fill before endWrite.
+     */
+    T* beginWrite()
+    {
+        writing = slot(header->published.load(std::memory_order_relaxed));
+        const uint64_t sequence = writing->sequence.load(std::memory_order_relaxed);
+        writing->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        return elements(writing);
+    }
+
+    /**
+     * Publishes the slot as the newest frame.
+     */
+    void endWrite()
+    {
+        const uint64_t frame = header->published.load(std::memory_order_relaxed);
+        writing->frame = frame;
+        writing->sequence.store(writing->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        header->published.store(frame + 1, std::memory_order_release);
+        writing = nullptr;
+    }
+
+    /**
+     * The newest frame, in place.
+     *
+     * @return False before the first frame, or while the writer is lapping the reader
+     */
+    bool latest(sharedFrame<T>& frame) const
+    {
+        const uint64_t published = header->published.load(std::memory_order_acquire);
+        if (published == 0)
+            return false;
+
+        const sharedRingSlot* s = slot(published - 1);
+        const uint64_t sequence = s->sequence.load(std::memory_order_acquire);
+        if (sequence & 1u)
+            return false;
+
+        frame.data = elements(s);
+        frame.count = static_cast<std::size_t>(header->count);
+        frame.number = s->frame;
+        frame.sequence = sequence;
+        frame.slot = s;
+        return true;
+    }
+
+    /**
+     * @return True when nothing wrote to the frame's slot since latest
+     */
+    bool valid(const sharedFrame<T>& frame) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return frame.slot->sequence.load(std::memory_order_relaxed) == frame.sequence;
+    }
+
+    /**
+     * Copies the newest frame, retrying torn reads a bounded number of times.
+     */
+    bool read(T* out, uint64_t* number = nullptr) const
+    {
+        sharedFrame<T> frame;
+        for (int attempt = 0; attempt < 64; ++attempt) {
+            if (!latest(frame))
+                continue;
+
+            std::memcpy(static_cast<void*>(out), frame.data, frame.count * sizeof(T));
+            if (valid(frame)) {
+                if (number)
+                    *number = frame.number;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    uint8_t* base { nullptr };
+    sharedRingHeader* header { nullptr };
+    std::size_t mappedSize { 0 };
+    sharedRingSlot* writing { nullptr };
+
+    static uint64_t firstSlot()
+    {
+        return detail::alignUp(sizeof(sharedRingHeader), BINARY_ALIGNMENT);
+    }
+
+    sharedRingSlot* slot(uint64_t frame) const
+    {
+        return reinterpret_cast<sharedRingSlot*>(base + firstSlot() + header->slotSize * (frame % header->slotCount));
+    }
+
+    static T* elements(const sharedRingSlot* s)
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(s) + sizeof(sharedRingSlot));
+    }
+
+    bool map(const char* name, std::size_t size, bool write)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        const int fd = write ? shm_open(name, O_CREAT | O_RDWR | O_TRUNC, 0600) : shm_open(name, O_RDONLY, 0);
+        if (fd < 0)
+            return false;
+
+        struct stat status;
+        const bool sized = write ? ftruncate(fd, static_cast<off_t>(size)) == 0 : fstat(fd, &status) == 0 && status.st_size > 0;
+        if (!sized) {
+            ::close(fd);
+            return false;
+        }
+        if (!write)
+            size = static_cast<std::size_t>(status.st_size);
+
+        void* mapping = mmap(nullptr, size, write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+            return false;
+
+        base = static_cast<uint8_t*>(mapping);
+        mappedSize = size;
+        return true;
+#else
+        (void)name;
+        (void)size;
+        (void)write;
+        return false;
+#endif
+    }
+};
+} // namespace lia
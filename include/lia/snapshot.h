@@ -0,0 +1,350 @@
+#pragma once
+
+#include "mathbase.h"
+#include "interval.h"
+#include "quaternion.h"
+#include "transform.h"
+#include "vec3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace lia {
+/**
+ * How a snapshot is quantized; the encoder and decoder must agree on it.
+ */
+struct snapshotSettings {
+    ivec3 bounds; // positions are clamped into it
+    int positionBits { 16 }; // per axis, 1 to 31
+    int rotationBits { 10 }; // per smallest-three component, 1 to 31
+    int scaleBits { 0 }; // per axis, 0 sends no scale
+    float maxScale { 4.0f };
+};
+
+/**
+ * A transform as the integers a snapshot carries. The rotation drops its
+ * largest component, which the other three imply.
+ */
+struct quantizedTransform {
+    uint32_t position[3] {};
+    uint32_t largest { 0 };
+    uint32_t rotation[3] {};
+    uint32_t scale[3] {};
+};
+
+namespace detail {
+    constexpr int SNAPSHOT_FIELDS = 10;
+    constexpr uint32_t RICE_ESCAPE = 24;
+
+    // the smallest three of a unit quaternion lie in [-1/sqrt(2), 1/sqrt(2)]
+    constexpr float SQRT2 = 1.41421356f;
+    constexpr float SQRT1_2 = 0.707106781f;
+
+    // the components kept for each dropped one
+    constexpr int SMALLEST_THREE[4][3] = { { 1, 2, 3 }, { 0, 2, 3 }, { 0, 1, 3 }, { 0, 1, 2 } };
+
+    inline uint32_t& snapshotField(quantizedTransform& q, int field)
+    {
+        return field < 3 ? q.position[field] : field == 3 ? q.largest : field < 7 ? q.rotation[field - 4] : q.scale[field - 7];
+    }
+
+    inline uint32_t snapshotField(const quantizedTransform& q, int field)
+    {
+        return snapshotField(const_cast<quantizedTransform&>(q), field);
+    }
+
+    inline int snapshotFieldBits(const snapshotSettings& settings, int field)
+    {
+        return field < 3 ? settings.positionBits : field == 3 ? 2 : field < 7 ? settings.rotationBits : settings.scaleBits;
+    }
+
+    inline uint64_t bitMask(int bits)
+    {
+        return (uint64_t(1) << bits) - 1u;
+    }
+
+    // value * scale rounded into [0, 2^bits - 1]; doubles keep all 31 bits exact
+    inline uint32_t quantizeScaled(double value, double scale, int bits)
+    {
+        const double limit = static_cast<double>(bitMask(bits));
+        return static_cast<uint32_t>(std::min(std::max(value * scale, 0.0), limit) + 0.5);
+    }
+
+    inline float dequantizeUnit(uint32_t value, int bits)
+    {
+        return static_cast<float>(static_cast<double>(value) / static_cast<double>(bitMask(bits)));
+    }
+
+    // the difference as a signed bits-wide integer, zigzagged so small magnitudes are small
+    inline uint32_t wrappedDelta(uint32_t value, uint32_t reference, int bits)
+    {
+        const int64_t delta = static_cast<int64_t>((uint64_t(value) - reference) << (64 - bits)) >> (64 - bits);
+
+        return static_cast<uint32_t>((uint64_t(delta) << 1) ^ uint64_t(delta >> 63));
+    }
+
+    inline uint32_t applyDelta(uint32_t reference, uint32_t zigzag, int bits)
+    {
+        const uint64_t magnitude = zigzag >> 1;
+        const uint64_t delta = zigzag & 1u ? uint64_t(0) - magnitude - 1u : magnitude;
+
+        return static_cast<uint32_t>((reference + delta) & bitMask(bits));
+    }
+
+    /**
+     * Running mean of a field's deltas, from which the Rice parameter follows,
+     * so the code adapts to how fast each field moves.
+     */
+    struct riceState {
+        uint64_t sum { 4 };
+        uint32_t count { 1 };
+
+        int parameter(int bits) const
+        {
+            int k = 0;
+            while (k < bits && (uint64_t(count) << k) < sum)
+                ++k;
+
+            return k;
+        }
+
+        void update(uint32_t value)
+        {
+            sum += value;
+            if (++count == 32) {
+                sum >>= 1;
+                count >>= 1;
+            }
+        }
+    };
+
+    struct bitWriter {
+        explicit bitWriter(std::vector<uint8_t>& out)
+            : out(out)
+        { }
+
+        // up to 32 bits, least significant first
+        void write(uint32_t value, int bits)
+        {
+            buffer |= (uint64_t(value) & bitMask(bits)) << count;
+            count += bits;
+            while (count >= 8) {
+                out.push_back(static_cast<uint8_t>(buffer));
+                buffer >>= 8;
+                count -= 8;
+            }
+        }
+
+        void writeRice(uint32_t value, int k, int bits)
+        {
+            const uint32_t quotient = value >> k;
+            if (quotient < RICE_ESCAPE) {
+                write((1u << quotient) - 1u, static_cast<int>(quotient) + 1);
+                write(value, k);
+            } else {
+                write((1u << RICE_ESCAPE) - 1u, RICE_ESCAPE);
+                write(value, bits);
+            }
+        }
+
+        void flush()
+        {
+            if (count > 0)
+                out.push_back(static_cast<uint8_t>(buffer));
+            buffer = 0;
+            count = 0;
+        }
+
+    private:
+        std::vector<uint8_t>& out;
+        uint64_t buffer { 0 };
+        int count { 0 };
+    };
+
+    struct bitReader {
+        bitReader(const uint8_t* data, std::size_t size)
+            : data(data)
+            , size(size)
+        { }
+
+        uint32_t read(int bits)
+        {
+            while (count < bits) {
+                const uint64_t byte = position < size ? data[position] : 0u;
+                overrun = overrun || position >= size;
+                ++position;
+                buffer |= byte << count;
+                count += 8;
+            }
+
+            const uint32_t value = static_cast<uint32_t>(buffer & bitMask(bits));
+            buffer >>= bits;
+            count -= bits;
+
+            return value;
+        }
+
+        uint32_t readRice(int k, int bits)
+        {
+            uint32_t quotient = 0;
+            while (quotient < RICE_ESCAPE && read(1))
+                ++quotient;
+            if (quotient == RICE_ESCAPE)
+                return read(bits);
+
+            return (quotient << k) | read(k);
+        }
+
+        const uint8_t* data;
+        std::size_t size;
+        std::size_t position { 0 };
+        uint64_t buffer { 0 };
+        int count { 0 };
+        bool overrun { false }; // read past the end, the values read are zeros
+    };
+} // namespace detail
+
+/**
+ * Quantizes positions into the bounds and rotations to smallest three.
+ */
+inline void quantize(const snapshotSettings& settings, const transform* in, quantizedTransform* out, std::size_t count)
+{
+    const vec3 lower = settings.bounds.lower();
+    const vec3 extent = settings.bounds.upper() - lower;
+    double positionScale[3];
+    for (int axis = 0; axis < 3; ++axis)
+        positionScale[axis] = extent[axis] > 0.0f ? static_cast<double>(detail::bitMask(settings.positionBits)) / extent[axis] : 0.0;
+    const double rotationScale = static_cast<double>(detail::bitMask(settings.rotationBits)) * 0.5;
+    const double scaleScale = settings.scaleBits > 0 ? static_cast<double>(detail::bitMask(settings.scaleBits)) / settings.maxScale : 0.0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        quantizedTransform& q = out[i];
+        for (int axis = 0; axis < 3; ++axis)
+            q.position[axis] = detail::quantizeScaled(in[i].position[axis] - lower[axis], positionScale[axis], settings.positionBits);
+
+        const quaternion& r = in[i].rotation;
+        const float components[4] = { r.x, r.y, r.z, r.w };
+        // selects without branches, the largest component is as good as random
+        const int xy = std::abs(r.y) > std::abs(r.x) ? 1 : 0;
+        const int zw = std::abs(r.w) > std::abs(r.z) ? 3 : 2;
+        const int largest = std::abs(components[zw]) > std::abs(components[xy]) ? zw : xy;
+
+        // q and -q are the same rotation, so the dropped component is made positive
+        const float scale = (components[largest] < 0.0f ? -1.0f : 1.0f) / std::sqrt(dot(r, r));
+        q.largest = static_cast<uint32_t>(largest);
+        for (int k = 0; k < 3; ++k) {
+            const float c = components[detail::SMALLEST_THREE[largest][k]];
+            q.rotation[k] = detail::quantizeScaled(c * scale * detail::SQRT2 + 1.0f, rotationScale, settings.rotationBits);
+        }
+
+        for (int axis = 0; axis < 3; ++axis)
+            q.scale[axis] = settings.scaleBits > 0 ? detail::quantizeScaled(in[i].scale[axis], scaleScale, settings.scaleBits) : 0u;
+    }
+}
+
+/**
+ * Scale is 1 when the settings send none.
+ */
+inline void dequantize(const snapshotSettings& settings, const quantizedTransform* in, transform* out, std::size_t count)
+{
+    const vec3 lower = settings.bounds.lower();
+    const vec3 extent = settings.bounds.upper() - lower;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const quantizedTransform& q = in[i];
+        for (int axis = 0; axis < 3; ++axis)
+            out[i].position[axis] = lower[axis] + extent[axis] * detail::dequantizeUnit(q.position[axis], settings.positionBits);
+
+        const int largest = static_cast<int>(q.largest & 3u);
+        float components[4];
+        float sum = 0.0f;
+        for (int k = 0; k < 3; ++k) {
+            const float c = (detail::dequantizeUnit(q.rotation[k], settings.rotationBits) * 2.0f - 1.0f) * detail::SQRT1_2;
+            components[detail::SMALLEST_THREE[largest][k]] = c;
+            sum += c * c;
+        }
+        components[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+        out[i].rotation = normalize(quaternion(components[0], components[1], components[2], components[3]));
+
+        for (int axis = 0; axis < 3; ++axis)
+            out[i].scale[axis] = settings.scaleBits > 0 ? detail::dequantizeUnit(q.scale[axis], settings.scaleBits) * settings.maxScale : 1.0f;
+    }
+}
+
+/**
+ * Encodes current against the baseline the receiver already has, or against
+ * the previous entity when baseline is null. Each entity costs one bit when
+ * it has not changed; the changed fields are Rice coded deltas whose
+ * parameters adapt per field as the stream goes.
+ *
+ * @param out Replaced by the encoded snapshot
+ */
+inline void encodeSnapshot(const snapshotSettings& settings, const quantizedTransform* current, const quantizedTransform* baseline,
+                           std::size_t count, std::vector<uint8_t>& out)
+{
+    out.clear();
+    detail::bitWriter writer(out);
+    writer.write(static_cast<uint32_t>(count), 32);
+    writer.write(baseline ? 1u : 0u, 1);
+
+    const int fields = settings.scaleBits > 0 ? detail::SNAPSHOT_FIELDS : detail::SNAPSHOT_FIELDS - 3;
+    detail::riceState states[detail::SNAPSHOT_FIELDS];
+    const quantizedTransform zero;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const quantizedTransform& reference = baseline ? baseline[i] : i > 0 ? current[i - 1] : zero;
+
+        const bool changed = std::memcmp(&current[i], &reference, sizeof(quantizedTransform)) != 0;
+        writer.write(changed ? 1u : 0u, 1);
+        if (!changed)
+            continue;
+
+        for (int f = 0; f < fields; ++f) {
+            const int bits = detail::snapshotFieldBits(settings, f);
+            const uint32_t delta = detail::wrappedDelta(detail::snapshotField(current[i], f), detail::snapshotField(reference, f), bits);
+            writer.writeRice(delta, states[f].parameter(bits), bits);
+            states[f].update(delta);
+        }
+    }
+
+    writer.flush();
+}
+
+/**
+ * Decodes a snapshot of count transforms. out may be the baseline itself.
+ *
+ * @return False when the data is truncated, or does not match count or the
+ * presence of a baseline
+ */
+inline bool decodeSnapshot(const snapshotSettings& settings, const uint8_t* data, std::size_t size, const quantizedTransform* baseline,
+                           quantizedTransform* out, std::size_t count)
+{
+    detail::bitReader reader(data, size);
+    if (reader.read(32) != count || reader.read(1) != (baseline ? 1u : 0u))
+        return false;
+
+    const int fields = settings.scaleBits > 0 ? detail::SNAPSHOT_FIELDS : detail::SNAPSHOT_FIELDS - 3;
+    detail::riceState states[detail::SNAPSHOT_FIELDS];
+    const quantizedTransform zero;
+
+    for (std::size_t i = 0; i < count && !reader.overrun; ++i) {
+        const quantizedTransform reference = baseline ? baseline[i] : i > 0 ? out[i - 1] : zero;
+        out[i] = reference;
+        if (!reader.read(1))
+            continue;
+
+        for (int f = 0; f < fields; ++f) {
+            const int bits = detail::snapshotFieldBits(settings, f);
+            const uint32_t delta = reader.readRice(states[f].parameter(bits), bits);
+            states[f].update(delta);
+            detail::snapshotField(out[i], f) = detail::applyDelta(detail::snapshotField(reference, f), delta, bits);
+        }
+    }
+
+    return !reader.overrun;
+}
+} // namespace lia
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "mathbase.h"
+#include "mat4.h"
+#include "vec3.h"
+#include "vec4.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LIA_STREAM_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace lia {
+/**
+ * How the batch transforms below use the memory hierarchy.
+ */
+struct streamSettings {
+    streamSettings() = default;
+
+    streamSettings(std::size_t prefetch, std::size_t threshold, std::size_t tile = 8192)
+        : prefetchDistance(prefetch)
+        , nonTemporalThreshold(threshold)
+        , tilePoints(tile)
+    { }
+
+    /**
+     * Bytes ahead of the current input to prefetch, one cache line per
+     * prefetch; 0 leaves it to the hardware prefetcher. Worth raising when
+     * the loop is short and memory latency long.
+     */
+    std::size_t prefetchDistance { 1024 };
+
+    /**
+     * Outputs of at least this many bytes are written with non-temporal
+     * stores, which skip reading the lines in and leave the cache to the
+     * inputs. The default is a typical last-level cache; 0 always streams
+     * and SIZE_MAX never does.
+     */
+    std::size_t nonTemporalThreshold { std::size_t(32) << 20 };
+
+    /**
+     * Points per tile in transformPointSets, small enough for a tile to stay
+     * in L2 while every matrix is applied to it.
+     */
+    std::size_t tilePoints { 8192 };
+};
+
+namespace detail {
+    constexpr std::size_t STREAM_LINE = 64;
+
+    inline void prefetch(const void* address)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address, 0, 3);
+#elif defined(LIA_STREAM_SSE2)
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+    }
+
+    // float-sized stores, so outputs need no more than their own alignment
+    template <bool NonTemporal, typename T>
+    inline void store(T* destination, const T& value)
+    {
+        static_assert(sizeof(T) % sizeof(float) == 0, "stores go by float");
+#if defined(LIA_STREAM_SSE2)
+        if (NonTemporal) {
+            int32_t bits[sizeof(T) / sizeof(float)];
+            std::memcpy(bits, &value, sizeof(T));
+            for (std::size_t i = 0; i < sizeof(T) / sizeof(float); ++i)
+                _mm_stream_si32(reinterpret_cast<int*>(destination) + i, bits[i]);
+            return;
+        }
+#endif
+        *destination = value;
+    }
+
+    // makes non-temporal stores visible to other threads before returning
+    inline void streamFence()
+    {
+#if defined(LIA_STREAM_SSE2)
+        _mm_sfence();
+#endif
+    }
+
+    template <bool NonTemporal, typename In, typename Out, typename Op>
+    inline void streamRange(const In* in, Out* out, std::size_t count, std::size_t prefetchDistance, Op op)
+    {
+        const std::size_t step = sizeof(In) < STREAM_LINE ? STREAM_LINE / sizeof(In) : 1;
+        for (std::size_t i = 0; i < count; i += step) {
+            // a hint; prefetching past the end does not fault
+            if (prefetchDistance)
+                prefetch(reinterpret_cast<const char*>(in + i) + prefetchDistance);
+
+            const std::size_t end = i + step < count ? i + step : count;
+            for (std::size_t j = i; j < end; ++j)
+                store<NonTemporal>(out + j, op(in[j]));
+        }
+    }
+
+    template <typename In, typename Out, typename Op>
+    inline void stream(const In* in, Out* out, std::size_t count, const streamSettings& settings, const Op& op)
+    {
+        if (count * sizeof(Out) >= settings.nonTemporalThreshold) {
+            streamRange<true>(in, out, count, settings.prefetchDistance, op);
+            streamFence();
+        } else {
+            streamRange<false>(in, out, count, settings.prefetchDistance, op);
+        }
+    }
+
+    // the affine part of a matrix, held in registers across a batch
+    struct affinePoint {
+        float m[12];
+
+        explicit affinePoint(const mat4& mat)
+        {
+            for (int row = 0; row < 4; ++row) {
+                for (int col = 0; col < 3; ++col)
+                    m[row * 3 + col] = mat(row, col);
+            }
+        }
+
+        vec3 operator()(const vec3& p) const
+        {
+            return vec3(p.x * m[0] + p.y * m[3] + p.z * m[6] + m[9],
+                        p.x * m[1] + p.y * m[4] + p.z * m[7] + m[10],
+                        p.x * m[2] + p.y * m[5] + p.z * m[8] + m[11]);
+        }
+    };
+} // namespace detail
+
+/**
+ * Row-order transform of count points, as vec4(p, 1) * mat without the
+ * projective divide.
+ */
+inline void transformPoints(const mat4& mat, const vec3* in, vec3* out, std::size_t count, const streamSettings& settings = streamSettings())
+{
+    detail::stream(in, out, count, settings, detail::affinePoint(mat));
+}
+
+/**
+ * Row-order transform of count homogeneous vectors.
+ */
+inline void transformPoints(const mat4& mat, const vec4* in, vec4* out, std::size_t count, const streamSettings& settings = streamSettings())
+{
+    detail::stream(in, out, count, settings, [&mat](const vec4& v) { return v * mat; });
+}
+
+/**
+ * out[i] = in[i] * mat, e.g. local matrices into a parent's space.
+ */
+inline void transformMatrices(const mat4& mat, const mat4* in, mat4* out, std::size_t count, const streamSettings& settings = streamSettings())
+{
+    detail::stream(in, out, count, settings, [&mat](const mat4& m) { return m * mat; });
+}
+
+/**
+ * Applies each of matrixCount matrices to the same pointCount points, e.g.
+ * instances of one mesh, writing the points for matrix m at
+ * out + m * pointCount. The points are taken a tile at a time, and every
+ * matrix is applied to a tile while it is in cache, so the points are read
+ * from memory once instead of once per matrix.
+ */
+inline void transformPointSets(const mat4* matrices, std::size_t matrixCount, const vec3* points, std::size_t pointCount,
+    vec3* out, const streamSettings& settings = streamSettings())
+{
+    const bool nonTemporal = matrixCount * pointCount * sizeof(vec3) >= settings.nonTemporalThreshold;
+    const std::size_t tile = settings.tilePoints ? settings.tilePoints : pointCount;
+    for (std::size_t first = 0; first < pointCount; first += tile) {
+        const std::size_t count = first + tile < pointCount ? tile : pointCount - first;
+        for (std::size_t m = 0; m < matrixCount; ++m) {
+            // the first matrix brings the tile in; the rest hit the cache
+            const std::size_t distance = m == 0 ? settings.prefetchDistance : 0;
+            vec3* destination = out + m * pointCount + first;
+            if (nonTemporal)
+                detail::streamRange<true>(points + first, destination, count, distance, detail::affinePoint(matrices[m]));
+            else
+                detail::streamRange<false>(points + first, destination, count, distance, detail::affinePoint(matrices[m]));
+        }
+    }
+
+    if (nonTemporal)
+        detail::streamFence();
+}
+} // namespace lia
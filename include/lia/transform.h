@@ -0,0 +1,70 @@
+#pragma once
+
+#include "mathbase.h"
+#include "mat4.h"
+#include "quaternion.h"
+#include "vec3.h"
+
+#include <cstddef>
+
+namespace lia {
+/**
+ * A translation, rotation and scale, applied scale first.
+ */
+struct transform {
+    vec3 position;
+    quaternion rotation;
+    vec3 scale { 1.0f };
+
+    transform() = default;
+
+    transform(const vec3& p, const quaternion& r, const vec3& s = vec3(1.0f, 1.0f, 1.0f))
+        : position(p)
+        , rotation(r)
+        , scale(s)
+    { }
+};
+
+inline vec3 transformPoint(const transform& t, const vec3& point)
+{
+    return rotate(vec3(point.x * t.scale.x, point.y * t.scale.y, point.z * t.scale.z), t.rotation) + t.position;
+}
+
+/**
+ * The matrix that maps points as transformPoint does, for row-order
+ * multiplication as translate builds: the rows are the rotated, scaled axes
+ * and the position.
+ */
+inline mat4 toMatrix(const vec3& position, const quaternion& q, const vec3& scale)
+{
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    return mat4((1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy + wz) * scale.x, 2.0f * (xz - wy) * scale.x, 0.0f,
+                2.0f * (xy - wz) * scale.y, (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz + wx) * scale.y, 0.0f,
+                2.0f * (xz + wy) * scale.z, 2.0f * (yz - wx) * scale.z, (1.0f - 2.0f * (xx + yy)) * scale.z, 0.0f,
+                position.x, position.y, position.z, 1.0f);
+}
+
+inline mat4 toMatrix(const transform& t)
+{
+    return toMatrix(t.position, t.rotation, t.scale);
+}
+
+/**
+ * Linear position and scale, spherical rotation, as clients blend two
+ * replicated snapshots.
+ */
+inline transform interpolate(const transform& a, const transform& b, float t)
+{
+    return transform(a.position + (b.position - a.position) * t, slerp(a.rotation, b.rotation, t),
+                     a.scale + (b.scale - a.scale) * t);
+}
+
+inline void interpolate(const transform* a, const transform* b, float t, transform* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = interpolate(a[i], b[i], t);
+}
+} // namespace lia
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "mathbase.h"
+#include "mat4.h"
+#include "quaternion.h"
+#include "transform.h"
+#include "vec3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lia {
+/**
+ * Names a transform in a transformPool. A handle outlives its transform:
+ * once the transform is destroyed the handle stops being valid, even after
+ * the slot is reused.
+ */
+struct transformHandle {
+    uint32_t slot { 0 };
+    uint32_t generation { 0 }; // 0 is never live
+
+    bool operator==(const transformHandle& other) const
+    {
+        return slot == other.slot && generation == other.generation;
+    }
+
+    bool operator!=(const transformHandle& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+constexpr uint32_t POOL_NONE = 0xFFFFFFFFu;
+
+/**
+ * Composes world matrices from separate position, rotation and scale arrays.
+ */
+inline void toMatrices(const vec3* positions, const quaternion* rotations, const vec3* scales, mat4* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = toMatrix(positions[i], rotations[i], scales[i]);
+}
+
+/**
+ * Transforms in dense arrays, one per component, so batch work runs over
+ * contiguous memory. Destroying swaps the last transform into the hole, so
+ * dense indices change; handles go through a slot table that follows the
+ * moves and carries a generation to reject stale handles.
+ */
+struct transformPool {
+    transformHandle create(const transform& t = transform())
+    {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back(slotEntry());
+        }
+
+        slots[slot].dense = static_cast<uint32_t>(positionArray.size());
+        denseSlots.push_back(slot);
+        positionArray.push_back(t.position);
+        rotationArray.push_back(t.rotation);
+        scaleArray.push_back(t.scale);
+        worldArray.push_back(toMatrix(t));
+
+        return transformHandle { slot, slots[slot].generation };
+    }
+
+    /**
+     * @return False when the handle is not live
+     */
+    bool destroy(transformHandle handle)
+    {
+        const uint32_t index = indexOf(handle);
+        if (index == POOL_NONE)
+            return false;
+
+        const uint32_t last = static_cast<uint32_t>(positionArray.size() - 1);
+        if (index != last) {
+            positionArray[index] = positionArray[last];
+            rotationArray[index] = rotationArray[last];
+            scaleArray[index] = scaleArray[last];
+            worldArray[index] = worldArray[last];
+            denseSlots[index] = denseSlots[last];
+            slots[denseSlots[index]].dense = index;
+        }
+        positionArray.pop_back();
+        rotationArray.pop_back();
+        scaleArray.pop_back();
+        worldArray.pop_back();
+        denseSlots.pop_back();
+
+        slotEntry& entry = slots[handle.slot];
+        entry.dense = POOL_NONE;
+        entry.generation = entry.generation == 0xFFFFFFFFu ? 1u : entry.generation + 1u;
+        freeSlots.push_back(handle.slot);
+
+        return true;
+    }
+
+    bool valid(transformHandle handle) const
+    {
+        return indexOf(handle) != POOL_NONE;
+    }
+
+    /**
+     * The dense index of a live handle, or POOL_NONE. Stable until the next
+     * destroy.
+     */
+    uint32_t indexOf(transformHandle handle) const
+    {
+        if (handle.slot >= slots.size() || slots[handle.slot].generation != handle.generation)
+            return POOL_NONE;
+
+        return slots[handle.slot].dense;
+    }
+
+    transformHandle handleAt(uint32_t index) const
+    {
+        const uint32_t slot = denseSlots[index];
+        return transformHandle { slot, slots[slot].generation };
+    }
+
+    transform get(transformHandle handle) const
+    {
+        const uint32_t index = indexOf(handle);
+        return index == POOL_NONE ? transform() : transform(positionArray[index], rotationArray[index], scaleArray[index]);
+    }
+
+    /**
+     * Sets the local parts; the world matrix follows at updateWorlds.
+     */
+    bool set(transformHandle handle, const transform& t)
+    {
+        const uint32_t index = indexOf(handle);
+        if (index == POOL_NONE)
+            return false;
+
+        positionArray[index] = t.position;
+        rotationArray[index] = t.rotation;
+        scaleArray[index] = t.scale;
+        return true;
+    }
+
+    /**
+     * Recomposes every world matrix, one pass over the dense arrays.
+     */
+    void updateWorlds()
+    {
+        toMatrices(positionArray.data(), rotationArray.data(), scaleArray.data(), worldArray.data(), worldArray.size());
+    }
+
+    std::size_t size() const
+    {
+        return positionArray.size();
+    }
+
+    void reserve(std::size_t count)
+    {
+        positionArray.reserve(count);
+        rotationArray.reserve(count);
+        scaleArray.reserve(count);
+        worldArray.reserve(count);
+        denseSlots.reserve(count);
+        slots.reserve(count);
+    }
+
+    /**
+     * Destroys everything; outstanding handles become invalid.
+     */
+    void clear()
+    {
+        while (!denseSlots.empty())
+            destroy(handleAt(static_cast<uint32_t>(denseSlots.size() - 1)));
+    }
+
+    // the dense arrays, size() long, for batch kernels
+    vec3* positions() { return positionArray.data(); }
+    const vec3* positions() const { return positionArray.data(); }
+    quaternion* rotations() { return rotationArray.data(); }
+    const quaternion* rotations() const { return rotationArray.data(); }
+    vec3* scales() { return scaleArray.data(); }
+    const vec3* scales() const { return scaleArray.data(); }
+    mat4* worlds() { return worldArray.data(); }
+    const mat4* worlds() const { return worldArray.data(); }
+
+private:
+    struct slotEntry {
+        uint32_t dense { POOL_NONE };
+        uint32_t generation { 1 };
+    };
+
+    std::vector<vec3> positionArray;
+    std::vector<quaternion> rotationArray;
+    std::vector<vec3> scaleArray;
+    std::vector<mat4> worldArray;
+    std::vector<uint32_t> denseSlots;
+    std::vector<slotEntry> slots;
+    std::vector<uint32_t> freeSlots;
+};
+} // namespace lia
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "mathbase.h"
+#include "mat4.h"
+#include "transform.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lia {
+namespace detail {
+    constexpr std::size_t CACHE_LINE = 64;
+    constexpr uint32_t TRIPLE_BUFFER_FRESH = 4u;
+} // namespace detail
+
+/**
+ * Three arrays of count values passed from one writer thread to one reader
+ * thread without locks or copies. The writer fills its buffer and publishes
+ * it; the reader picks up the latest published buffer and keeps it until it
+ * asks again. Each side only ever swaps its own buffer with the middle one,
+ * an atomic index, so neither waits on the other and frames the reader is
+ * too slow for are skipped.
+ *
+ * The indices live on separate cache lines, so the two threads do not
+ * invalidate each other's lines between swaps.
+ */
+template <typename T>
+struct tripleBuffer {
+    tripleBuffer() = default;
+
+    explicit tripleBuffer(std::size_t count)
+    {
+        resize(count);
+    }
+
+    tripleBuffer(const tripleBuffer&) = delete;
+    tripleBuffer& operator=(const tripleBuffer&) = delete;
+
+    /**
+     * Not thread safe; call before the threads start.
+     */
+    void resize(std::size_t count)
+    {
+        for (std::vector<T>& buffer : buffers)
+            buffer.assign(count, T());
+    }
+
+    std::size_t size() const
+    {
+        return buffers[0].size();
+    }
+
+    /**
+     * The writer's buffer. After a publish it holds whatever frame the
+     * reader last gave back, so write every entry, or copy from the frame
+     * just published.
+     */
+    T* writeBuffer()
+    {
+        return buffers[writer.index].data();
+    }
+
+    /**
+     * Makes the write buffer the latest frame and takes another to write.
+     */
+    void publish()
+    {
+        writer.index = middle.value.exchange(writer.index | detail::TRIPLE_BUFFER_FRESH, std::memory_order_acq_rel) & 3u;
+    }
+
+    /**
+     * Takes the latest published frame, if there is one newer than the
+     * frame being read.
+     *
+     * @return True when readBuffer changed
+     */
+    bool acquire()
+    {
+        if (!(middle.value.load(std::memory_order_relaxed) & detail::TRIPLE_BUFFER_FRESH))
+            return false;
+
+        reader.index = middle.value.exchange(reader.index, std::memory_order_acq_rel) & 3u;
+        return true;
+    }
+
+    /**
+     * The reader's frame, stable until the next acquire.
+     */
+    const T* readBuffer() const
+    {
+        return buffers[reader.index].data();
+    }
+
+private:
+    struct alignas(detail::CACHE_LINE) ownedIndex {
+        uint32_t index;
+    };
+
+    struct alignas(detail::CACHE_LINE) sharedIndex {
+        std::atomic<uint32_t> value;
+    };
+
+    std::vector<T> buffers[3];
+    ownedIndex writer { 0u };
+    sharedIndex middle { { 1u } };
+    ownedIndex reader { 2u };
+};
+
+/**
+ * Transforms handed from simulation to rendering each frame.
+ */
+using transformStore = tripleBuffer<transform>;
+
+/**
+ * World matrices handed from simulation to rendering each frame.
+ */
+using matrixStore = tripleBuffer<mat4>;
+} // namespace lia
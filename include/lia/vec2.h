@@ -137,7 +137,7 @@ inline float dot(const vec2& v1, const vec2& v2)
 
 inline vec2 rotatePoint(float angle, vec2 point, vec2 origin)
 {
-    return vec2(cos(angle) * (point.x - origin.x) - sin(angle) * (point.y - origin.y) + origin.x,
-                sin(angle) * (point.x - origin.x) + cos(angle) * (point.y - origin.y) + origin.y);
+    return vec2(fcos(angle) * (point.x - origin.x) - fsin(angle) * (point.y - origin.y) + origin.x,
+                fsin(angle) * (point.x - origin.x) + fcos(angle) * (point.y - origin.y) + origin.y);
 }
 } // namespace lia
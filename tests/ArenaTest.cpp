@@ -0,0 +1,83 @@
+#include "doctest.h"
+
+#include <lia/arena.h>
+#include <lia/mat4.h>
+#include <lia/vec4.h>
+
+#include <cstdint>
+#include <thread>
+
+namespace test {
+
+TEST_CASE("Frame arena")
+{
+    SUBCASE("Allocation")
+    {
+        lia::frameArena arena(4096);
+        REQUIRE(arena.capacity() == 0);
+
+        void* first = arena.allocate(10);
+        REQUIRE(reinterpret_cast<uintptr_t>(first) % lia::ARENA_ALIGNMENT == 0);
+        void* second = arena.allocate(3, 1);
+        REQUIRE(static_cast<uint8_t*>(second) == static_cast<uint8_t*>(first) + 10);
+        void* third = arena.allocate(8, 16);
+        REQUIRE(reinterpret_cast<uintptr_t>(third) % 16 == 0);
+        REQUIRE(arena.used() == 24);
+
+        lia::mat4* matrices = arena.allocateArray<lia::mat4>(10);
+        REQUIRE(reinterpret_cast<uintptr_t>(matrices) % alignof(lia::mat4) == 0);
+        REQUIRE(matrices[9](3, 3) == 1.0f);
+
+        // the same memory comes back after a reset
+        arena.reset();
+        REQUIRE(arena.used() == 0);
+        REQUIRE(arena.allocate(10) == first);
+
+        const lia::arenaMarker marker = arena.mark();
+        lia::vec4* scratch = arena.allocateArray<lia::vec4>(100);
+        arena.rewind(marker);
+        REQUIRE(arena.allocateArray<lia::vec4>(100) == scratch);
+    }
+
+    SUBCASE("Growth")
+    {
+        lia::frameArena arena(1024);
+        for (int i = 0; i < 10; ++i)
+            arena.allocate(700);
+        void* big = arena.allocate(5000);
+        REQUIRE(big != nullptr);
+        REQUIRE(arena.capacity() >= 5000 + 10 * 700);
+        REQUIRE(arena.used() >= 5000 + 10 * 700);
+
+        // one block afterwards, big enough for the whole frame
+        const std::size_t capacity = arena.capacity();
+        arena.reset();
+        REQUIRE(arena.capacity() == capacity);
+        uint8_t* start = static_cast<uint8_t*>(arena.allocate(700));
+        for (int i = 1; i < 10; ++i)
+            REQUIRE(static_cast<uint8_t*>(arena.allocate(700, 4)) == start + 700 * i);
+        REQUIRE(arena.capacity() == capacity);
+    }
+
+    SUBCASE("STL allocator")
+    {
+        lia::frameArena arena;
+        lia::arenaVector<uint32_t> indices(arena);
+        for (uint32_t i = 0; i < 10000; ++i)
+            indices.push_back(i * 3u);
+        REQUIRE(indices[9999] == 29997u);
+        REQUIRE(arena.used() >= 10000 * sizeof(uint32_t));
+
+        lia::arenaVector<lia::vec4> points(50, lia::vec4(1.0f, 2.0f, 3.0f, 4.0f), lia::arenaAllocator<lia::vec4>(arena));
+        REQUIRE(points[49].w == 4.0f);
+        REQUIRE(indices.get_allocator() == lia::arenaAllocator<float>(arena));
+
+        lia::frameArena* mine = &lia::threadArena();
+        lia::frameArena* other = nullptr;
+        std::thread thread([&]() { other = &lia::threadArena(); });
+        thread.join();
+        REQUIRE(mine != other);
+    }
+}
+
+} // namespace test
@@ -0,0 +1,121 @@
+#include "doctest.h"
+
+#include <lia/binary.h>
+#include <lia/random.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace test {
+
+TEST_CASE("Binary files")
+{
+    lia::pcg32 rng(5u);
+    std::vector<lia::vec3> positions(1000);
+    lia::randomVec3(rng, positions.data(), positions.size());
+    std::vector<lia::quaternion> rotations(1000);
+    std::vector<lia::mat4> locals(1000);
+    std::vector<uint32_t> parents(1000);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        rotations[i] = lia::rotationY(static_cast<float>(i) * 0.01f);
+        locals[i] = lia::translate(lia::mat4(), positions[i]);
+        parents[i] = i == 0 ? 0xFFFFFFFFu : (i - 1) / 4;
+    }
+
+    lia::binaryWriter writer;
+    writer.add("positions", positions.data(), positions.size());
+    writer.add("rotations", rotations.data(), rotations.size());
+    writer.add("locals", locals.data(), locals.size(), lia::binaryCompression::shuffleRle);
+    writer.add("parents", parents.data(), parents.size(), lia::binaryCompression::shuffleRle);
+
+    SUBCASE("In memory")
+    {
+        std::vector<uint8_t> bytes;
+        writer.write(bytes);
+
+        lia::binaryView view;
+        REQUIRE(view.open(bytes.data(), bytes.size()));
+        REQUIRE_EQ(view.sectionCount(), 4u);
+
+        // uncompressed sections are used in place, aligned
+        std::size_t count = 0;
+        const lia::vec3* mapped = view.get<lia::vec3>("positions", count);
+        REQUIRE_EQ(count, positions.size());
+        REQUIRE(mapped >= reinterpret_cast<const lia::vec3*>(bytes.data()));
+        REQUIRE_EQ((reinterpret_cast<const uint8_t*>(mapped) - bytes.data()) % lia::BINARY_ALIGNMENT, 0);
+        REQUIRE(std::memcmp(mapped, positions.data(), positions.size() * sizeof(lia::vec3)) == 0);
+
+        // wrong type, compressed or missing sections are not handed out
+        REQUIRE(view.get<lia::vec4>("positions", count) == nullptr);
+        REQUIRE(view.get<lia::mat4>("locals", count) == nullptr);
+        REQUIRE(view.get<lia::vec3>("missing", count) == nullptr);
+
+        // the repeated zeros and ones of transforms compress well
+        const lia::binarySection* section = view.find("locals");
+        REQUIRE(section->storedSize < locals.size() * sizeof(lia::mat4) / 2);
+
+        std::vector<lia::mat4> readLocals;
+        REQUIRE(view.read("locals", readLocals));
+        REQUIRE(std::memcmp(readLocals.data(), locals.data(), locals.size() * sizeof(lia::mat4)) == 0);
+        std::vector<uint32_t> readParents;
+        REQUIRE(view.read("parents", readParents));
+        REQUIRE(readParents == parents);
+    }
+
+    SUBCASE("Corrupt input is rejected")
+    {
+        std::vector<uint8_t> bytes;
+        writer.write(bytes);
+
+        lia::binaryView view;
+        REQUIRE_FALSE(view.open(bytes.data(), bytes.size() - 1));
+        REQUIRE_FALSE(view.open(bytes.data(), 10));
+
+        std::vector<uint8_t> badVersion = bytes;
+        badVersion[8] = 99;
+        REQUIRE_FALSE(view.open(badVersion.data(), badVersion.size()));
+
+        // a section running past the end of the file
+        std::vector<uint8_t> badSection = bytes;
+        reinterpret_cast<lia::binarySection*>(badSection.data() + sizeof(lia::binaryHeader))->storedSize = bytes.size();
+        REQUIRE_FALSE(view.open(badSection.data(), badSection.size()));
+        REQUIRE_EQ(view.sectionCount(), 0u);
+
+        // a compressed section claiming more than its bytes can expand to
+        std::vector<uint8_t> badCount = bytes;
+        reinterpret_cast<lia::binarySection*>(badCount.data() + sizeof(lia::binaryHeader))[2].count = uint64_t(1) << 44;
+        REQUIRE_FALSE(view.open(badCount.data(), badCount.size()));
+
+        // a section table offset whose end wraps around to a small number
+        std::vector<uint8_t> badTable = bytes;
+        reinterpret_cast<lia::binaryHeader*>(badTable.data())->sectionTableOffset = UINT64_MAX - 7;
+        REQUIRE_FALSE(view.open(badTable.data(), badTable.size()));
+
+        std::vector<uint8_t> tooManySections = bytes;
+        reinterpret_cast<lia::binaryHeader*>(tooManySections.data())->sectionCount = UINT32_MAX;
+        REQUIRE_FALSE(view.open(tooManySections.data(), tooManySections.size()));
+    }
+
+    SUBCASE("Mapped from disk")
+    {
+        const char* path = "lia_binary_test.bin";
+        REQUIRE(writer.write(path));
+
+        lia::mappedFile file;
+        REQUIRE(file.open(path));
+        lia::binaryView view;
+        REQUIRE(view.open(file.data(), file.size()));
+
+        std::size_t count = 0;
+        const lia::quaternion* mapped = view.get<lia::quaternion>("rotations", count);
+        REQUIRE_EQ(count, rotations.size());
+        REQUIRE_EQ(reinterpret_cast<uintptr_t>(mapped) % lia::BINARY_ALIGNMENT, 0u);
+        REQUIRE(mapped[500].y == rotations[500].y);
+
+        file.close();
+        std::remove(path);
+    }
+}
+
+} // namespace test
@@ -0,0 +1,141 @@
+#include "doctest.h"
+
+#include <lia/clip2d.h>
+
+#include <cmath>
+#include <vector>
+
+namespace test {
+
+static float SetArea(const lia::polygonSet& set)
+{
+    float sum = 0.0f;
+    for (std::size_t i = 0; i < set.size(); ++i)
+        sum += lia::area(set.polygon(i), set.polygonSize(i));
+
+    return sum;
+}
+
+TEST_CASE("Polygon clipping")
+{
+    const lia::vec2 squareA[4] = { lia::vec2(0.0f, 0.0f), lia::vec2(2.0f, 0.0f), lia::vec2(2.0f, 2.0f), lia::vec2(0.0f, 2.0f) };
+    const lia::vec2 squareB[4] = { lia::vec2(1.0f, 1.0f), lia::vec2(3.0f, 1.0f), lia::vec2(3.0f, 3.0f), lia::vec2(1.0f, 3.0f) };
+    const lia::vec2 diamond[4] = { lia::vec2(1.0f, -0.5f), lia::vec2(2.5f, 1.0f), lia::vec2(1.0f, 2.5f), lia::vec2(-0.5f, 1.0f) };
+
+    lia::polygonSet a, b, result;
+    a.addPolygon(squareA, 4);
+    b.addPolygon(squareB, 4);
+
+    lia::polygonClipper clipper;
+
+    SUBCASE("Boolean operations")
+    {
+        clipper.computePieces(a, b, lia::booleanOp::intersection, result);
+        REQUIRE(SetArea(result) == doctest::Approx(1.0f));
+        REQUIRE_EQ(result.size(), 1u);
+
+        clipper.computePieces(a, b, lia::booleanOp::unite, result);
+        REQUIRE(SetArea(result) == doctest::Approx(7.0f));
+
+        clipper.computePieces(a, b, lia::booleanOp::difference, result);
+        REQUIRE(SetArea(result) == doctest::Approx(3.0f));
+
+        clipper.computePieces(a, b, lia::booleanOp::exclusiveOr, result);
+        REQUIRE(SetArea(result) == doctest::Approx(6.0f));
+
+        // every piece is convex and counter-clockwise
+        for (std::size_t i = 0; i < result.size(); ++i)
+            REQUIRE(lia::area(result.polygon(i), result.polygonSize(i)) > 0.0f);
+    }
+
+    SUBCASE("Crossing edges")
+    {
+        lia::polygonSet d;
+        d.addPolygon(diamond, 4);
+
+        clipper.computePieces(a, d, lia::booleanOp::intersection, result);
+        REQUIRE(SetArea(result) == doctest::Approx(3.5f));
+
+        clipper.computePieces(d, a, lia::booleanOp::difference, result);
+        REQUIRE(SetArea(result) == doctest::Approx(4.5f - 3.5f));
+    }
+
+    SUBCASE("Holes and winding")
+    {
+        // a clockwise inner square cuts a hole under the non-zero rule
+        const lia::vec2 hole[4] = { lia::vec2(0.5f, 0.5f), lia::vec2(0.5f, 1.5f), lia::vec2(1.5f, 1.5f), lia::vec2(1.5f, 0.5f) };
+        lia::polygonSet withHole = a;
+        withHole.addPolygon(hole, 4);
+
+        lia::polygonSet empty;
+        clipper.computePieces(withHole, empty, lia::booleanOp::unite, result);
+        REQUIRE(SetArea(result) == doctest::Approx(3.0f));
+
+        clipper.computePieces(withHole, b, lia::booleanOp::intersection, result);
+        REQUIRE(SetArea(result) == doctest::Approx(0.75f));
+    }
+
+    SUBCASE("Pieces lie on the grid")
+    {
+        lia::polygonSet d;
+        d.addPolygon(diamond, 4);
+        clipper.snap = 0.1f;
+        clipper.computePieces(a, d, lia::booleanOp::exclusiveOr, result);
+
+        REQUIRE(result.size() > 1u);
+        for (const lia::vec2& p : result.points) {
+            REQUIRE(p.x / clipper.snap == doctest::Approx(std::round(p.x / clipper.snap)));
+            REQUIRE(p.y / clipper.snap == doctest::Approx(std::round(p.y / clipper.snap)));
+        }
+        for (std::size_t i = 0; i < result.size(); ++i)
+            REQUIRE(lia::area(result.polygon(i), result.polygonSize(i)) > 0.0f);
+    }
+
+    SUBCASE("Convex clipping")
+    {
+        lia::vec2 out[16], scratch[16];
+        const std::size_t count = lia::clipConvex(diamond, 4, squareA, 4, out, 16, scratch);
+        REQUIRE_EQ(count, 8u);
+        REQUIRE(lia::area(out, count) == doctest::Approx(3.5f));
+
+        // a capacity of 0 measures, and a short buffer gets the leading points
+        REQUIRE_EQ(lia::clipConvex(diamond, 4, squareA, 4, nullptr, 0, scratch), count);
+        lia::vec2 partial[3];
+        REQUIRE_EQ(lia::clipConvex(diamond, 4, squareA, 4, partial, 3, scratch), count);
+        for (int i = 0; i < 3; ++i)
+            REQUIRE((partial[i].x == out[i].x && partial[i].y == out[i].y));
+
+        const std::size_t triangleCount = lia::clipConvex(squareB, 4, squareA, 3, out, 16, scratch);
+        REQUIRE(lia::area(out, triangleCount) == doctest::Approx(0.5f));
+    }
+
+    SUBCASE("Concave subject against a convex region")
+    {
+        // every tooth of the comb pokes out through the top with one vertex and comes back with two
+        lia::vec2 comb[3 * 3 + 3];
+        std::size_t n = 0;
+        comb[n++] = lia::vec2(0.0f, -0.5f);
+        comb[n++] = lia::vec2(1.8f, -0.5f);
+        for (int t = 2; t >= 0; --t) {
+            const float x = 0.6f * static_cast<float>(t);
+            comb[n++] = lia::vec2(x + 0.5f, 0.0f);
+            comb[n++] = lia::vec2(x + 0.35f, 3.0f);
+            comb[n++] = lia::vec2(x + 0.2f, 0.0f);
+        }
+        comb[n++] = lia::vec2(0.0f, 0.0f);
+
+        lia::vec2 scratch[8];
+        const std::size_t needed = lia::clipConvex(comb, n, squareA, 4, nullptr, 0, scratch);
+        REQUIRE(needed > n);
+
+        std::vector<lia::vec2> out(needed), buffer(needed);
+        REQUIRE_EQ(lia::clipConvex(comb, n, squareA, 4, out.data(), out.size(), buffer.data()), needed);
+
+        lia::polygonSet combSet;
+        combSet.addPolygon(comb, n);
+        clipper.computePieces(combSet, a, lia::booleanOp::intersection, result);
+        REQUIRE(lia::area(out.data(), needed) == doctest::Approx(SetArea(result)).epsilon(0.01));
+    }
+}
+
+} // namespace test
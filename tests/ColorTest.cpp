@@ -0,0 +1,105 @@
+#include "doctest.h"
+
+#include <lia/color.h>
+
+namespace test {
+
+static void CompareColors(const lia::vec3& c1, const lia::vec3& c2, double epsilon = 1e-4)
+{
+    REQUIRE(c1.x == doctest::Approx(c2.x).epsilon(epsilon));
+    REQUIRE(c1.y == doctest::Approx(c2.y).epsilon(epsilon));
+    REQUIRE(c1.z == doctest::Approx(c2.z).epsilon(epsilon));
+}
+
+TEST_CASE("Color")
+{
+    const lia::vec3 colors[] = {
+        lia::vec3(0.8f, 0.3f, 0.1f),
+        lia::vec3(0.05f, 0.6f, 0.9f),
+        lia::vec3(0.5f, 0.5f, 0.5f),
+        lia::vec3(0.001f, 0.2f, 0.002f)
+    };
+
+    SUBCASE("sRGB")
+    {
+        REQUIRE(lia::srgbToLinear(0.5f) == doctest::Approx(0.2140411f));
+        REQUIRE(lia::linearToSrgb(lia::srgbToLinear(0.7f)) == doctest::Approx(0.7f));
+
+        lia::vec3 exact[4], fast[4], lut[4];
+        lia::srgbToLinear(colors, exact, 4);
+        lia::srgbToLinear(colors, fast, 4, lia::srgbMethod::fast);
+        lia::srgbToLinear(colors, lut, 4, lia::srgbMethod::lut);
+        for (int i = 0; i < 4; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                REQUIRE(std::abs(fast[i][c] - exact[i][c]) < 0.005f);
+                REQUIRE(std::abs(lut[i][c] - exact[i][c]) < 0.001f);
+            }
+        }
+
+        // the fast curves against the exact ones over the whole range, near black included
+        for (int i = 0; i <= 4096; ++i) {
+            const float c = static_cast<float>(i) / 4096.0f;
+            const float linear = lia::srgbToLinear(c);
+            const float srgb = lia::linearToSrgb(c);
+            REQUIRE(std::abs(lia::srgbToLinearFast(c) - linear) <= 0.0015f * linear);
+            REQUIRE(std::abs(lia::linearToSrgbFast(c) - srgb) <= 0.0004f * srgb);
+        }
+
+        lia::vec4 rgba[1] = { lia::vec4(0.5f, 0.5f, 0.5f, 0.25f) };
+        lia::linearToSrgb(rgba, rgba, 1, lia::srgbMethod::fast);
+        REQUIRE(rgba[0].x == doctest::Approx(0.7353569f).epsilon(0.005));
+        REQUIRE_EQ(rgba[0].w, 0.25f);
+
+        const uint8_t bytes[3] = { 0, 128, 255 };
+        lia::vec3 decoded;
+        lia::srgb8ToLinear(bytes, &decoded, 1);
+        REQUIRE_EQ(decoded.x, 0.0f);
+        REQUIRE(decoded.y == doctest::Approx(0.2158605f));
+        REQUIRE(decoded.z == doctest::Approx(1.0f));
+    }
+
+    SUBCASE("Color spaces")
+    {
+        CompareColors(lia::rgbToHsv(lia::vec3(1.0f, 0.0f, 0.0f)), lia::vec3(0.0f, 1.0f, 1.0f));
+        CompareColors(lia::rgbToHsl(lia::vec3(0.0f, 0.0f, 1.0f)), lia::vec3(2.0f / 3.0f, 1.0f, 0.5f));
+        CompareColors(lia::linearToOklab(lia::vec3(1.0f)), lia::vec3(1.0f, 0.0f, 0.0f), 1e-3);
+
+        for (const lia::vec3& c : colors) {
+            CompareColors(lia::hsvToRgb(lia::rgbToHsv(c)), c);
+            CompareColors(lia::hslToRgb(lia::rgbToHsl(c)), c);
+            CompareColors(lia::oklabToLinear(lia::linearToOklab(c)), c, 1e-3);
+            CompareColors(lia::yCoCgToRgb(lia::rgbToYCoCg(c)), c);
+        }
+
+        lia::vec3 lab[4];
+        lia::convertColors(colors, lab, 4, lia::linearToOklab);
+        CompareColors(lab[1], lia::linearToOklab(colors[1]));
+    }
+
+    SUBCASE("Tone mapping")
+    {
+        const lia::vec3 hdr[] = { lia::vec3(0.0f), lia::vec3(0.18f), lia::vec3(1.0f), lia::vec3(16.0f, 4.0f, 100.0f) };
+
+        lia::vec3 mapped[4];
+        lia::aces(hdr, mapped, 4);
+        REQUIRE(mapped[0].x == doctest::Approx(0.0f));
+        REQUIRE(mapped[3].z <= 1.0f);
+        REQUIRE(mapped[1].x < mapped[2].x);
+
+        lia::reinhard(hdr, mapped, 4);
+        REQUIRE(mapped[2].y == doctest::Approx(0.5f));
+        CompareColors(lia::reinhardExtended(lia::vec3(4.0f), 4.0f), lia::vec3(1.0f));
+
+        lia::agx(hdr, mapped, 4);
+        for (const lia::vec3& c : mapped) {
+            for (int i = 0; i < 3; ++i) {
+                REQUIRE(c[i] >= 0.0f);
+                REQUIRE(c[i] <= 1.0f);
+            }
+        }
+        REQUIRE(mapped[1].x < mapped[2].x);
+        REQUIRE(mapped[2].x < mapped[3].x);
+    }
+}
+
+} // namespace test
@@ -0,0 +1,112 @@
+#include "doctest.h"
+
+#include <lia/curves.h>
+
+namespace test {
+
+TEST_CASE("Curves")
+{
+    const lia::vec3 p0(0.0f, 0.0f, 0.0f), p1(1.0f, 2.0f, 0.0f), p2(3.0f, 2.0f, 1.0f), p3(4.0f, 0.0f, 1.0f);
+
+    SUBCASE("Bezier")
+    {
+        const lia::cubicCurve<lia::vec3> curve = lia::bezierCurve(p0, p1, p2, p3);
+
+        const lia::vec3 end = curve.position(1.0f);
+        REQUIRE(end.x == doctest::Approx(4.0f));
+        REQUIRE(end.z == doctest::Approx(1.0f));
+
+        const lia::vec3 mid = curve.position(0.5f);
+        REQUIRE(mid.x == doctest::Approx(2.0f));
+        REQUIRE(mid.y == doctest::Approx(1.5f));
+
+        const lia::vec3 startTangent = curve.tangent(0.0f);
+        REQUIRE(startTangent.y == doctest::Approx(6.0f));
+
+        lia::vec3 c0, c1, c2, c3;
+        curve.controlPoints(c0, c1, c2, c3);
+        REQUIRE(c2.x == doctest::Approx(3.0f));
+        REQUIRE(c2.z == doctest::Approx(1.0f));
+
+        const float t[3] = { 0.0f, 0.25f, 0.5f };
+        lia::vec3 positions[3], tangents[3];
+        lia::evaluate(curve, t, positions, tangents, 3);
+        REQUIRE_EQ(positions[2].y, mid.y);
+        REQUIRE_EQ(tangents[0].y, startTangent.y);
+    }
+
+    SUBCASE("Splines")
+    {
+        const lia::cubicCurve<lia::vec2> catmullRom = lia::catmullRomCurve(lia::vec2(0.0f), lia::vec2(1.0f, 0.0f), lia::vec2(2.0f, 1.0f), lia::vec2(3.0f, 1.0f));
+        REQUIRE(catmullRom.position(0.0f).x == doctest::Approx(1.0f));
+        REQUIRE(catmullRom.position(1.0f).y == doctest::Approx(1.0f));
+        REQUIRE(catmullRom.tangent(0.0f).x == doctest::Approx(1.0f));
+
+        const lia::cubicCurve<lia::vec2> hermite = lia::hermiteCurve(lia::vec2(0.0f), lia::vec2(1.0f, 0.0f), lia::vec2(1.0f), lia::vec2(0.0f, 1.0f));
+        REQUIRE(hermite.tangent(1.0f).y == doctest::Approx(1.0f));
+        REQUIRE(hermite.tangent(1.0f).x == doctest::Approx(0.0f));
+
+        // a B-spline of collinear, evenly spaced points is a straight constant-speed line
+        const lia::cubicCurve<lia::vec2> bspline = lia::bsplineCurve(lia::vec2(0.0f), lia::vec2(1.0f), lia::vec2(2.0f), lia::vec2(3.0f));
+        REQUIRE(bspline.position(0.0f).x == doctest::Approx(1.0f));
+        REQUIRE(bspline.position(0.5f).y == doctest::Approx(1.5f));
+    }
+
+    SUBCASE("Arc length")
+    {
+        const lia::cubicCurve<lia::vec3> line = lia::bezierCurve(lia::vec3(0.0f), lia::vec3(0.1f, 0.0f, 0.0f), lia::vec3(0.2f, 0.0f, 0.0f), lia::vec3(3.0f, 0.0f, 0.0f));
+        const lia::arcLengthTable<lia::vec3> table(line, 256);
+        REQUIRE(table.totalLength() == doctest::Approx(3.0f));
+
+        lia::vec3 samples[4];
+        lia::sampleUniform(line, table, samples, 4);
+        REQUIRE(samples[1].x == doctest::Approx(1.0f).epsilon(0.01));
+        REQUIRE(samples[2].x == doctest::Approx(2.0f).epsilon(0.01));
+        REQUIRE(samples[3].x == doctest::Approx(3.0f));
+
+        const lia::arcLengthTable<lia::vec3> empty;
+        REQUIRE(empty.totalLength() == 0.0f);
+        REQUIRE(empty.parameterAt(1.0f) == 0.0f);
+    }
+
+    SUBCASE("Flattening")
+    {
+        const lia::cubicCurve<lia::vec3> curve = lia::bezierCurve(p0, p1, p2, p3);
+
+        const std::size_t coarse = lia::flatten(curve, 0.1f, static_cast<lia::vec3*>(nullptr), 0);
+        const std::size_t fine = lia::flatten(curve, 0.001f, static_cast<lia::vec3*>(nullptr), 0);
+        REQUIRE(coarse >= 3);
+        REQUIRE(fine > coarse);
+
+        std::vector<lia::vec3> points(fine);
+        REQUIRE_EQ(lia::flatten(curve, 0.001f, points.data(), points.size()), fine);
+        REQUIRE_EQ(points.front().x, 0.0f);
+        REQUIRE(points.back().x == doctest::Approx(4.0f));
+        for (std::size_t i = 1; i < points.size(); ++i)
+            REQUIRE(points[i].x >= points[i - 1].x);
+    }
+
+    SUBCASE("Squad")
+    {
+        const lia::quaternion keys[4] = { lia::rotationY(0.0f), lia::rotationY(0.5f), lia::rotationY(1.2f), lia::rotationY(1.5f) };
+        const lia::quaternion s1 = lia::squadControl(keys[0], keys[1], keys[2]);
+        const lia::quaternion s2 = lia::squadControl(keys[1], keys[2], keys[3]);
+
+        const lia::quaternion start = lia::squad(keys[1], keys[2], s1, s2, 0.0f);
+        const lia::quaternion end = lia::squad(keys[1], keys[2], s1, s2, 1.0f);
+        REQUIRE(start.y == doctest::Approx(keys[1].y));
+        REQUIRE(end.w == doctest::Approx(keys[2].w));
+
+        const float t[2] = { 0.25f, 0.75f };
+        lia::quaternion out[2];
+        lia::squad(keys[1], keys[2], s1, s2, t, out, 2);
+        REQUIRE(lia::dot(out[0], out[0]) == doctest::Approx(1.0f));
+        REQUIRE(out[0].y > keys[1].y);
+        REQUIRE(out[1].y < keys[2].y);
+
+        const lia::quaternion half = lia::slerp(keys[0], keys[2], 0.5f);
+        REQUIRE(half.y == doctest::Approx(lia::rotationY(0.6f).y));
+    }
+}
+
+} // namespace test
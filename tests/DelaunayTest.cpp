@@ -0,0 +1,132 @@
+#include "doctest.h"
+
+#include <lia/delaunay.h>
+#include <lia/random.h>
+
+#include <vector>
+
+namespace test {
+
+static void CheckTriangulation(const lia::delaunayTriangulation& dt, const std::vector<lia::vec2>& points, bool delaunay)
+{
+    const std::vector<uint32_t>& t = dt.triangles;
+    for (std::size_t e = 0; e < t.size(); ++e) {
+        const uint32_t twin = dt.halfedges[e];
+        if (twin == lia::DELAUNAY_INVALID)
+            continue;
+
+        REQUIRE_EQ(dt.halfedges[twin], e);
+        REQUIRE_EQ(t[twin], t[e % 3 == 2 ? e - 2 : e + 1]);
+        REQUIRE_EQ(dt.constrained[twin], dt.constrained[e]);
+
+        // locally Delaunay: the opposite vertex across every unconstrained edge is outside the circumcircle
+        if (delaunay && !dt.constrained[e]) {
+            const std::size_t base = e - e % 3;
+            const uint32_t opposite = t[twin % 3 == 0 ? twin + 2 : twin - 1];
+            REQUIRE(lia::incircle(points[t[base]], points[t[base + 1]], points[t[base + 2]], points[opposite]) <= 0.0);
+        }
+    }
+
+    for (std::size_t i = 0; i < dt.triangleCount(); ++i)
+        REQUIRE(lia::orient2d(points[t[3 * i]], points[t[3 * i + 1]], points[t[3 * i + 2]]) > 0.0);
+}
+
+TEST_CASE("Delaunay triangulation")
+{
+    lia::delaunayTriangulation dt;
+
+    SUBCASE("Grid with cocircular points")
+    {
+        std::vector<lia::vec2> points;
+        for (int y = 0; y < 10; ++y) {
+            for (int x = 0; x < 10; ++x)
+                points.push_back(lia::vec2(static_cast<float>(x), static_cast<float>(y)));
+        }
+
+        dt.build(points.data(), points.size());
+        REQUIRE_EQ(dt.triangleCount(), 162u);
+        CheckTriangulation(dt, points, true);
+    }
+
+    SUBCASE("Random points and duplicates")
+    {
+        lia::pcg32 rng(3u);
+        std::vector<lia::vec2> points(2000);
+        for (lia::vec2& p : points)
+            p = lia::vec2(static_cast<float>(rng.next() >> 8) / 16777216.0f, static_cast<float>(rng.next() >> 8) / 16777216.0f);
+        points[100] = points[7];
+        points[1999] = points[7];
+
+        dt.build(points.data(), points.size());
+        CheckTriangulation(dt, points, true);
+
+        std::size_t hull = 0;
+        for (uint32_t h : dt.halfedges)
+            hull += h == lia::DELAUNAY_INVALID;
+        REQUIRE_EQ(dt.triangleCount(), 2 * 1998 - 2 - hull);
+    }
+
+    SUBCASE("Collinear input")
+    {
+        const lia::vec2 points[4] = { lia::vec2(0.0f, 0.0f), lia::vec2(1.0f, 1.0f), lia::vec2(2.0f, 2.0f), lia::vec2(3.0f, 3.0f) };
+        dt.build(points, 4);
+        REQUIRE_EQ(dt.triangleCount(), 0u);
+    }
+
+    SUBCASE("Constrained edges")
+    {
+        lia::pcg32 rng(11u);
+        std::vector<lia::vec2> points;
+        points.push_back(lia::vec2(0.0f, 0.5f));
+        points.push_back(lia::vec2(1.0f, 0.5f));
+        for (int i = 0; i < 300; ++i)
+            points.push_back(lia::vec2(static_cast<float>(rng.next() >> 8) / 16777216.0f, static_cast<float>(rng.next() >> 8) / 16777216.0f));
+
+        dt.build(points.data(), points.size());
+        const std::size_t count = dt.triangleCount();
+
+        REQUIRE(dt.addConstraint(points.data(), 0, 1));
+        REQUIRE_EQ(dt.triangleCount(), count);
+        CheckTriangulation(dt, points, true);
+
+        // the segment is now a chain of constrained edges
+        std::size_t length = 0;
+        for (std::size_t e = 0; e < dt.triangles.size(); ++e) {
+            if (dt.constrained[e] && dt.triangles[e] < dt.triangles[e % 3 == 2 ? e - 2 : e + 1])
+                ++length;
+        }
+        REQUIRE(length >= 1u);
+
+        // a crossing constraint is refused
+        points.push_back(lia::vec2(0.5f, 0.0f));
+        points.push_back(lia::vec2(0.5f, 1.0f));
+        dt.build(points.data(), points.size());
+        REQUIRE(dt.addConstraint(points.data(), 0, 1));
+        REQUIRE_FALSE(dt.addConstraint(points.data(), 302, 303));
+        CheckTriangulation(dt, points, true);
+    }
+
+    SUBCASE("Voronoi cells")
+    {
+        std::vector<lia::vec2> points;
+        for (int y = 0; y < 3; ++y) {
+            for (int x = 0; x < 3; ++x)
+                points.push_back(lia::vec2(static_cast<float>(x), static_cast<float>(y)));
+        }
+
+        dt.build(points.data(), points.size());
+        lia::polygonSet cells;
+        lia::voronoi(dt, points.data(), points.size(), lia::vec2(-1.0f, -1.0f), lia::vec2(3.0f, 3.0f), cells);
+
+        REQUIRE_EQ(cells.size(), 9u);
+        REQUIRE(lia::area(cells.polygon(4), cells.polygonSize(4)) == doctest::Approx(1.0f));
+        REQUIRE(lia::area(cells.polygon(0), cells.polygonSize(0)) == doctest::Approx(2.25f));
+
+        float total = 0.0f;
+        for (std::size_t i = 0; i < cells.size(); ++i)
+            total += lia::area(cells.polygon(i), cells.polygonSize(i));
+        REQUIRE(total == doctest::Approx(16.0f));
+    }
+}
+
+} // namespace test
@@ -0,0 +1,133 @@
+#include "doctest.h"
+
+#include <lia/lia.h>
+
+#include <cmath>
+#include <vector>
+
+namespace test {
+
+TEST_CASE("Deterministic math")
+{
+    SUBCASE("Sine and cosine kernels")
+    {
+        for (float x = -1000.0f; x < 1000.0f; x += 0.0173f) {
+            const double exactSin = std::sin(static_cast<double>(x));
+            const double exactCos = std::cos(static_cast<double>(x));
+            REQUIRE(std::abs(lia::detail::deterministicSin(x) - exactSin) <= 6e-8 * std::max(1e-3, std::abs(exactSin)) + 1e-12);
+            REQUIRE(std::abs(lia::detail::deterministicCos(x) - exactCos) <= 6e-8 * std::max(1e-3, std::abs(exactCos)) + 1e-12);
+        }
+
+        REQUIRE(lia::detail::deterministicSin(0.0f) == 0.0f);
+        REQUIRE(lia::detail::deterministicCos(0.0f) == 1.0f);
+        REQUIRE(lia::detail::deterministicSin(1e-20f) == 1e-20f);
+        REQUIRE(std::isnan(lia::detail::deterministicSin(INFINITY)));
+        REQUIRE(std::abs(lia::detail::deterministicCos(1e30f)) <= 1.0f);
+    }
+
+    SUBCASE("Arc cosine")
+    {
+        for (float x = -1.0f; x <= 1.0f; x += 0.001f) {
+            const double exact = std::acos(static_cast<double>(x));
+            REQUIRE(std::abs(lia::detail::deterministicAcos(x) - exact) <= 1.2e-7 * exact + 1e-12);
+        }
+        REQUIRE(lia::detail::deterministicAcos(1.0f) == 0.0f);
+        REQUIRE(std::isnan(lia::detail::deterministicAcos(1.5f)));
+    }
+
+    SUBCASE("Tangent and arc tangent")
+    {
+        for (float x = -100.0f; x < 100.0f; x += 0.0173f) {
+            const double exact = std::tan(static_cast<double>(x));
+            REQUIRE(std::abs(lia::detail::deterministicTan(x) - exact) <= 1.2e-7 * std::max(1e-3, std::abs(exact)) + 1e-12);
+        }
+        REQUIRE(lia::detail::deterministicTan(0.0f) == 0.0f);
+
+        for (float y = -3.0f; y <= 3.0f; y += 0.37f) {
+            for (float x = -3.0f; x <= 3.0f; x += 0.29f) {
+                const double exact = std::atan2(static_cast<double>(y), static_cast<double>(x));
+                REQUIRE(std::abs(lia::detail::deterministicAtan2(y, x) - exact) <= 1.2e-7 * std::abs(exact) + 1e-12);
+            }
+        }
+
+        // the signed zeros and infinities of atan2
+        REQUIRE(lia::detail::deterministicAtan2(0.0f, 0.0f) == 0.0f);
+        REQUIRE(std::signbit(lia::detail::deterministicAtan2(-0.0f, 1.0f)));
+        REQUIRE(lia::detail::deterministicAtan2(0.0f, -0.0f) == static_cast<float>(lia::PI));
+        REQUIRE(lia::detail::deterministicAtan2(-1.0f, -INFINITY) == -static_cast<float>(lia::PI));
+        REQUIRE(lia::detail::deterministicAtan2(INFINITY, INFINITY) == static_cast<float>(lia::PI / 4.0));
+        REQUIRE(lia::detail::deterministicAtan2(1.0f, 0.0f) == static_cast<float>(lia::PI / 2.0));
+        REQUIRE(std::isnan(lia::detail::deterministicAtan2(NAN, 1.0f)));
+    }
+
+    SUBCASE("Powers and logarithms")
+    {
+        for (float x = 1e-6f; x < 1e6f; x *= 1.013f) {
+            REQUIRE(std::abs(lia::detail::deterministicLog2(x) - std::log2(static_cast<double>(x))) <= 1.2e-7 * std::abs(std::log2(static_cast<double>(x))) + 1e-12);
+            REQUIRE(std::abs(lia::detail::deterministicCbrt(x) - std::cbrt(static_cast<double>(x))) <= 1.2e-7 * std::cbrt(static_cast<double>(x)));
+            for (const float y : { 2.4f, 1.0f / 2.4f, -1.5f }) {
+                const double exact = std::pow(static_cast<double>(x), static_cast<double>(y));
+                REQUIRE(std::abs(lia::detail::deterministicPow(x, y) - exact) <= 1.2e-7 * exact);
+            }
+        }
+
+        // exact on powers of two, subnormals included, and at the ends of the float range
+        for (int e = -149; e < 128; ++e) {
+            REQUIRE(lia::detail::deterministicLog2(std::ldexp(1.0f, e)) == static_cast<float>(e));
+            REQUIRE(lia::detail::deterministicPow(2.0f, static_cast<float>(e)) == std::ldexp(1.0f, e));
+        }
+        REQUIRE(lia::detail::deterministicPow(2.0f, 128.0f) == INFINITY);
+        REQUIRE(lia::detail::deterministicPow(10.0f, -46.0f) == 0.0f);
+
+        REQUIRE(lia::detail::deterministicCbrt(27.0f) == 3.0f);
+        REQUIRE(lia::detail::deterministicCbrt(-8.0f) == -2.0f);
+        REQUIRE(lia::detail::deterministicLog2(1024.0f) == 10.0f);
+        REQUIRE(lia::detail::deterministicLog2(1e-45f) == -149.0f);
+        REQUIRE(lia::detail::deterministicLog2(0.0f) == -INFINITY);
+        REQUIRE(std::isnan(lia::detail::deterministicLog2(-1.0f)));
+        REQUIRE(lia::detail::deterministicPow(2.0f, 10.0f) == 1024.0f);
+        REQUIRE(lia::detail::deterministicPow(-2.0f, 3.0f) == -8.0f);
+        REQUIRE(std::isnan(lia::detail::deterministicPow(-2.0f, 0.5f)));
+        REQUIRE(lia::detail::deterministicPow(0.0f, -1.0f) == INFINITY);
+        REQUIRE(lia::detail::deterministicPow(0.5f, 200.0f) == 0.0f);
+    }
+
+    SUBCASE("Selected by LIA_DETERMINISTIC")
+    {
+#ifdef LIA_DETERMINISTIC
+        REQUIRE(lia::fsin(2.5f) == lia::detail::deterministicSin(2.5f));
+        REQUIRE(lia::fcos(2.5f) == lia::detail::deterministicCos(2.5f));
+        REQUIRE(lia::ftan(2.5f) == lia::detail::deterministicTan(2.5f));
+        REQUIRE(lia::fatan2(2.5f, -1.0f) == lia::detail::deterministicAtan2(2.5f, -1.0f));
+        REQUIRE(lia::fpow(2.5f, 2.2f) == lia::detail::deterministicPow(2.5f, 2.2f));
+#else
+        REQUIRE(lia::fsin(2.5f) == std::sin(2.5f));
+        REQUIRE(lia::fcos(2.5f) == std::cos(2.5f));
+        REQUIRE(lia::ftan(2.5f) == std::tan(2.5f));
+        REQUIRE(lia::fatan2(2.5f, -1.0f) == std::atan2(2.5f, -1.0f));
+        REQUIRE(lia::fpow(2.5f, 2.2f) == std::pow(2.5f, 2.2f));
+#endif
+    }
+
+    SUBCASE("Pairwise sums")
+    {
+        std::vector<float> values(1000000, 0.1f);
+        const float sum = lia::pairwiseSum(values.data(), values.size());
+        REQUIRE(std::abs(sum - 100000.0f) < 1.0f);
+
+        float naive = 0.0f;
+        for (float v : values)
+            naive += v;
+        REQUIRE(std::abs(naive - 100000.0f) > 100.0f);
+
+        // the top split is at a block boundary, so two jobs can sum the halves
+        const std::size_t half = 500032;
+        REQUIRE(sum == lia::pairwiseSum(values.data(), half) + lia::pairwiseSum(values.data() + half, values.size() - half));
+
+        std::vector<lia::vec3> vectors(1000, lia::vec3(1.0f, 2.0f, 3.0f));
+        const lia::vec3 total = lia::pairwiseSum(vectors.data(), vectors.size());
+        REQUIRE(total.z == 3000.0f);
+    }
+}
+
+} // namespace test
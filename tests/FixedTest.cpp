@@ -0,0 +1,153 @@
+#include "doctest.h"
+
+#include <lia/fixed.h>
+
+#include <cmath>
+#include <vector>
+
+namespace test {
+
+TEST_CASE("Fixed-point arithmetic")
+{
+    SUBCASE("Scalars")
+    {
+        const lia::fixed32 half = lia::fixed32::fromDouble(0.5);
+        REQUIRE_EQ(half.raw, 0x8000);
+        REQUIRE(lia::fixed32(3) * half == lia::fixed32::fromDouble(1.5));
+        REQUIRE(lia::fixed32(-3) / lia::fixed32(4) == lia::fixed32::fromDouble(-0.75));
+        REQUIRE(lia::fixed32(7) - lia::fixed32(9) == lia::fixed32(-2));
+        REQUIRE_EQ((lia::fixed32(1) / lia::fixed32(0)).raw, INT32_MAX);
+
+        // products round half away from zero, so negating commutes with them
+        REQUIRE_EQ((lia::fixed32::fromRaw(1) * half).raw, 1);
+        REQUIRE_EQ((lia::fixed32::fromRaw(-1) * half).raw, -1);
+        REQUIRE_EQ((lia::fixed64::fromRaw(-1) * lia::fixed64::fromDouble(0.5)).raw, -1);
+
+        const lia::fixed64 third = lia::fixed64(1) / lia::fixed64(3);
+        REQUIRE_EQ(third.raw, 1431655765);
+        REQUIRE(lia::fixed64(-6) * third == lia::fixed64::fromRaw(-8589934590));
+        REQUIRE(lia::fixed64(40000) * lia::fixed64(50000) == lia::fixed64::fromRaw(int64_t(2000000000) << 32));
+        REQUIRE(lia::fixed64::fromDouble(-2.25).toDouble() == -2.25);
+    }
+
+    SUBCASE("Out of range results wrap")
+    {
+        const lia::fixed32 max32 = lia::fixed32::fromRaw(INT32_MAX);
+        const lia::fixed32 min32 = lia::fixed32::fromRaw(INT32_MIN);
+        const lia::fixed32 tiny32 = lia::fixed32::fromRaw(1);
+        REQUIRE(max32 + tiny32 == min32);
+        REQUIRE(min32 - tiny32 == max32);
+        REQUIRE(-min32 == min32);
+
+        lia::fixed32 sum = max32;
+        sum += tiny32;
+        REQUIRE(sum == min32);
+        sum -= tiny32;
+        REQUIRE(sum == max32);
+
+        const lia::fixed64 max64 = lia::fixed64::fromRaw(INT64_MAX);
+        const lia::fixed64 min64 = lia::fixed64::fromRaw(INT64_MIN);
+        const lia::fixed64 tiny64 = lia::fixed64::fromRaw(1);
+        REQUIRE(min64 - tiny64 == max64);
+        REQUIRE(max64 + tiny64 == min64);
+        REQUIRE(-min64 == min64);
+        REQUIRE(abs(min64) == min64);
+
+        lia::fixed64 difference = min64;
+        difference -= tiny64;
+        REQUIRE(difference == max64);
+    }
+
+    SUBCASE("Square root")
+    {
+        REQUIRE(sqrt(lia::fixed32(9)) == lia::fixed32(3));
+        REQUIRE(sqrt(lia::fixed64(1 << 20)) == lia::fixed64(1 << 10));
+        REQUIRE_EQ(sqrt(lia::fixed32(2)).raw, 92681);
+        REQUIRE(std::abs(sqrt(lia::fixed64(2)).toDouble() - std::sqrt(2.0)) < 1e-9);
+        REQUIRE(sqrt(lia::fixed32(-1)) == lia::fixed32(0));
+    }
+
+    SUBCASE("Sine and cosine")
+    {
+        REQUIRE(sin(lia::fixed32(0)) == lia::fixed32(0));
+        REQUIRE(cos(lia::fixed64(0)) == lia::fixed64(1));
+
+        for (double angle = -100.0; angle < 100.0; angle += 0.0137) {
+            const lia::fixed32 a32 = lia::fixed32::fromDouble(angle);
+            const lia::fixed64 a64 = lia::fixed64::fromDouble(angle);
+            REQUIRE(std::abs(sin(a32).toDouble() - std::sin(a32.toDouble())) < 1e-4);
+            REQUIRE(std::abs(cos(a32).toDouble() - std::cos(a32.toDouble())) < 1e-4);
+            REQUIRE(std::abs(sin(a64).toDouble() - std::sin(a64.toDouble())) < 1e-8);
+            REQUIRE(std::abs(cos(a64).toDouble() - std::cos(a64.toDouble())) < 1e-8);
+        }
+
+        // bit patterns are part of the contract
+        REQUIRE_EQ(sin(lia::fixed32(1)).raw, 55146);
+        REQUIRE_EQ(cos(lia::fixed64(1)).raw, 2320580733);
+    }
+
+    SUBCASE("Vectors")
+    {
+        const lia::vec3q16 v(lia::fixed32(3), lia::fixed32(4), lia::fixed32(0));
+        REQUIRE(magnitude(v) == lia::fixed32(5));
+        REQUIRE(dot(v, v) == lia::fixed32(25));
+
+        // longer than sqrt(range), where dot(v, v) overflows
+        const lia::vec3q16 far(lia::fixed32(20000), lia::fixed32(-15000), lia::fixed32(0));
+        REQUIRE(std::abs(magnitude(far).toDouble() - 25000.0) < 1e-4);
+
+        const lia::vec3q32 n = normalize(lia::vec3q32::fromFloat(lia::vec3(1.0f, -2.0f, 0.5f)));
+        REQUIRE(std::abs(magnitude(n).toDouble() - 1.0) < 1e-9);
+        REQUIRE(cross(lia::vec3q32(1, 0, 0), lia::vec3q32(0, 1, 0)) == lia::vec3q32(0, 0, 1));
+    }
+
+    SUBCASE("Quaternions and matrices")
+    {
+        const lia::fixed32 quarter = lia::fixed32::fromDouble(lia::PI / 2.0);
+        const lia::quaternionq16 q = lia::axisAngle(lia::vec3q16(0, 0, 1), quarter);
+        const lia::vec3 r = lia::rotate(lia::vec3q16(1, 0, 0), q).toFloat();
+        REQUIRE(std::abs(r.x) < 1e-4f);
+        REQUIRE(std::abs(r.y - 1.0f) < 1e-4f);
+
+        const lia::quaternionq32 q32 = normalize(lia::quaternionq32::fromFloat(lia::quaternion(0.3f, -0.2f, 0.6f, 0.7f)));
+        const lia::mat4 expected = q32.toFloat().getRotationMatrix();
+        const lia::mat4 actual = lia::rotationMatrix(q32).toFloat();
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j)
+                REQUIRE(std::abs(actual(i, j) - expected(i, j)) < 1e-6f);
+        }
+
+        const lia::mat4q32 m = lia::rotationMatrix(q32) * lia::translation(lia::vec3q32(1, 2, 3));
+        const lia::vec3q32 p(lia::fixed64(5), lia::fixed64(-1), lia::fixed64(2));
+        const lia::vec4q32 viaVec4 = lia::vec4q32(p, lia::fixed64(1)) * m;
+        lia::vec3q32 viaBatch;
+        lia::transformPoints(m, &p, &viaBatch, 1);
+        REQUIRE(viaBatch == lia::vec3q32(viaVec4.x, viaVec4.y, viaVec4.z));
+    }
+
+    SUBCASE("Batches match scalar results")
+    {
+        std::vector<lia::fixed32> angles(1000), sines(1000), cosines(1000);
+        std::vector<lia::vec3q16> points(1000), rotated(1000);
+        for (int i = 0; i < 1000; ++i) {
+            angles[i] = lia::fixed32::fromRaw(i * 7919 - 4000000);
+            points[i] = lia::vec3q16(lia::fixed32(i % 17), lia::fixed32(i % 5 - 2), lia::fixed32::fromRaw(i * 31));
+        }
+
+        lia::sinCos(angles.data(), sines.data(), cosines.data(), angles.size());
+        const lia::quaternionq16 q = lia::axisAngle(lia::vec3q16(0, 1, 0), lia::fixed32(1));
+        lia::rotate(points.data(), rotated.data(), points.size(), q);
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(sines[i] == sin(angles[i]));
+            REQUIRE(cosines[i] == cos(angles[i]));
+            REQUIRE(rotated[i] == lia::rotate(points[i], q));
+        }
+
+        std::vector<lia::vec3q16> normals(1000);
+        lia::normalize(points.data(), normals.data(), points.size());
+        lia::integrate(points.data(), normals.data(), lia::fixed32::fromDouble(0.5), points.size());
+        REQUIRE(points[1] == lia::vec3q16(lia::fixed32(1), lia::fixed32(-1), lia::fixed32::fromRaw(31)) + normals[1] * lia::fixed32::fromDouble(0.5));
+    }
+}
+
+} // namespace test
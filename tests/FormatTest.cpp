@@ -0,0 +1,100 @@
+#include "doctest.h"
+
+#include <lia/format.h>
+#include <lia/parse.h>
+#include <lia/random.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace test {
+
+TEST_CASE("Format")
+{
+    SUBCASE("Vectors and matrices")
+    {
+        char buffer[256];
+        char* cursor = buffer;
+        CHECK(lia::format(cursor, buffer + sizeof(buffer), lia::vec3(1.5f, -2.0f, 300.0f)));
+        CHECK(std::string(buffer, cursor) == "1.5 -2 300");
+
+        cursor = buffer;
+        CHECK(lia::format(cursor, buffer + sizeof(buffer), lia::vec2(3.14159265f, 1e-7f), 3, ','));
+        CHECK(std::string(buffer, cursor) == "3.14,1e-07");
+
+    #if defined(__cpp_lib_to_chars)
+        cursor = buffer;
+        CHECK(lia::format(cursor, buffer + sizeof(buffer), lia::vec4(0.1f, 0.2f, 0.3f, 1.0f)));
+        CHECK(std::string(buffer, cursor) == "0.1 0.2 0.3 1");
+    #endif
+
+        cursor = buffer;
+        CHECK_FALSE(lia::format(cursor, buffer + 8, lia::vec3(1.5f, -2.0f, 300.0f)));
+        CHECK(cursor == buffer);
+
+        lia::mat4 m;
+        for (int i = 0; i < 16; ++i)
+            m(i / 4, i % 4) = static_cast<float>(i) - 7.25f;
+        cursor = buffer;
+        CHECK(lia::format(cursor, buffer + sizeof(buffer), m));
+
+        const char* read = buffer;
+        lia::mat4 parsed;
+        CHECK(lia::parse(read, cursor, parsed));
+        CHECK(std::memcmp(&parsed, &m, sizeof(m)) == 0);
+    }
+
+    SUBCASE("Arrays round trip")
+    {
+        lia::pcg32 rng(21u);
+        std::vector<lia::vec3> points(1000);
+        lia::randomVec3(rng, points.data(), points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+            points[i] *= static_cast<float>(i % 7) * 1000.0f + 1e-3f;
+
+        std::vector<char> text(points.size() * (3 * lia::formattedFloatSize() + 3));
+        char* cursor = text.data();
+        CHECK(lia::format(cursor, text.data() + text.size(), points.data(), points.size(), lia::FORMAT_SHORTEST, ',') == points.size());
+        CHECK(cursor[-1] == '\n');
+
+        std::vector<lia::vec3> parsed(points.size());
+        const char* read = text.data();
+        CHECK(lia::parse(read, cursor, parsed.data(), parsed.size()) == parsed.size());
+        CHECK(std::memcmp(parsed.data(), points.data(), points.size() * sizeof(lia::vec3)) == 0);
+
+        // stops at the last complete line
+        char small[40];
+        cursor = small;
+        const std::size_t written = lia::format(cursor, small + sizeof(small), points.data(), points.size());
+        CHECK(written < 3);
+        CHECK((written == 0 || cursor[-1] == '\n'));
+    }
+
+    SUBCASE("Infinity and NaN round trip")
+    {
+        const float inf = std::numeric_limits<float>::infinity();
+        const lia::vec3 values(inf, -inf, std::numeric_limits<float>::quiet_NaN());
+
+        char buffer[64];
+        char* cursor = buffer;
+        CHECK(lia::format(cursor, buffer + sizeof(buffer), values, lia::FORMAT_SHORTEST, ','));
+        CHECK(std::string(buffer, cursor) == "inf,-inf,nan");
+
+        for (int precision : { lia::FORMAT_SHORTEST, 3 }) {
+            cursor = buffer;
+            CHECK(lia::format(cursor, buffer + sizeof(buffer), &values, 1, precision) == 1);
+
+            const char* read = buffer;
+            lia::vec3 parsed;
+            CHECK(lia::parse(read, cursor, parsed));
+            CHECK(parsed.x == inf);
+            CHECK(parsed.y == -inf);
+            CHECK(std::isnan(parsed.z));
+        }
+    }
+}
+
+} // namespace test
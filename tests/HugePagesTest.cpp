@@ -0,0 +1,78 @@
+#include "doctest.h"
+
+#include <lia/hugepages.h>
+#include <lia/vec3.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace test {
+
+TEST_CASE("Huge pages")
+{
+    SUBCASE("Allocation")
+    {
+        for (lia::pageMode mode : { lia::pageMode::normal, lia::pageMode::transparentHuge, lia::pageMode::explicitHuge }) {
+            lia::pageMode obtained = lia::pageMode::explicitHuge;
+            void* data = lia::allocatePages(5u << 20, mode, &obtained);
+            REQUIRE(data != nullptr);
+            REQUIRE(reinterpret_cast<uintptr_t>(data) % lia::HUGE_PAGE_SIZE == 0);
+            REQUIRE(static_cast<int>(obtained) <= static_cast<int>(mode));
+
+            uint8_t* bytes = static_cast<uint8_t*>(data);
+            bytes[0] = 1;
+            bytes[(5u << 20) - 1] = 2;
+            REQUIRE(bytes[0] + bytes[(5u << 20) - 1] == 3);
+            lia::freePages(data, 5u << 20);
+        }
+    }
+
+    SUBCASE("Partitions")
+    {
+        const std::size_t count = 1000000;
+        const std::size_t parts = 5;
+
+        std::size_t next = 0;
+        for (std::size_t part = 0; part < parts; ++part) {
+            const lia::indexRange range = lia::partitionRange(count, parts, part, sizeof(lia::vec3));
+            REQUIRE(range.first == next);
+            if (part > 0) {
+                // the part starts in the first element at or after a page boundary
+                const std::size_t byte = range.first * sizeof(lia::vec3);
+                REQUIRE(byte % lia::HUGE_PAGE_SIZE < sizeof(lia::vec3));
+            }
+            next = range.last;
+        }
+        REQUIRE(next == count);
+
+        // fewer pages than parts leaves some parts empty, never overlapping
+        const lia::indexRange tiny = lia::partitionRange(100, 4, 2, sizeof(lia::vec3));
+        REQUIRE(tiny.size() == 0);
+
+        lia::largeArray<lia::vec3> points(count);
+        REQUIRE(points.size() == count);
+        std::vector<std::thread> workers;
+        for (std::size_t part = 0; part < parts; ++part) {
+            workers.emplace_back([&points, parts, part]() {
+                const lia::indexRange range = points.partition(parts, part);
+                lia::firstTouch(points.data(), range);
+                for (std::size_t i = range.first; i < range.last; ++i)
+                    points[i].x = static_cast<float>(i);
+            });
+        }
+        for (std::thread& worker : workers)
+            worker.join();
+
+        bool filled = true;
+        for (std::size_t i = 0; i < count; ++i)
+            filled = filled && points[i].x == static_cast<float>(i) && points[i].y == 0.0f;
+        REQUIRE(filled);
+
+        lia::largeArray<lia::vec3> moved(std::move(points));
+        REQUIRE(moved.size() == count);
+        REQUIRE(points.size() == 0);
+    }
+}
+
+} // namespace test
@@ -0,0 +1,131 @@
+#include "doctest.h"
+
+#include <lia/hull3d.h>
+#include <lia/predicates.h>
+#include <lia/random.h>
+
+#include <vector>
+
+namespace test {
+
+static void RequireValidHull(const lia::convexHull& hull, const std::vector<lia::vec3>& points)
+{
+    for (std::size_t e = 0; e < hull.halfedges.size(); ++e) {
+        const uint32_t twin = hull.halfedges[e];
+        REQUIRE_EQ(hull.halfedges[twin], e);
+        REQUIRE_EQ(hull.triangles[twin], hull.triangles[3 * (e / 3) + (e + 1) % 3]);
+    }
+
+    // every edge is convex and every input point lies on or below every face, exactly
+    std::size_t outside = 0;
+    for (std::size_t f = 0; f < hull.faceCount(); ++f) {
+        const lia::vec3 a = hull.vertices[hull.triangles[3 * f]];
+        const lia::vec3 b = hull.vertices[hull.triangles[3 * f + 1]];
+        const lia::vec3 c = hull.vertices[hull.triangles[3 * f + 2]];
+        for (std::size_t i = 0; i < 3; ++i) {
+            const uint32_t twin = hull.halfedges[3 * f + i];
+            const lia::vec3 opposite = hull.vertices[hull.triangles[3 * (twin / 3) + (twin + 2) % 3]];
+            REQUIRE(lia::orient3d(a, b, c, opposite) >= 0.0);
+        }
+        for (const lia::vec3& p : points)
+            outside += lia::orient3d(a, b, c, p) < 0.0 ? 1 : 0;
+    }
+    REQUIRE_EQ(outside, 0u);
+}
+
+TEST_CASE("Convex hulls")
+{
+    lia::pcg32 rng(3u);
+    lia::quickhull qh;
+    lia::convexHull hull;
+
+    SUBCASE("Cube with interior points")
+    {
+        std::vector<lia::vec3> points(500);
+        lia::randomVec3(rng, points.data(), points.size());
+        for (lia::vec3& p : points)
+            p = p * 1.8f - lia::vec3(0.9f, 0.9f, 0.9f);
+        for (int corner = 0; corner < 8; ++corner)
+            points.push_back(lia::vec3(corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f, corner & 4 ? 1.0f : -1.0f));
+
+        REQUIRE(qh.compute(points.data(), points.size(), hull));
+        REQUIRE_EQ(hull.vertices.size(), 8u);
+        REQUIRE_EQ(hull.faceCount(), 12u);
+        for (uint32_t index : hull.pointIndices)
+            REQUIRE(index >= 500u);
+        RequireValidHull(hull, points);
+    }
+
+    SUBCASE("Points on a sphere")
+    {
+        std::vector<lia::vec3> points(2000);
+        lia::randomUnitVec3(rng, points.data(), points.size());
+
+        REQUIRE(qh.compute(points.data(), points.size(), hull));
+        REQUIRE(hull.vertices.size() > 1900u);
+        REQUIRE_EQ(hull.faceCount(), 2 * hull.vertices.size() - 4);
+        RequireValidHull(hull, points);
+
+        // a reused object gives the same hull
+        lia::convexHull again;
+        REQUIRE(qh.compute(points.data(), points.size(), again));
+        REQUIRE(again.triangles == hull.triangles);
+    }
+
+    SUBCASE("Vertex budget")
+    {
+        std::vector<lia::vec3> points(1000);
+        lia::randomUnitVec3(rng, points.data(), points.size());
+
+        REQUIRE(qh.compute(points.data(), points.size(), hull, 24));
+        REQUIRE_EQ(hull.vertices.size(), 24u);
+        REQUIRE_EQ(hull.faceCount(), 2 * hull.vertices.size() - 4);
+        for (std::size_t e = 0; e < hull.halfedges.size(); ++e)
+            REQUIRE_EQ(hull.halfedges[hull.halfedges[e]], e);
+
+        // budgets below a tetrahedron give the tetrahedron, not the full hull
+        for (std::size_t maxVertices = 1; maxVertices <= 4; ++maxVertices) {
+            REQUIRE(qh.compute(points.data(), points.size(), hull, maxVertices));
+            REQUIRE_EQ(hull.vertices.size(), 4u);
+            REQUIRE_EQ(hull.faceCount(), 4u);
+        }
+    }
+
+    SUBCASE("Slabs, boxes and spheres")
+    {
+        // thin or far from the origin, where rounded planes used to miss points and fold edges
+        const lia::vec3 scales[4] = { lia::vec3(100.0f, 100.0f, 0.05f), lia::vec3(100.0f), lia::vec3(1000.0f, 1000.0f, 0.01f), lia::vec3(100.0f) };
+        const lia::vec3 offsets[4] = { lia::vec3(0.0f), lia::vec3(0.0f), lia::vec3(5000.0f, 0.0f, 0.0f), lia::vec3(0.0f) };
+        for (int round = 0; round < 3; ++round) {
+            for (int shape = 0; shape < 4; ++shape) {
+                std::vector<lia::vec3> points(400);
+                if (shape == 3) {
+                    lia::randomUnitVec3(rng, points.data(), points.size());
+                } else {
+                    lia::randomVec3(rng, points.data(), points.size());
+                    for (lia::vec3& p : points)
+                        p = p - lia::vec3(0.5f);
+                }
+                for (lia::vec3& p : points)
+                    p = lia::vec3(p.x * scales[shape].x, p.y * scales[shape].y, p.z * scales[shape].z) + offsets[shape];
+
+                REQUIRE(qh.compute(points.data(), points.size(), hull));
+                REQUIRE_EQ(hull.faceCount(), 2 * hull.vertices.size() - 4);
+                RequireValidHull(hull, points);
+            }
+        }
+    }
+
+    SUBCASE("Degenerate input")
+    {
+        std::vector<lia::vec3> flat(100);
+        lia::randomVec3(rng, flat.data(), flat.size());
+        for (lia::vec3& p : flat)
+            p.z = 0.5f;
+        REQUIRE_FALSE(qh.compute(flat.data(), flat.size(), hull));
+        REQUIRE(hull.vertices.empty());
+        REQUIRE_FALSE(qh.compute(flat.data(), 3, hull));
+    }
+}
+
+} // namespace test
@@ -0,0 +1,139 @@
+#include "doctest.h"
+
+#include <lia/interval.h>
+#include <lia/random.h>
+
+#include <cmath>
+#include <vector>
+
+namespace test {
+
+static bool Encloses(const lia::interval& i, double value)
+{
+    return static_cast<double>(i.lower) <= value && value <= static_cast<double>(i.upper);
+}
+
+TEST_CASE("Interval arithmetic")
+{
+    lia::pcg32 rng(11u);
+
+    SUBCASE("Outward rounding")
+    {
+        REQUIRE(lia::detail::nextDown(1.0f) < 1.0f);
+        REQUIRE(lia::detail::nextUp(1.0f) > 1.0f);
+        REQUIRE(lia::detail::nextDown(0.0f) < 0.0f);
+        REQUIRE(lia::detail::nextUp(-1.0f) == std::nextafter(-1.0f, 0.0f));
+
+        std::vector<float> values(4000);
+        lia::randomFloats(rng, values.data(), values.size());
+        for (std::size_t i = 0; i + 3 < values.size(); i += 4) {
+            const float a = values[i] * 200.0f - 100.0f;
+            const float b = values[i + 1] * 200.0f - 100.0f;
+            const lia::interval x(a, a + values[i + 2]);
+            const lia::interval y(b, b + values[i + 3]);
+
+            // the exact double results at the corners must be enclosed
+            const double xs[2] = { x.lower, x.upper };
+            const double ys[2] = { y.lower, y.upper };
+            for (double u : xs) {
+                for (double v : ys) {
+                    REQUIRE(Encloses(x + y, u + v));
+                    REQUIRE(Encloses(x - y, u - v));
+                    REQUIRE(Encloses(x * y, u * v));
+                    REQUIRE(Encloses(lia::square(x), u * u));
+                    if (!y.contains(0.0f))
+                        REQUIRE(Encloses(x / y, u / v));
+                }
+            }
+        }
+
+        REQUIRE(lia::square(lia::interval(-2.0f, 1.0f)).lower == 0.0f);
+        REQUIRE((lia::interval(1.0f) / lia::interval(-1.0f, 1.0f)).upper == INFINITY);
+        const lia::interval root = sqrt(lia::interval(2.0f));
+        REQUIRE(Encloses(root, std::sqrt(2.0)));
+
+        // an exact zero times an unbounded interval is still zero
+        const lia::interval unbounded = lia::interval(1.0f) / lia::interval(-1.0f, 1.0f);
+        REQUIRE(Encloses(unbounded * lia::interval(0.0f), 0.0));
+        REQUIRE(Encloses(lia::interval::entire() * 0.0f, 0.0));
+        REQUIRE(Encloses(lia::interval(0.0f) * lia::interval::entire(), 0.0));
+        const lia::interval product = lia::interval::entire() * lia::interval(-1.0f, 2.0f);
+        REQUIRE(product.lower == -INFINITY);
+        REQUIRE(product.upper == INFINITY);
+    }
+
+    SUBCASE("Vectors")
+    {
+        const lia::ivec3 a(lia::vec3(0.1f, 0.2f, 0.3f));
+        const lia::ivec3 b(lia::vec3(-1.0f, 0.5f, 2.0f));
+        REQUIRE(Encloses(lia::dot(a, b), 0.1 * -1.0 + 0.2 * 0.5 + 0.3 * 2.0));
+        REQUIRE(Encloses(lia::magnitude(b), std::sqrt(5.25)));
+
+        const lia::ivec3 c = lia::cross(a, b);
+        REQUIRE(c.contains(lia::cross(lia::vec3(0.1f, 0.2f, 0.3f), lia::vec3(-1.0f, 0.5f, 2.0f))));
+    }
+
+    SUBCASE("Boxes transformed by matrices")
+    {
+        for (int trial = 0; trial < 200; ++trial) {
+            float r[12];
+            lia::randomFloats(rng, r, 12);
+            const lia::mat4 m = lia::translate(lia::rotate(lia::mat4(), r[0] * 6.0f, lia::vec3(r[1] - 0.5f, r[2], 0.3f)),
+                                               lia::vec3(r[3] * 100.0f, -r[4] * 1000.0f, r[5]));
+            const lia::vec3 lower(r[6] * 10.0f - 5.0f, r[7] * 10.0f - 5.0f, r[8] * 10.0f - 5.0f);
+            const lia::ivec3 box(lower, lower + lia::vec3(r[9], r[10] * 3.0f, r[11]));
+            const lia::ivec3 moved = box * m;
+
+            for (int corner = 0; corner < 8; ++corner) {
+                const double p[3] = { corner & 1 ? box.x.upper : box.x.lower, corner & 2 ? box.y.upper : box.y.lower, corner & 4 ? box.z.upper : box.z.lower };
+                for (int j = 0; j < 3; ++j) {
+                    const double exact = p[0] * m(0, j) + p[1] * m(1, j) + p[2] * m(2, j) + m(3, j);
+                    REQUIRE(Encloses(moved[j], exact));
+                }
+            }
+
+            // conservative, but only by rounding
+            REQUIRE((lia::ivec3(box.lower()) * m).x.width() < 1e-3f);
+        }
+
+        // unbounded axes only spread where the matrix mixes them in
+        const lia::ivec3 open(lia::interval::entire(), lia::interval(1.0f, 2.0f), lia::interval(3.0f));
+        const lia::ivec3 same = open * lia::mat4();
+        REQUIRE(same.x.lower == -INFINITY);
+        REQUIRE(same.x.upper == INFINITY);
+        REQUIRE(Encloses(same.y, 1.0));
+        REQUIRE(Encloses(same.y, 2.0));
+        REQUIRE(same.y.width() < 1.001f);
+        REQUIRE(Encloses(same.z, 3.0));
+        const lia::ivec3 mixed = open * lia::rotate(lia::mat4(), 0.5f, lia::vec3(0.0f, 0.0f, 1.0f));
+        REQUIRE(mixed.y.lower == -INFINITY);
+        REQUIRE(Encloses(mixed.z, 3.0));
+
+        // opposite infinities give the entire line, not NaN
+        const lia::mat4 far = lia::translate(lia::mat4(), lia::vec3(INFINITY, 0.0f, 0.0f));
+        const lia::ivec3 lost = open * far;
+        REQUIRE(lost.x.lower == -INFINITY);
+        REQUIRE(lost.x.upper == INFINITY);
+
+        std::vector<lia::ivec3> boxes(64, lia::ivec3(lia::vec3(-1.0f), lia::vec3(1.0f)));
+        std::vector<lia::ivec3> out(boxes.size());
+        lia::transformBoxes(lia::translate(lia::mat4(), lia::vec3(5.0f, 0.0f, 0.0f)), boxes.data(), out.data(), boxes.size());
+        const lia::ivec3 total = lia::bounds(out.data(), out.size());
+        REQUIRE(total.contains(lia::vec3(4.0f, -1.0f, 1.0f)));
+        REQUIRE(total.x.lower < 4.0f);
+        REQUIRE(total.x.lower > 3.999f);
+    }
+
+    SUBCASE("Bounds of points")
+    {
+        std::vector<lia::vec3> points(100);
+        lia::randomVec3(rng, points.data(), points.size());
+        const lia::ivec3 box = lia::bounds(points.data(), points.size());
+        for (const lia::vec3& p : points)
+            REQUIRE(box.contains(p));
+        REQUIRE(lia::overlaps(box, lia::ivec3(lia::vec3(0.5f))));
+        REQUIRE_FALSE(lia::overlaps(box, lia::ivec3(lia::vec3(2.0f))));
+    }
+}
+
+} // namespace test
@@ -0,0 +1,110 @@
+#include "doctest.h"
+
+#include <lia/noise.h>
+
+namespace test {
+
+TEST_CASE("Noise")
+{
+    const float h = 1e-3f;
+
+    SUBCASE("Lattice")
+    {
+        REQUIRE_EQ(lia::perlin(lia::vec3(3.0f, -2.0f, 7.0f)), 0.0f);
+        REQUIRE_EQ(lia::perlin(lia::vec2(-4.0f, 1.0f)), 0.0f);
+        REQUIRE_EQ(lia::perlin(lia::vec4(1.0f, 2.0f, 3.0f, 4.0f)), 0.0f);
+
+        for (int i = 0; i < 100; ++i) {
+            const lia::vec3 p(i * 0.37f, i * -0.11f, i * 0.23f);
+            const float value = lia::valueNoise(p, 3u);
+            REQUIRE(value >= -1.0f);
+            REQUIRE(value <= 1.0f);
+            REQUIRE(std::abs(lia::simplex(p)) <= 1.1f);
+            REQUIRE(std::abs(lia::perlin(lia::vec4(p.x, p.y, p.z, i * 0.5f))) <= 1.5f);
+
+            const lia::vec4 q(p.x, p.y, p.z, i * -0.7f);
+            REQUIRE(std::abs(lia::valueNoise(q, 3u)) <= 1.0f);
+            REQUIRE(std::abs(lia::simplex(q)) <= 1.1f);
+        }
+
+        REQUIRE_NE(lia::perlin(lia::vec3(0.5f, 0.25f, 0.75f), 1u), lia::perlin(lia::vec3(0.5f, 0.25f, 0.75f), 2u));
+    }
+
+    SUBCASE("Derivatives")
+    {
+        const lia::vec3 p(1.37f, -0.42f, 2.81f);
+
+        const lia::vec4 perlin = lia::perlinWithDerivative(p);
+        const lia::vec4 value = lia::valueNoiseWithDerivative(p);
+        const lia::vec4 simplex = lia::simplexWithDerivative(p);
+        const lia::vec4 fbm = lia::fbmWithDerivative(p, 4);
+
+        for (int axis = 0; axis < 3; ++axis) {
+            lia::vec3 a = p, b = p;
+            a[axis] -= h;
+            b[axis] += h;
+
+            REQUIRE(perlin[axis + 1] == doctest::Approx((lia::perlin(b) - lia::perlin(a)) / (2.0f * h)).epsilon(0.01));
+            REQUIRE(value[axis + 1] == doctest::Approx((lia::valueNoise(b) - lia::valueNoise(a)) / (2.0f * h)).epsilon(0.01));
+            REQUIRE(simplex[axis + 1] == doctest::Approx((lia::simplex(b) - lia::simplex(a)) / (2.0f * h)).epsilon(0.01));
+            REQUIRE(fbm[axis + 1] == doctest::Approx((lia::fbm(b, 4) - lia::fbm(a, 4)) / (2.0f * h)).epsilon(0.02));
+        }
+
+        const lia::vec4 r(0.71f, -1.93f, 2.36f, 0.48f);
+        const lia::noiseSample4 perlin4 = lia::perlinWithDerivative(r);
+        const lia::noiseSample4 value4 = lia::valueNoiseWithDerivative(r);
+        const lia::noiseSample4 simplex4 = lia::simplexWithDerivative(r);
+        REQUIRE_EQ(perlin4.value, lia::perlin(r));
+        REQUIRE_EQ(value4.value, lia::valueNoise(r));
+        REQUIRE_EQ(simplex4.value, lia::simplex(r));
+
+        for (int axis = 0; axis < 4; ++axis) {
+            lia::vec4 a = r, b = r;
+            a[axis] -= h;
+            b[axis] += h;
+
+            REQUIRE(perlin4.derivative[axis] == doctest::Approx((lia::perlin(b) - lia::perlin(a)) / (2.0f * h)).epsilon(0.01));
+            REQUIRE(value4.derivative[axis] == doctest::Approx((lia::valueNoise(b) - lia::valueNoise(a)) / (2.0f * h)).epsilon(0.01));
+            REQUIRE(simplex4.derivative[axis] == doctest::Approx((lia::simplex(b) - lia::simplex(a)) / (2.0f * h)).epsilon(0.01));
+        }
+
+        const lia::vec2 q(0.63f, 4.12f);
+        const lia::vec3 perlin2 = lia::perlinWithDerivative(q);
+        const lia::vec3 simplex2 = lia::simplexWithDerivative(q);
+        REQUIRE(perlin2.y == doctest::Approx((lia::perlin(q + lia::vec2(h, 0.0f)) - lia::perlin(q - lia::vec2(h, 0.0f))) / (2.0f * h)).epsilon(0.01));
+        REQUIRE(simplex2.z == doctest::Approx((lia::simplex(q + lia::vec2(0.0f, h)) - lia::simplex(q - lia::vec2(0.0f, h))) / (2.0f * h)).epsilon(0.01));
+    }
+
+    SUBCASE("Batches")
+    {
+        float x[19], y[19], z[19], out[19];
+        for (int i = 0; i < 19; ++i) {
+            x[i] = i * 0.3f;
+            y[i] = 1.0f - i * 0.2f;
+            z[i] = 0.5f;
+        }
+
+        lia::perlin(x, y, z, out, 19, 5u);
+        for (int i = 0; i < 19; ++i)
+            REQUIRE_EQ(out[i], lia::perlin(lia::vec3(x[i], y[i], z[i]), 5u));
+
+        lia::simplex(x, y, out, 19, 5u);
+        for (int i = 0; i < 19; ++i)
+            REQUIRE_EQ(out[i], lia::simplex(lia::vec2(x[i], y[i]), 5u));
+
+        lia::valueNoise(x, y, out, 19, 5u);
+        for (int i = 0; i < 19; ++i)
+            REQUIRE_EQ(out[i], lia::valueNoise(lia::vec2(x[i], y[i]), 5u));
+
+        float grid[4 * 3 * 2];
+        lia::perlinGrid(lia::vec3(0.1f, 0.2f, 0.3f), 0.5f, 4, 3, 2, grid);
+        REQUIRE_EQ(grid[1 * 12 + 2 * 4 + 3], lia::perlin(lia::vec3(0.1f + 1.5f, 0.2f + 1.0f, 0.3f + 0.5f)));
+
+        float heights[6];
+        lia::fbmGrid(lia::vec2(0.0f), 0.25f, 3, 2, 5, heights);
+        REQUIRE_EQ(heights[5], lia::fbm(lia::vec2(0.5f, 0.25f), 5));
+        REQUIRE(lia::ridged(lia::vec2(0.3f, 0.6f), 3) >= 0.0f);
+    }
+}
+
+} // namespace test
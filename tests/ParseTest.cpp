@@ -0,0 +1,205 @@
+#include "doctest.h"
+
+#include <lia/parse.h>
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace test {
+
+template <typename T>
+static bool same(const T& a, const T& b)
+{
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+template <typename T>
+static bool same(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+TEST_CASE("Parse")
+{
+    SUBCASE("Vectors and matrices")
+    {
+        const std::string text = "1.5, -2 3e2\n  (4; +5 .25)";
+        const char* cursor = text.data();
+        const char* end = text.data() + text.size();
+
+        lia::vec3 a, b;
+        CHECK(lia::parse(cursor, end, a));
+        CHECK(lia::parse(cursor, end, b));
+        CHECK(same(a, lia::vec3(1.5f, -2.0f, 300.0f)));
+        CHECK(same(b, lia::vec3(4.0f, 5.0f, 0.25f)));
+        CHECK_FALSE(lia::parse(cursor, end, a));
+        CHECK(cursor == end - 1);
+
+        const std::string bad = "1 2 x3 ?";
+        cursor = bad.data();
+        lia::vec4 v;
+        CHECK_FALSE(lia::parse(cursor, bad.data() + bad.size(), v));
+        CHECK(cursor == bad.data());
+
+        const std::string rows = "1 2\n3 4\n5 6\n";
+        std::vector<lia::vec2> points(4);
+        cursor = rows.data();
+        CHECK(lia::parse(cursor, rows.data() + rows.size(), points.data(), points.size()) == 3);
+        CHECK(same(points[2], lia::vec2(5.0f, 6.0f)));
+    }
+
+    SUBCASE("Round trip through streams")
+    {
+        lia::mat4 m;
+        for (int i = 0; i < 16; ++i)
+            m(i / 4, i % 4) = static_cast<float>(i) * 0.5f - 3.0f;
+
+        std::stringstream stream;
+        stream << m << lia::vec3(1.0f, -0.125f, 8.0f) << " " << lia::vec2(7.0f, 9.0f);
+
+        const std::string text = stream.str();
+        const char* cursor = text.data();
+        lia::mat4 parsed;
+        CHECK(lia::parse(cursor, text.data() + text.size(), parsed));
+        CHECK(same(parsed, m));
+
+        lia::mat4 read;
+        lia::vec3 v;
+        lia::vec2 w;
+        stream >> read >> v >> w;
+        CHECK(stream);
+        CHECK(same(read, m));
+        CHECK(same(v, lia::vec3(1.0f, -0.125f, 8.0f)));
+        CHECK(same(w, lia::vec2(7.0f, 9.0f)));
+
+        stream >> w;
+        CHECK(stream.fail());
+
+        std::istringstream broken("1 2 # 3");
+        broken >> v;
+        CHECK(broken.fail());
+    }
+
+    SUBCASE("Infinity, NaN and out of range values")
+    {
+        const std::string text = "vec3(inf, -Infinity, +NaN) vec3(information 4, 5, 6)";
+        const char* cursor = text.data();
+        const char* end = text.data() + text.size();
+
+        lia::vec3 a, b;
+        CHECK(lia::parse(cursor, end, a));
+        CHECK(lia::parse(cursor, end, b));
+        CHECK(std::isinf(a.x));
+        CHECK(a.x > 0.0f);
+        CHECK(std::isinf(a.y));
+        CHECK(a.y < 0.0f);
+        CHECK(std::isnan(a.z));
+        CHECK(same(b, lia::vec3(4.0f, 5.0f, 6.0f)));
+
+        std::istringstream stream(text);
+        stream >> a >> b;
+        CHECK(stream);
+        CHECK(std::isinf(a.x));
+        CHECK(a.y < 0.0f);
+        CHECK(std::isnan(a.z));
+        CHECK(same(b, lia::vec3(4.0f, 5.0f, 6.0f)));
+
+        for (const char* range : { "1 2 1e50", "1 2 -1e50", "1 2 1e-50" }) {
+            const std::string outside = range;
+            cursor = outside.data();
+            CHECK_FALSE(lia::parse(cursor, outside.data() + outside.size(), a));
+
+            std::istringstream read(outside);
+            read >> a;
+            CHECK(read.fail());
+        }
+
+        const std::string subnormal = "1e-40 0 0";
+        cursor = subnormal.data();
+        CHECK(lia::parse(cursor, subnormal.data() + subnormal.size(), a));
+        CHECK(a.x > 0.0f);
+    }
+
+    SUBCASE("OBJ vertices in parts")
+    {
+        std::string obj = "# cube\no box\n";
+        for (int i = 0; i < 100; ++i) {
+            obj += "v " + std::to_string(i) + " " + std::to_string(i * 0.5) + " -1\r\n";
+            obj += "vn 0 1 0\n";
+            obj += "vt 0.5 " + std::to_string(i) + "\n";
+        }
+        obj += "f 1/1/1 2/2/2 3/3/3\n";
+
+        lia::objVertices whole;
+        CHECK(lia::loadObj(obj.data(), obj.data() + obj.size(), whole));
+        CHECK(whole.positions.size() == 100);
+        CHECK(whole.normals.size() == 100);
+        CHECK(whole.texcoords.size() == 100);
+        CHECK(same(whole.positions[42], lia::vec3(42.0f, 21.0f, -1.0f)));
+        CHECK(same(whole.texcoords[99], lia::vec2(0.5f, 99.0f)));
+
+        std::vector<std::size_t> offsets;
+        lia::splitLines(obj.data(), obj.size(), 7, offsets);
+        CHECK(offsets.size() == 8);
+
+        lia::objVertices joined;
+        for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+            CHECK((offsets[i] == 0 || obj[offsets[i] - 1] == '\n'));
+            lia::objVertices part;
+            CHECK(lia::loadObj(obj.data() + offsets[i], obj.data() + offsets[i + 1], part));
+            joined.append(part);
+        }
+        CHECK(same(joined.positions, whole.positions));
+        CHECK(same(joined.normals, whole.normals));
+        CHECK(same(joined.texcoords, whole.texcoords));
+
+        const std::string broken = "v 1 2\n";
+        lia::objVertices out;
+        CHECK_FALSE(lia::loadObj(broken.data(), broken.data() + broken.size(), out));
+    }
+
+    SUBCASE("ASCII PLY vertices")
+    {
+        std::string ply = "ply\nformat ascii 1.0\ncomment test\nelement vertex 50\n"
+                          "property float x\nproperty float y\nproperty float z\nproperty uchar red\n"
+                          "property float nx\nproperty float ny\nproperty float nz\n"
+                          "element face 1\nproperty list uchar int vertex_indices\nend_header\n";
+        for (int i = 0; i < 50; ++i)
+            ply += std::to_string(i) + " 1 2 255 0 0 " + std::to_string(i % 2 ? 1 : -1) + "\n";
+        ply += "3 0 1 2\n";
+
+        lia::plyHeader header;
+        REQUIRE(header.parse(ply.data(), ply.size()));
+        CHECK(header.vertexCount == 50);
+        CHECK(header.propertyCount == 7);
+        CHECK(header.normal[2] == 6);
+
+        const char* body = ply.data() + header.bodyOffset;
+        const std::size_t bodySize = ply.size() - header.bodyOffset;
+        std::vector<lia::vec3> positions, normals;
+        CHECK(lia::loadPly(header, body, body + bodySize, 0, positions, &normals));
+        CHECK(positions.size() == 50);
+        CHECK(normals.size() == 50);
+        CHECK(same(positions[7], lia::vec3(7.0f, 1.0f, 2.0f)));
+        CHECK(same(normals[7], lia::vec3(0.0f, 0.0f, 1.0f)));
+
+        std::vector<std::size_t> offsets;
+        lia::splitLines(body, bodySize, 4, offsets);
+        std::vector<lia::vec3> joined;
+        std::size_t firstVertex = 0;
+        for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+            CHECK(lia::loadPly(header, body + offsets[i], body + offsets[i + 1], firstVertex, joined));
+            firstVertex += lia::countLines(body + offsets[i], body + offsets[i + 1]);
+        }
+        CHECK(same(joined, positions));
+
+        const std::string binary = "ply\nformat binary_little_endian 1.0\nelement vertex 1\nproperty float x\n"
+                                   "property float y\nproperty float z\nend_header\n";
+        CHECK_FALSE(header.parse(binary.data(), binary.size()));
+    }
+}
+
+} // namespace test
@@ -0,0 +1,117 @@
+#include "doctest.h"
+
+#include <lia/path2d.h>
+
+#include <vector>
+
+namespace test {
+
+static float TriangleListArea(const std::vector<lia::vec2>& vertices)
+{
+    float area = 0.0f;
+    for (std::size_t i = 0; i + 2 < vertices.size(); i += 3) {
+        const lia::vec2 ab = vertices[i + 1] - vertices[i];
+        const lia::vec2 ac = vertices[i + 2] - vertices[i];
+        area += std::abs(ab.x * ac.y - ab.y * ac.x) * 0.5f;
+    }
+
+    return area;
+}
+
+TEST_CASE("Path 2D")
+{
+    SUBCASE("Flattening")
+    {
+        const lia::vec2 p0(0.0f, 0.0f), p1(50.0f, 100.0f), p2(100.0f, 0.0f);
+
+        const std::size_t coarse = lia::flattenQuadratic(p0, p1, p2, 1.0f, nullptr, 0);
+        const std::size_t fine = lia::flattenQuadratic(p0, p1, p2, 0.01f, nullptr, 0);
+        REQUIRE(coarse > 2);
+        REQUIRE(fine > coarse);
+
+        // every point of the curve stays within tolerance of the polyline
+        std::vector<lia::vec2> points(coarse);
+        REQUIRE_EQ(lia::flattenQuadratic(p0, p1, p2, 1.0f, points.data(), points.size()), coarse);
+        REQUIRE_EQ(points.back().x, 100.0f);
+        for (int i = 0; i <= 200; ++i) {
+            const float t = i / 200.0f;
+            const lia::vec2 p = p0 * ((1 - t) * (1 - t)) + p1 * (2 * t * (1 - t)) + p2 * (t * t);
+
+            float distance = 1e9f;
+            for (std::size_t k = 1; k < points.size(); ++k) {
+                const lia::vec2 ab = points[k] - points[k - 1];
+                const float u = lia::clamp(lia::dot(p - points[k - 1], ab) / lia::dot(ab, ab), 0.0f, 1.0f);
+                distance = std::min(distance, lia::magnitude(p - (points[k - 1] + ab * u)));
+            }
+            REQUIRE(distance <= 1.05f);
+        }
+
+        REQUIRE_EQ(lia::flattenQuadratic(p0, lia::vec2(50.0f, 0.0f), p2, 0.1f, nullptr, 0), 2u);
+
+        const std::size_t cubic = lia::flattenCubic(p0, lia::vec2(0.0f, 100.0f), lia::vec2(100.0f, 100.0f), p2, 0.25f, nullptr, 0);
+        std::vector<lia::vec2> cubicPoints(cubic);
+        lia::flattenCubic(p0, lia::vec2(0.0f, 100.0f), lia::vec2(100.0f, 100.0f), p2, 0.25f, cubicPoints.data(), cubicPoints.size());
+        REQUIRE(cubicPoints.back().x == doctest::Approx(100.0f));
+        REQUIRE(cubicPoints[cubic / 2].y == doctest::Approx(75.0f).epsilon(0.01));
+    }
+
+    SUBCASE("Stroking")
+    {
+        const lia::vec2 line[2] = { lia::vec2(0.0f, 0.0f), lia::vec2(10.0f, 0.0f) };
+
+        lia::strokeStyle style;
+        style.width = 2.0f;
+
+        std::vector<lia::vec2> vertices(lia::strokePolyline(line, 2, style, nullptr, 0));
+        lia::strokePolyline(line, 2, style, vertices.data(), vertices.size());
+        REQUIRE_EQ(vertices.size(), 6u);
+        REQUIRE(TriangleListArea(vertices) == doctest::Approx(20.0f));
+
+        style.cap = lia::lineCap::square;
+        lia::strokePolyline(line, 2, style, vertices.data(), vertices.size());
+        REQUIRE(TriangleListArea(vertices) == doctest::Approx(24.0f));
+
+        style.cap = lia::lineCap::round;
+        style.tolerance = 0.001f;
+        vertices.resize(lia::strokePolyline(line, 2, style, nullptr, 0));
+        lia::strokePolyline(line, 2, style, vertices.data(), vertices.size());
+        REQUIRE(TriangleListArea(vertices) == doctest::Approx(20.0f + 3.14159f).epsilon(0.01));
+
+        // a right angle: miter adds the corner square, bevel half of it
+        const lia::vec2 corner[3] = { lia::vec2(0.0f, 0.0f), lia::vec2(10.0f, 0.0f), lia::vec2(10.0f, 10.0f) };
+        style.cap = lia::lineCap::butt;
+        style.join = lia::lineJoin::miter;
+        vertices.resize(lia::strokePolyline(corner, 3, style, nullptr, 0));
+        lia::strokePolyline(corner, 3, style, vertices.data(), vertices.size());
+        REQUIRE(TriangleListArea(vertices) == doctest::Approx(41.0f));
+
+        style.join = lia::lineJoin::bevel;
+        vertices.resize(lia::strokePolyline(corner, 3, style, nullptr, 0));
+        lia::strokePolyline(corner, 3, style, vertices.data(), vertices.size());
+        REQUIRE(TriangleListArea(vertices) == doctest::Approx(40.5f));
+    }
+
+    SUBCASE("Triangulation")
+    {
+        // an L shape in clockwise order
+        const lia::vec2 polygon[6] = {
+            lia::vec2(0.0f, 0.0f), lia::vec2(0.0f, 2.0f), lia::vec2(1.0f, 2.0f),
+            lia::vec2(1.0f, 1.0f), lia::vec2(2.0f, 1.0f), lia::vec2(2.0f, 0.0f)
+        };
+
+        uint32_t indices[12], scratch[6];
+        REQUIRE_EQ(lia::triangulate(polygon, 6, indices, scratch), 12u);
+
+        float area = 0.0f;
+        for (int i = 0; i < 12; i += 3) {
+            const lia::vec2 ab = polygon[indices[i + 1]] - polygon[indices[i]];
+            const lia::vec2 ac = polygon[indices[i + 2]] - polygon[indices[i]];
+            const float signedArea = (ab.x * ac.y - ab.y * ac.x) * 0.5f;
+            REQUIRE(signedArea > 0.0f);
+            area += signedArea;
+        }
+        REQUIRE(area == doctest::Approx(3.0f));
+    }
+}
+
+} // namespace test
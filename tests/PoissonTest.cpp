@@ -0,0 +1,106 @@
+#include "doctest.h"
+
+#include <lia/poisson.h>
+
+#include <cmath>
+#include <vector>
+
+namespace test {
+
+template <typename T>
+static float MinDistance(const std::vector<T>& points)
+{
+    float closest = 1e30f;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        for (std::size_t j = i + 1; j < points.size(); ++j) {
+            const T delta = points[i] - points[j];
+            closest = std::min(closest, std::sqrt(lia::dot(delta, delta)));
+        }
+    }
+
+    return closest;
+}
+
+TEST_CASE("Poisson-disk sampling")
+{
+    SUBCASE("Bridson in 2D and 3D")
+    {
+        std::vector<lia::vec2> points;
+        lia::poissonDisk(lia::vec2(0.0f, 0.0f), lia::vec2(10.0f, 10.0f), 0.5f, 1u, points);
+
+        // a maximal packing covers at least a quarter of the disk-packing density
+        REQUIRE(points.size() > 250u);
+        REQUIRE(MinDistance(points) >= 0.5f);
+        for (const lia::vec2& p : points)
+            REQUIRE((p.x >= 0.0f && p.x < 10.0f && p.y >= 0.0f && p.y < 10.0f));
+
+        std::vector<lia::vec2> again;
+        lia::poissonDisk(lia::vec2(0.0f, 0.0f), lia::vec2(10.0f, 10.0f), 0.5f, 1u, again);
+        REQUIRE_EQ(again.size(), points.size());
+
+        std::vector<lia::vec3> volume;
+        lia::poissonDisk(lia::vec3(0.0f, 0.0f, 0.0f), lia::vec3(4.0f, 4.0f, 4.0f), 0.5f, 2u, volume);
+        REQUIRE(volume.size() > 150u);
+        REQUIRE(MinDistance(volume) >= 0.5f);
+    }
+
+    SUBCASE("Tiles are seamless")
+    {
+        lia::poissonTiling tiling;
+        tiling.tileSize = 4.0f;
+        tiling.radius = 0.5f;
+        tiling.seed = 9u;
+
+        std::vector<lia::vec2> tiles[3][3];
+        for (int phase = 0; phase < 4; ++phase) {
+            for (int y = 0; y < 3; ++y) {
+                for (int x = 0; x < 3; ++x) {
+                    if (lia::poissonTiling::phase(x, y) != phase)
+                        continue;
+
+                    std::vector<lia::vec2> neighbours;
+                    for (int ny = std::max(0, y - 1); ny <= std::min(2, y + 1); ++ny) {
+                        for (int nx = std::max(0, x - 1); nx <= std::min(2, x + 1); ++nx)
+                            neighbours.insert(neighbours.end(), tiles[ny][nx].begin(), tiles[ny][nx].end());
+                    }
+
+                    tiling.generate(x, y, neighbours.data(), neighbours.size(), tiles[y][x]);
+                }
+            }
+        }
+
+        std::vector<lia::vec2> all;
+        for (int y = 0; y < 3; ++y) {
+            for (int x = 0; x < 3; ++x) {
+                REQUIRE(!tiles[y][x].empty());
+                all.insert(all.end(), tiles[y][x].begin(), tiles[y][x].end());
+            }
+        }
+        REQUIRE(MinDistance(all) >= 0.5f);
+    }
+
+    SUBCASE("Weighted sample elimination")
+    {
+        lia::pcg32 rng(4u);
+        std::vector<lia::vec2> candidates(2000);
+        lia::randomVec2(rng, candidates.data(), candidates.size());
+
+        std::vector<lia::vec2> samples(400);
+        REQUIRE_EQ(lia::eliminateSamples(candidates.data(), candidates.size(), samples.size(), 1.0f, samples.data()), 400u);
+
+        // within reach of the hexagonal packing distance, 2 * maxRadius, unlike a random subset
+        const float maxRadius = std::sqrt(1.0f / (2.0f * std::sqrt(3.0f) * 400.0f));
+        const std::vector<lia::vec2> random(candidates.begin(), candidates.begin() + 400);
+        REQUIRE(MinDistance(samples) > maxRadius);
+        REQUIRE(MinDistance(random) < 0.2f * maxRadius);
+
+        std::vector<lia::vec3> surface(3000);
+        for (lia::vec3& p : surface)
+            p = lia::sampleSphere(lia::vec2(static_cast<float>(rng.next() >> 8) / 16777216.0f, static_cast<float>(rng.next() >> 8) / 16777216.0f));
+        std::vector<lia::vec3> sphere(600);
+        REQUIRE_EQ(lia::eliminateSamples(surface.data(), surface.size(), sphere.size(), 4.0f * static_cast<float>(lia::PI), sphere.data()), 600u);
+        REQUIRE(MinDistance(sphere) > std::sqrt(4.0f * static_cast<float>(lia::PI) / (2.0f * std::sqrt(3.0f) * 600.0f)));
+    }
+}
+
+} // namespace test
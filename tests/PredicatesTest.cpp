@@ -0,0 +1,89 @@
+#include "doctest.h"
+
+#include <lia/predicates.h>
+
+#include <cmath>
+
+namespace test {
+
+TEST_CASE("Geometric predicates")
+{
+    SUBCASE("Orientation")
+    {
+        REQUIRE(lia::orient2d(lia::vec2(0.0f, 0.0f), lia::vec2(1.0f, 0.0f), lia::vec2(0.0f, 1.0f)) > 0.0);
+        REQUIRE(lia::orient2d(lia::vec2(0.0f, 0.0f), lia::vec2(0.0f, 1.0f), lia::vec2(1.0f, 0.0f)) < 0.0);
+
+        // exactly collinear floats on y = x, and the smallest possible step off the line
+        const lia::vec2 a(0.1f, 0.1f), b(0.3f, 0.3f), c(0.7f, 0.7f);
+        REQUIRE_EQ(lia::orient2d(a, b, c), 0.0);
+        REQUIRE(lia::orient2d(a, b, lia::vec2(0.7f, std::nextafter(0.7f, 1.0f))) > 0.0);
+        REQUIRE(lia::orient2d(a, b, lia::vec2(0.7f, std::nextafter(0.7f, 0.0f))) < 0.0);
+
+        // large offsets where the float differences are rounded
+        const lia::vec2 far(1e7f, 1e7f);
+        REQUIRE_EQ(lia::orient2d(far, lia::vec2(1e7f + 1.0f, 1e7f + 1.0f), lia::vec2(-3.0f, -3.0f)), 0.0);
+
+        const lia::vec3 p(0.0f, 0.0f, 0.0f), q(1.0f, 0.0f, 0.0f), r(0.0f, 1.0f, 0.0f);
+        REQUIRE(lia::orient3d(p, q, r, lia::vec3(0.0f, 0.0f, -1.0f)) > 0.0);
+        REQUIRE(lia::orient3d(p, q, r, lia::vec3(0.0f, 0.0f, 1.0f)) < 0.0);
+        REQUIRE_EQ(lia::orient3d(p, q, r, lia::vec3(0.3f, 0.7f, 0.0f)), 0.0);
+        REQUIRE(lia::orient3d(p, q, r, lia::vec3(0.3f, 0.7f, -1e-30f)) > 0.0);
+    }
+
+    SUBCASE("Circles and spheres")
+    {
+        const lia::vec2 a(1.0f, 0.0f), b(0.0f, 1.0f), c(-1.0f, 0.0f);
+        REQUIRE(lia::incircle(a, b, c, lia::vec2(0.0f, 0.0f)) > 0.0);
+        REQUIRE(lia::incircle(a, b, c, lia::vec2(2.0f, 0.0f)) < 0.0);
+        REQUIRE_EQ(lia::incircle(a, b, c, lia::vec2(0.0f, -1.0f)), 0.0);
+        REQUIRE(lia::incircle(a, b, c, lia::vec2(0.0f, std::nextafter(-1.0f, 0.0f))) > 0.0);
+
+        const lia::vec3 p(1.0f, 0.0f, 0.0f), q(0.0f, 1.0f, 0.0f), r(-1.0f, 0.0f, 0.0f), s(0.0f, 0.0f, -1.0f);
+        REQUIRE(lia::orient3d(p, q, r, s) > 0.0);
+        REQUIRE(lia::insphere(p, q, r, s, lia::vec3(0.0f, 0.0f, 0.0f)) > 0.0);
+        REQUIRE(lia::insphere(p, q, r, s, lia::vec3(0.0f, 0.0f, 2.0f)) < 0.0);
+        REQUIRE_EQ(lia::insphere(p, q, r, s, lia::vec3(0.0f, -1.0f, 0.0f)), 0.0);
+        REQUIRE(lia::insphere(p, q, r, s, lia::vec3(0.0f, std::nextafter(-1.0f, 0.0f), 0.0f)) > 0.0);
+    }
+
+    SUBCASE("Batches match the scalar predicates")
+    {
+        const std::size_t count = 64;
+        lia::vec2 a[count], b[count], c[count], d[count];
+        lia::vec3 p[count], q[count], r[count], s[count], t[count];
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const float f = static_cast<float>(i) * 0.37f;
+            a[i] = lia::vec2(f, f);
+            b[i] = lia::vec2(f + 1.0f, f + 1.0f);
+            // every other point sits exactly on the line or circle
+            c[i] = i % 2 ? lia::vec2(std::sin(f), std::cos(f)) : lia::vec2(f + 2.0f, f + 2.0f);
+            d[i] = lia::vec2(std::cos(f) * 0.5f, std::sin(f) * 3.0f);
+
+            p[i] = lia::vec3(1.0f, 0.0f, 0.0f);
+            q[i] = lia::vec3(0.0f, 1.0f, 0.0f);
+            r[i] = lia::vec3(-1.0f, 0.0f, 0.0f);
+            s[i] = lia::vec3(0.0f, 0.0f, -1.0f);
+            t[i] = i % 2 ? lia::vec3(0.0f, 0.0f, 1.0f) : lia::vec3(std::sin(f), 0.5f, std::cos(f) * 2.0f);
+        }
+
+        int8_t orient2[count], orient3[count], circle[count], sphere[count];
+        lia::orient2d(a, b, c, orient2, count);
+        lia::orient3d(p, q, r, t, orient3, count);
+        lia::incircle(a, b, c, d, circle, count);
+        lia::insphere(p, q, r, s, t, sphere, count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto sign = [](double v) { return (v > 0.0) - (v < 0.0); };
+            REQUIRE_EQ(orient2[i], sign(lia::orient2d(a[i], b[i], c[i])));
+            REQUIRE_EQ(orient3[i], sign(lia::orient3d(p[i], q[i], r[i], t[i])));
+            REQUIRE_EQ(circle[i], sign(lia::incircle(a[i], b[i], c[i], d[i])));
+            REQUIRE_EQ(sphere[i], sign(lia::insphere(p[i], q[i], r[i], s[i], t[i])));
+        }
+
+        REQUIRE_EQ(orient2[0], 0);
+        REQUIRE_EQ(sphere[1], 0);
+    }
+}
+
+} // namespace test
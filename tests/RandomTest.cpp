@@ -0,0 +1,128 @@
+#include "doctest.h"
+
+#include <lia/random.h>
+
+#include <algorithm>
+
+namespace test {
+
+TEST_CASE("Random")
+{
+    SUBCASE("PCG32")
+    {
+        lia::pcg32 rng(42u, 54u);
+        REQUIRE_EQ(rng.next(), 0xa15c02b7u);
+        REQUIRE_EQ(rng.next(), 0x7b47f409u);
+        REQUIRE_EQ(rng.next(), 0xba1d3330u);
+
+        lia::pcg32 skipped(42u, 54u);
+        skipped.advance(3);
+        REQUIRE_EQ(skipped.next(), rng.next());
+
+        lia::pcg32x8 wide(7u, 2u);
+        lia::pcg32 lane(7u, 2u * 8u + 5u);
+        uint32_t out[20];
+        wide.fill(out, 20);
+        REQUIRE_EQ(out[5], lane.next());
+        REQUIRE_EQ(out[13], lane.next());
+    }
+
+    SUBCASE("Philox")
+    {
+        uint32_t counter[4] = { 0, 0, 0, 0 };
+        const uint32_t key[2] = { 0, 0 };
+        lia::philox4x32(counter, key);
+        REQUIRE_EQ(counter[0], 0x6627e8d5u);
+        REQUIRE_EQ(counter[3], 0x9b00dbd8u);
+
+        lia::philox stream(99u, 3u);
+        uint32_t first[12];
+        stream.fill(first, 12);
+
+        lia::philox resumed(99u, 3u);
+        resumed.seek(8);
+        uint32_t last[4];
+        resumed.fill(last, 4);
+        REQUIRE_EQ(first[9], last[1]);
+
+        // output i is the same however the stream is taken
+        lia::philox chunked(99u, 3u);
+        uint32_t pieces[12];
+        chunked.fill(pieces, 3);
+        chunked.fill(pieces + 3, 3);
+        pieces[6] = chunked.next();
+        chunked.fill(pieces + 7, 5);
+        for (int i = 0; i < 12; ++i)
+            REQUIRE_EQ(pieces[i], first[i]);
+
+        lia::philox unaligned(99u, 3u);
+        unaligned.seek(5);
+        REQUIRE_EQ(unaligned.next(), first[5]);
+        unaligned.fill(last, 4);
+        REQUIRE_EQ(last[3], first[9]);
+    }
+
+    SUBCASE("Xoshiro")
+    {
+        lia::xoshiro256plus a = lia::xoshiro256plus::forThread(5u, 0);
+        lia::xoshiro256plus b = lia::xoshiro256plus::forThread(5u, 1);
+        REQUIRE_NE(a.next(), b.next());
+
+        // against the reference implementation from state { 1, 2, 3, 4 }
+        lia::xoshiro256plus known;
+        const uint64_t start[4] = { 1u, 2u, 3u, 4u };
+        std::copy(start, start + 4, known.s);
+        REQUIRE_EQ(known.next64(), 5u);
+        std::copy(start, start + 4, known.s);
+        known.jump();
+        REQUIRE_EQ(known.s[0], 0x8c7a153956b5f3d1ull);
+        REQUIRE_EQ(known.s[1], 0x701f1a713401d85eull);
+        REQUIRE_EQ(known.s[2], 0x6527f66a65469085ull);
+        REQUIRE_EQ(known.s[3], 0x8386b786c4408050ull);
+        REQUIRE_EQ(known.next64(), 0x1000ccc01af67421ull);
+
+        lia::xoshiro256plus filled(9u);
+        lia::xoshiro256plus stepped(9u);
+        uint32_t values[5];
+        filled.fill(values, 5);
+        for (uint32_t value : values)
+            REQUIRE_EQ(value, stepped.next());
+    }
+
+    SUBCASE("Batches")
+    {
+        lia::pcg32x8 rng(1u);
+
+        float values[1000];
+        lia::randomFloats(rng, values, 1000);
+        float mean = 0.0f;
+        for (float v : values) {
+            REQUIRE(v >= 0.0f);
+            REQUIRE(v < 1.0f);
+            mean += v;
+        }
+        REQUIRE(mean / 1000.0f == doctest::Approx(0.5f).epsilon(0.05));
+
+        lia::vec3 directions[300];
+        lia::randomUnitVec3(rng, directions, 300);
+        for (const lia::vec3& d : directions)
+            REQUIRE(lia::magnitude(d) == doctest::Approx(1.0f));
+
+        lia::vec2 circle[10];
+        lia::randomUnitVec2(rng, circle, 10);
+        REQUIRE(lia::magnitude(circle[9]) == doctest::Approx(1.0f));
+
+        // empty batches leave the generator where it was, even with no buffer
+        lia::pcg32x8 copy = rng;
+        lia::randomVec2(rng, static_cast<lia::vec2*>(nullptr), 0);
+        lia::randomVec3(rng, static_cast<lia::vec3*>(nullptr), 0);
+        float next[2];
+        lia::randomFloats(rng, next, 2);
+        float expected[2];
+        lia::randomFloats(copy, expected, 2);
+        REQUIRE_EQ(next[0], expected[0]);
+        REQUIRE_EQ(next[1], expected[1]);
+    }
+}
+
+} // namespace test
@@ -0,0 +1,98 @@
+#include "doctest.h"
+
+#include <lia/sampling.h>
+
+namespace test {
+
+TEST_CASE("Sampling")
+{
+    SUBCASE("Sobol")
+    {
+        REQUIRE_EQ(lia::sobol(0, 1), 0.0f);
+        REQUIRE_EQ(lia::sobol(1, 0), 0.5f);
+        REQUIRE_EQ(lia::sobol(2, 0), 0.25f);
+        REQUIRE_EQ(lia::sobol(2, 1), 0.75f);
+        REQUIRE_EQ(lia::sobol(3, 1), 0.25f);
+
+        lia::vec2 points[16];
+        lia::sobol2D(0, 16, 1234u, points);
+
+        // scrambled points still stratify into a 4x4 grid
+        int strata[16] = {};
+        for (const lia::vec2& p : points) {
+            REQUIRE(p.x >= 0.0f);
+            REQUIRE(p.x < 1.0f);
+            ++strata[static_cast<int>(p.x * 4.0f) + 4 * static_cast<int>(p.y * 4.0f)];
+        }
+        for (int count : strata)
+            REQUIRE_EQ(count, 1);
+
+        REQUIRE_EQ(points[5].x, lia::sobolOwen(5, 0, 1234u));
+
+        // seed 0 means unscrambled for both
+        lia::sobol2D(0, 16, 0u, points);
+        for (uint32_t i = 0; i < 16; ++i) {
+            REQUIRE_EQ(points[i].x, lia::sobolOwen(i, 0, 0u));
+            REQUIRE_EQ(points[i].y, lia::sobolOwen(i, 1, 0u));
+            REQUIRE_EQ(points[i].x, lia::sobol(i, 0));
+        }
+    }
+
+    SUBCASE("Halton and R2")
+    {
+        REQUIRE(lia::halton(5, 3) == doctest::Approx(7.0f / 9.0f));
+
+        lia::vec2 halton[4];
+        lia::halton2D(1, 4, halton);
+        REQUIRE(halton[0].x == doctest::Approx(0.5f));
+        REQUIRE(halton[1].y == doctest::Approx(2.0f / 3.0f));
+
+        lia::vec2 r2[8];
+        lia::r2Sequence(3, 8, r2);
+        REQUIRE_EQ(r2[4].x, lia::r2(7).x);
+        REQUIRE(lia::r2(1).x == doctest::Approx(0.5f + 0.7548777f - 1.0f));
+    }
+
+    SUBCASE("Warping")
+    {
+        lia::vec2 u[64];
+        lia::r2Sequence(0, 64, u);
+
+        lia::vec3 hemisphere[64];
+        lia::sampleCosineHemisphere(u, hemisphere, 64);
+        for (const lia::vec3& d : hemisphere) {
+            REQUIRE(lia::magnitude(d) == doctest::Approx(1.0f));
+            REQUIRE(d.z >= 0.0f);
+        }
+
+        for (const lia::vec2& sample : u) {
+            REQUIRE(lia::magnitude(lia::sampleDisk(sample)) <= 1.0001f);
+            REQUIRE(lia::magnitude(lia::sampleSphere(sample)) == doctest::Approx(1.0f));
+
+            const lia::vec2 b = lia::sampleTriangle(sample);
+            REQUIRE(b.x + b.y <= 1.0001f);
+        }
+    }
+
+    SUBCASE("Orthonormal basis")
+    {
+        const lia::vec3 normals[] = {
+            lia::normalize(lia::vec3(0.3f, -0.2f, 0.9f)),
+            lia::normalize(lia::vec3(0.1f, 0.5f, -0.7f)),
+            lia::vec3(0.0f, 0.0f, -1.0f)
+        };
+
+        for (const lia::vec3& n : normals) {
+            lia::vec3 t, b;
+            lia::orthonormalBasis(n, t, b);
+
+            REQUIRE(lia::dot(t, n) == doctest::Approx(0.0f));
+            REQUIRE(lia::dot(b, n) == doctest::Approx(0.0f));
+            REQUIRE(lia::dot(t, b) == doctest::Approx(0.0f));
+            REQUIRE(lia::magnitude(t) == doctest::Approx(1.0f));
+            REQUIRE(lia::magnitude(b) == doctest::Approx(1.0f));
+        }
+    }
+}
+
+} // namespace test
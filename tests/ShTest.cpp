@@ -0,0 +1,96 @@
+#include "doctest.h"
+
+#include <lia/sh.h>
+
+namespace test {
+
+TEST_CASE("Spherical harmonics")
+{
+    const lia::vec3 directions[] = {
+        lia::normalize(lia::vec3(1.0f, 2.0f, 3.0f)),
+        lia::normalize(lia::vec3(-0.5f, 0.3f, -0.8f)),
+        lia::normalize(lia::vec3(0.0f, -1.0f, 0.2f)),
+        lia::vec3(0.0f, 0.0f, 1.0f)
+    };
+
+    lia::sh3 s;
+    for (int i = 0; i < lia::sh3::count; ++i)
+        s[i] = lia::vec3(0.1f * i, 1.0f - 0.05f * i, 0.3f * (i % 3));
+
+    SUBCASE("Constant function")
+    {
+        lia::sh2 constant;
+        constant[0] = lia::vec3(1.0f / 0.282094792f);
+
+        const lia::vec3 value = lia::evaluate(constant, directions[1]);
+        REQUIRE(value.x == doctest::Approx(1.0f));
+        REQUIRE(value.z == doctest::Approx(1.0f));
+    }
+
+    SUBCASE("Batch evaluation")
+    {
+        lia::vec3 out[4];
+        lia::evaluate(s, directions, out, 4);
+
+        for (int i = 0; i < 4; ++i) {
+            const lia::vec3 expected = lia::evaluate(s, directions[i]);
+            REQUIRE(out[i].x == doctest::Approx(expected.x));
+            REQUIRE(out[i].y == doctest::Approx(expected.y));
+            REQUIRE(out[i].z == doctest::Approx(expected.z));
+        }
+    }
+
+    SUBCASE("Projection")
+    {
+        // a uniform cubemap projects onto the DC term only
+        const int size = 8;
+        lia::vec3 texels[size * size];
+        for (lia::vec3& texel : texels)
+            texel = lia::vec3(2.0f, 1.0f, 0.5f);
+
+        const lia::vec3* faces[6] = { texels, texels, texels, texels, texels, texels };
+        const lia::sh2 projected = lia::shProjectCubemap<2>(faces, size);
+
+        REQUIRE(projected[0].x == doctest::Approx(2.0f * 2.0f * 1.7724539f).epsilon(0.001));
+        for (int i = 1; i < lia::sh2::count; ++i)
+            REQUIRE(projected[i].x == doctest::Approx(0.0f).epsilon(0.001));
+    }
+
+    SUBCASE("Rotation")
+    {
+        const lia::quaternion q = lia::rotationX(0.7f) * lia::rotationY(-1.3f) * lia::rotationZ(0.4f);
+        const lia::sh3 rotated = lia::rotate(s, q);
+
+        for (const lia::vec3& d : directions) {
+            const lia::vec3 expected = lia::evaluate(s, d);
+            const lia::vec3 actual = lia::evaluate(rotated, lia::rotate(d, q));
+            REQUIRE(actual.x == doctest::Approx(expected.x).epsilon(0.001));
+            REQUIRE(actual.y == doctest::Approx(expected.y).epsilon(0.001));
+            REQUIRE(actual.z == doctest::Approx(expected.z).epsilon(0.001));
+        }
+
+        const lia::sh3 byQuaternion = lia::rotate(s, lia::rotationX(0.9f));
+        const lia::sh3 byMatrix = lia::rotate(s, lia::shRotation(lia::rotateX(lia::mat4(), 0.9f)));
+        for (int i = 0; i < lia::sh3::count; ++i)
+            REQUIRE(byMatrix[i].y == doctest::Approx(byQuaternion[i].y).epsilon(0.001));
+
+        // lower band counts rotate the same leading coefficients
+        lia::sh1 low;
+        lia::sh2 mid;
+        for (int i = 0; i < lia::sh2::count; ++i) {
+            mid[i] = s[i];
+            if (i < lia::sh1::count)
+                low[i] = s[i];
+        }
+        const lia::shRotation rotation(q);
+        const lia::sh1 lowRotated = lia::rotate(low, rotation);
+        const lia::sh2 midRotated = lia::rotate(mid, rotation);
+        for (int i = 0; i < lia::sh2::count; ++i) {
+            REQUIRE(midRotated[i].x == doctest::Approx(rotated[i].x));
+            if (i < lia::sh1::count)
+                REQUIRE(lowRotated[i].x == doctest::Approx(rotated[i].x));
+        }
+    }
+}
+
+} // namespace test
@@ -0,0 +1,108 @@
+#include "doctest.h"
+
+#include <lia/sharedring.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace test {
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("Shared ring")
+{
+    SUBCASE("Frames")
+    {
+        const std::string name = "/lia-ring-test-" + std::to_string(getpid());
+
+        lia::sharedRing<lia::mat4> writer;
+        REQUIRE(writer.create(name.c_str(), 100, 3));
+
+        lia::sharedRing<lia::mat4> reader;
+        REQUIRE(reader.open(name.c_str()));
+        REQUIRE(reader.size() == 100);
+
+        lia::sharedRing<lia::vec3> wrongType;
+        REQUIRE_FALSE(wrongType.open(name.c_str()));
+
+        lia::sharedFrame<lia::mat4> frame;
+        REQUIRE_FALSE(reader.latest(frame));
+
+        lia::mat4* matrices = writer.beginWrite();
+        for (int i = 0; i < 100; ++i)
+            matrices[i](3, 0) = static_cast<float>(i);
+        writer.endWrite();
+
+        REQUIRE(reader.latest(frame));
+        REQUIRE(frame.number == 0);
+        REQUIRE(frame.count == 100);
+        REQUIRE(frame.data[42](3, 0) == 42.0f);
+        REQUIRE(reader.valid(frame));
+
+        // another frame goes to another slot; coming back round tears the held frame
+        writer.beginWrite()[0](3, 0) = -1.0f;
+        writer.endWrite();
+        REQUIRE(reader.valid(frame));
+        writer.beginWrite();
+        writer.endWrite();
+        REQUIRE(reader.valid(frame));
+        writer.beginWrite();
+        REQUIRE_FALSE(reader.valid(frame));
+        REQUIRE(reader.latest(frame));
+        REQUIRE(frame.number == 2);
+        writer.endWrite();
+
+        std::vector<lia::mat4> copy(100);
+        uint64_t number = 0;
+        REQUIRE(reader.read(copy.data(), &number));
+        REQUIRE(number == 3);
+
+        REQUIRE(lia::sharedRing<lia::mat4>::remove(name.c_str()));
+        REQUIRE_FALSE(reader.open(name.c_str()));
+    }
+
+    SUBCASE("Across threads")
+    {
+        const std::string name = "/lia-ring-threads-" + std::to_string(getpid());
+        const std::size_t count = 4096;
+        const uint64_t frames = 5000;
+
+        lia::sharedRing<lia::vec3> writer;
+        REQUIRE(writer.create(name.c_str(), count));
+        lia::sharedRing<lia::vec3> reader;
+        REQUIRE(reader.open(name.c_str()));
+
+        std::thread thread([&]() {
+            for (uint64_t f = 0; f < frames; ++f) {
+                lia::vec3* points = writer.beginWrite();
+                for (std::size_t i = 0; i < count; ++i)
+                    points[i] = lia::vec3(static_cast<float>(f), static_cast<float>(i), 0.0f);
+                writer.endWrite();
+            }
+        });
+
+        bool torn = false;
+        uint64_t last = 0;
+        std::vector<lia::vec3> copy(count);
+        while (last + 1 < frames) {
+            uint64_t number = 0;
+            if (!reader.read(copy.data(), &number))
+                continue;
+
+            for (std::size_t i = 0; i < count; ++i)
+                torn = torn || copy[i].x != static_cast<float>(number) || copy[i].y != static_cast<float>(i);
+            last = number;
+        }
+        thread.join();
+
+        REQUIRE_FALSE(torn);
+        lia::sharedRing<lia::vec3>::remove(name.c_str());
+    }
+}
+#endif
+
+} // namespace test
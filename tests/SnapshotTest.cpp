@@ -0,0 +1,129 @@
+#include "doctest.h"
+
+#include <lia/random.h>
+#include <lia/snapshot.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace test {
+
+static std::vector<lia::transform> randomTransforms(lia::pcg32& rng, std::size_t count)
+{
+    std::vector<lia::vec3> positions(count), axes(count), scales(count);
+    std::vector<float> angles(count);
+    lia::randomVec3(rng, positions.data(), count);
+    lia::randomUnitVec3(rng, axes.data(), count);
+    lia::randomVec3(rng, scales.data(), count);
+    lia::randomFloats(rng, angles.data(), count);
+
+    std::vector<lia::transform> transforms(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float half = angles[i] * static_cast<float>(lia::PI);
+        transforms[i] = lia::transform(positions[i] * 200.0f - lia::vec3(100.0f), lia::quaternion(axes[i] * std::sin(half), std::cos(half)),
+                                       scales[i] * 2.0f + lia::vec3(0.5f));
+    }
+
+    return transforms;
+}
+
+static bool same(const std::vector<lia::quantizedTransform>& a, const std::vector<lia::quantizedTransform>& b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(lia::quantizedTransform)) == 0;
+}
+
+TEST_CASE("Snapshots")
+{
+    SUBCASE("Quantization")
+    {
+        lia::pcg32 rng(3u);
+        const std::vector<lia::transform> transforms = randomTransforms(rng, 1000);
+
+        lia::snapshotSettings settings;
+        settings.bounds = lia::ivec3(lia::vec3(-100.0f), lia::vec3(100.0f));
+        settings.positionBits = 18;
+        settings.rotationBits = 12;
+        settings.scaleBits = 10;
+
+        std::vector<lia::quantizedTransform> quantized(transforms.size());
+        std::vector<lia::transform> restored(transforms.size());
+        lia::quantize(settings, transforms.data(), quantized.data(), transforms.size());
+        lia::dequantize(settings, quantized.data(), restored.data(), transforms.size());
+
+        for (std::size_t i = 0; i < transforms.size(); ++i) {
+            REQUIRE(lia::magnitude(restored[i].position - transforms[i].position) < 200.0f / (1 << 18));
+            REQUIRE(std::abs(lia::dot(restored[i].rotation, transforms[i].rotation)) > 0.99999f);
+            REQUIRE(lia::magnitude(restored[i].scale - transforms[i].scale) < 4.0f / (1 << 10));
+        }
+
+        // what the receiver decodes quantizes to the same integers
+        std::vector<lia::quantizedTransform> requantized(transforms.size());
+        lia::quantize(settings, restored.data(), requantized.data(), restored.size());
+        REQUIRE(same(requantized, quantized));
+    }
+
+    SUBCASE("Delta encoding")
+    {
+        lia::pcg32 rng(4u);
+        std::vector<lia::transform> transforms = randomTransforms(rng, 5000);
+
+        lia::snapshotSettings settings;
+        settings.bounds = lia::ivec3(lia::vec3(-100.0f), lia::vec3(100.0f));
+
+        std::vector<lia::quantizedTransform> baseline(transforms.size());
+        lia::quantize(settings, transforms.data(), baseline.data(), transforms.size());
+
+        std::vector<uint8_t> full;
+        lia::encodeSnapshot(settings, baseline.data(), nullptr, baseline.size(), full);
+        REQUIRE(full.size() < baseline.size() * 13);
+
+        std::vector<lia::quantizedTransform> received(baseline.size());
+        REQUIRE(lia::decodeSnapshot(settings, full.data(), full.size(), nullptr, received.data(), received.size()));
+        REQUIRE(same(received, baseline));
+
+        // a tenth of the entities move a little
+        for (std::size_t i = 0; i < transforms.size(); i += 10) {
+            transforms[i].position += lia::vec3(0.05f, 0.0f, -0.02f);
+            transforms[i].rotation = lia::normalize(transforms[i].rotation * lia::rotationY(0.01f));
+        }
+        std::vector<lia::quantizedTransform> current(transforms.size());
+        lia::quantize(settings, transforms.data(), current.data(), transforms.size());
+
+        std::vector<uint8_t> delta;
+        lia::encodeSnapshot(settings, current.data(), baseline.data(), current.size(), delta);
+        REQUIRE(delta.size() < full.size() / 8);
+
+        REQUIRE(lia::decodeSnapshot(settings, delta.data(), delta.size(), received.data(), received.data(), received.size()));
+        REQUIRE(same(received, current));
+
+        REQUIRE_FALSE(lia::decodeSnapshot(settings, delta.data(), delta.size() / 2, baseline.data(), received.data(), received.size()));
+        REQUIRE_FALSE(lia::decodeSnapshot(settings, delta.data(), delta.size(), nullptr, received.data(), received.size()));
+        REQUIRE_FALSE(lia::decodeSnapshot(settings, delta.data(), delta.size(), baseline.data(), received.data(), received.size() - 1));
+    }
+
+    SUBCASE("Wrap and escape")
+    {
+        lia::snapshotSettings settings;
+        settings.positionBits = 8;
+        settings.rotationBits = 4;
+        settings.scaleBits = 3;
+
+        std::vector<lia::quantizedTransform> baseline(3), current(3);
+        baseline[0].position[0] = 255u;
+        current[0].position[0] = 0u;
+        current[1].position[1] = 128u;
+        current[2].largest = 3u;
+        current[2].rotation[2] = 15u;
+        current[2].scale[1] = 7u;
+
+        std::vector<uint8_t> data;
+        lia::encodeSnapshot(settings, current.data(), baseline.data(), current.size(), data);
+
+        std::vector<lia::quantizedTransform> decoded(3);
+        REQUIRE(lia::decodeSnapshot(settings, data.data(), data.size(), baseline.data(), decoded.data(), decoded.size()));
+        REQUIRE(same(decoded, current));
+    }
+}
+
+} // namespace test
@@ -0,0 +1,111 @@
+#include "doctest.h"
+
+#include <lia/streaming.h>
+#include <lia/transform.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace test {
+
+namespace {
+    const lia::mat4 MATRIX = lia::toMatrix(lia::transform(lia::vec3(1.0f, -2.0f, 3.0f),
+        lia::normalize(lia::quaternion(0.3f, -0.5f, 0.2f, 0.8f)), lia::vec3(2.0f, 0.5f, 1.5f)));
+
+    std::vector<lia::vec3> points(std::size_t count)
+    {
+        std::vector<lia::vec3> result(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result[i] = lia::vec3(std::sin(i * 0.37f) * 10.0f, std::cos(i * 0.11f) * 5.0f, i * 0.01f);
+
+        return result;
+    }
+
+    void checkPoint(const lia::vec3& actual, const lia::vec3& p, const lia::mat4& m)
+    {
+        const lia::vec4 expected = lia::vec4(p.x, p.y, p.z, 1.0f) * m;
+        CHECK(actual.x == doctest::Approx(expected.x).epsilon(1e-5));
+        CHECK(actual.y == doctest::Approx(expected.y).epsilon(1e-5));
+        CHECK(actual.z == doctest::Approx(expected.z).epsilon(1e-5));
+    }
+} // namespace
+
+TEST_CASE("Streaming transforms")
+{
+    SUBCASE("Point transforms")
+    {
+        // odd counts, so the last cache-line step is partial
+        const std::vector<lia::vec3> in = points(1001);
+        const lia::streamSettings variants[] = { lia::streamSettings(0, SIZE_MAX), lia::streamSettings(1024, SIZE_MAX),
+            lia::streamSettings(256, 0), lia::streamSettings(0, 0) };
+        for (const lia::streamSettings& s : variants) {
+            std::vector<lia::vec3> out(in.size() + 1, lia::vec3(-7.0f));
+            lia::transformPoints(MATRIX, in.data(), out.data(), in.size(), s);
+            for (std::size_t i = 0; i < in.size(); ++i)
+                checkPoint(out[i], in[i], MATRIX);
+
+            // nothing written past count
+            CHECK(out.back().x == -7.0f);
+        }
+
+        std::vector<lia::vec3> none(1, lia::vec3(-7.0f));
+        lia::transformPoints(MATRIX, in.data(), none.data(), 0);
+        CHECK(none[0].x == -7.0f);
+    }
+
+    SUBCASE("Vector and matrix transforms")
+    {
+        std::vector<lia::vec4> vectors(77);
+        std::vector<lia::mat4> matrices(77);
+        for (std::size_t i = 0; i < vectors.size(); ++i) {
+            vectors[i] = lia::vec4(i * 0.5f, -1.0f, i * 0.25f, i % 2 ? 1.0f : 0.0f);
+            matrices[i] = lia::toMatrix(lia::transform(lia::vec3(static_cast<float>(i)), lia::rotationY(i * 0.1f)));
+        }
+
+        for (const std::size_t threshold : { std::size_t(0), std::size_t(SIZE_MAX) }) {
+            const lia::streamSettings s = lia::streamSettings(512, threshold);
+
+            std::vector<lia::vec4> vectorsOut(vectors.size());
+            lia::transformPoints(MATRIX, vectors.data(), vectorsOut.data(), vectors.size(), s);
+            for (std::size_t i = 0; i < vectors.size(); ++i) {
+                const lia::vec4 expected = vectors[i] * MATRIX;
+                CHECK(std::memcmp(&vectorsOut[i], &expected, sizeof(lia::vec4)) == 0);
+            }
+
+            std::vector<lia::mat4> matricesOut(matrices.size());
+            lia::transformMatrices(MATRIX, matrices.data(), matricesOut.data(), matrices.size(), s);
+            for (std::size_t i = 0; i < matrices.size(); ++i) {
+                const lia::mat4 expected = matrices[i] * MATRIX;
+                CHECK(std::memcmp(&matricesOut[i], &expected, sizeof(lia::mat4)) == 0);
+            }
+        }
+    }
+
+    SUBCASE("Tiled point sets")
+    {
+        const std::vector<lia::vec3> in = points(1000);
+        std::vector<lia::mat4> matrices(5);
+        for (std::size_t m = 0; m < matrices.size(); ++m)
+            matrices[m] = lia::toMatrix(lia::transform(lia::vec3(m * 3.0f, 0.0f, -1.0f), lia::rotationY(m * 0.7f), lia::vec3(m + 1.0f)));
+
+        // tiles that divide the points, that do not, one for all of them and larger than all of them
+        for (const std::size_t tile : { std::size_t(100), std::size_t(333), std::size_t(0), std::size_t(5000) }) {
+            for (const std::size_t threshold : { std::size_t(0), std::size_t(SIZE_MAX) }) {
+                std::vector<lia::vec3> out(matrices.size() * in.size());
+                lia::transformPointSets(matrices.data(), matrices.size(), in.data(), in.size(), out.data(), lia::streamSettings(1024, threshold, tile));
+
+                // the same values as one batch per matrix
+                std::vector<lia::vec3> expected(in.size());
+                for (std::size_t m = 0; m < matrices.size(); ++m) {
+                    lia::transformPoints(matrices[m], in.data(), expected.data(), in.size());
+                    CHECK(std::memcmp(out.data() + m * in.size(), expected.data(), in.size() * sizeof(lia::vec3)) == 0);
+                    checkPoint(out[m * in.size() + 17], in[17], matrices[m]);
+                }
+            }
+        }
+    }
+}
+
+} // namespace test
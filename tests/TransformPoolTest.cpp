@@ -0,0 +1,94 @@
+#include "doctest.h"
+
+#include <lia/transformpool.h>
+
+#include <cmath>
+#include <vector>
+
+namespace test {
+
+TEST_CASE("Transform pool")
+{
+    SUBCASE("Matrices")
+    {
+        const lia::transform t(lia::vec3(1.0f, -2.0f, 3.0f), lia::normalize(lia::quaternion(0.3f, -0.5f, 0.2f, 0.8f)), lia::vec3(2.0f, 0.5f, 1.5f));
+        const lia::mat4 m = lia::toMatrix(t);
+
+        const lia::vec3 points[3] = { lia::vec3(1.0f, 0.0f, 0.0f), lia::vec3(0.3f, -4.0f, 2.0f), lia::vec3(-1.0f, 2.0f, 0.5f) };
+        for (const lia::vec3& p : points) {
+            const lia::vec4 mapped = lia::vec4(p.x, p.y, p.z, 1.0f) * m;
+            const lia::vec3 expected = lia::transformPoint(t, p);
+            REQUIRE(mapped.x == doctest::Approx(expected.x).epsilon(1e-5));
+            REQUIRE(mapped.y == doctest::Approx(expected.y).epsilon(1e-5));
+            REQUIRE(mapped.z == doctest::Approx(expected.z).epsilon(1e-5));
+            REQUIRE(mapped.w == 1.0f);
+        }
+    }
+
+    SUBCASE("Handles")
+    {
+        lia::transformPool pool;
+        std::vector<lia::transformHandle> handles;
+        for (int i = 0; i < 10; ++i)
+            handles.push_back(pool.create(lia::transform(lia::vec3(static_cast<float>(i)), lia::quaternion())));
+        REQUIRE(pool.size() == 10);
+
+        REQUIRE(pool.destroy(handles[2]));
+        REQUIRE_FALSE(pool.destroy(handles[2]));
+        REQUIRE_FALSE(pool.valid(handles[2]));
+        REQUIRE(pool.size() == 9);
+
+        // the last transform moved into the hole, its handle still finds it
+        REQUIRE(pool.indexOf(handles[9]) == 2);
+        REQUIRE(pool.get(handles[9]).position.x == 9.0f);
+        REQUIRE(pool.positions()[2].x == 9.0f);
+        REQUIRE(pool.handleAt(2) == handles[9]);
+
+        // the slot is reused with a new generation
+        const lia::transformHandle reused = pool.create(lia::transform(lia::vec3(42.0f), lia::quaternion()));
+        REQUIRE(reused.slot == handles[2].slot);
+        REQUIRE(reused != handles[2]);
+        REQUIRE_FALSE(pool.valid(handles[2]));
+        REQUIRE(pool.get(reused).position.x == 42.0f);
+        REQUIRE_FALSE(pool.set(handles[2], lia::transform()));
+
+        for (int i = 0; i < 10; ++i) {
+            if (i != 2)
+                REQUIRE(pool.get(handles[i]).position.y == static_cast<float>(i));
+        }
+
+        pool.clear();
+        REQUIRE(pool.size() == 0);
+        REQUIRE_FALSE(pool.valid(reused));
+        REQUIRE_FALSE(pool.valid(lia::transformHandle()));
+    }
+
+    SUBCASE("World matrices")
+    {
+        lia::transformPool pool;
+        pool.reserve(100);
+        std::vector<lia::transformHandle> handles;
+        for (int i = 0; i < 100; ++i)
+            handles.push_back(pool.create(lia::transform(lia::vec3(static_cast<float>(i), 0.0f, 0.0f), lia::rotationZ(0.1f * i), lia::vec3(2.0f))));
+        for (int i = 0; i < 100; i += 3)
+            pool.destroy(handles[i]);
+
+        for (std::size_t i = 0; i < pool.size(); ++i)
+            pool.positions()[i].y = 1.0f;
+        pool.updateWorlds();
+
+        for (int i = 1; i < 100; ++i) {
+            if (i % 3 == 0)
+                continue;
+
+            const lia::transform t = pool.get(handles[i]);
+            const lia::mat4& world = pool.worlds()[pool.indexOf(handles[i])];
+            REQUIRE(world(3, 0) == static_cast<float>(i));
+            REQUIRE(world(3, 1) == 1.0f);
+            REQUIRE(world(0, 0) == doctest::Approx(2.0f * std::cos(0.1f * i)).epsilon(1e-5));
+            REQUIRE(t.scale.x == 2.0f);
+        }
+    }
+}
+
+} // namespace test
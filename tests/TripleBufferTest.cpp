@@ -0,0 +1,75 @@
+#include "doctest.h"
+
+#include <lia/triplebuffer.h>
+
+#include <thread>
+
+namespace test {
+
+TEST_CASE("Triple buffer")
+{
+    SUBCASE("Hand-off")
+    {
+        lia::matrixStore store(4);
+        REQUIRE(store.size() == 4);
+        REQUIRE_FALSE(store.acquire());
+
+        store.writeBuffer()[0](3, 0) = 1.0f;
+        store.publish();
+        store.writeBuffer()[0](3, 0) = 2.0f;
+        store.publish();
+
+        // only the latest frame is seen, once
+        REQUIRE(store.acquire());
+        REQUIRE(store.readBuffer()[0](3, 0) == 2.0f);
+        REQUIRE_FALSE(store.acquire());
+        REQUIRE(store.readBuffer()[0](3, 0) == 2.0f);
+
+        // writing does not touch the frame being read
+        store.writeBuffer()[0](3, 0) = 3.0f;
+        REQUIRE(store.readBuffer()[0](3, 0) == 2.0f);
+        store.publish();
+        REQUIRE(store.readBuffer()[0](3, 0) == 2.0f);
+        REQUIRE(store.acquire());
+        REQUIRE(store.readBuffer()[0](3, 0) == 3.0f);
+    }
+
+    SUBCASE("Across threads")
+    {
+        const std::size_t count = 10000;
+        const int frames = 2000;
+        lia::transformStore store(count);
+
+        std::thread writer([&]() {
+            for (int frame = 1; frame <= frames; ++frame) {
+                lia::transform* transforms = store.writeBuffer();
+                for (std::size_t i = 0; i < count; ++i)
+                    transforms[i].position = lia::vec3(static_cast<float>(frame), static_cast<float>(i), 0.0f);
+                store.publish();
+            }
+        });
+
+        float last = 0.0f;
+        bool torn = false;
+        bool backwards = false;
+        while (last < static_cast<float>(frames)) {
+            if (!store.acquire()) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            const lia::transform* transforms = store.readBuffer();
+            const float frame = transforms[0].position.x;
+            for (std::size_t i = 0; i < count; ++i)
+                torn = torn || transforms[i].position.x != frame || transforms[i].position.y != static_cast<float>(i);
+            backwards = backwards || frame <= last;
+            last = frame;
+        }
+        writer.join();
+
+        REQUIRE_FALSE(torn);
+        REQUIRE_FALSE(backwards);
+    }
+}
+
+} // namespace test